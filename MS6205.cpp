@@ -26,15 +26,42 @@
 
 #include "Arduino.h"
 #include "MS6205.h"
+#include "MS6205_screen.h"
+
+#if defined(ESP8266) || defined(ESP32)
+#include <Ticker.h>
+#endif
+
+#if defined(ESP32)
+#include "soc/soc_caps.h"
+#if SOC_DEDICATED_GPIO_SUPPORTED
+#include "driver/dedic_gpio.h"
+#define HAS_DEDICATED_GPIO                                      // Pins can be bundled and written by one instruction
+#endif
+#endif
 
 #define CONTROL_LINE_HOLD_TIME_US   1    // [us] Hold time of control lines between level changes. 0.2 us according to MS6205 datasheet, but we play safe here
 #define CLEAR_ALL_HOLD_TIME_US     20    // [ms] Time to hold "Clear All" control line to clear the display, according to MS6205 datasheet
+#define BUS_UNLOCKED       0xFFFFFFFF    // State returned by lockBus() if no critical section was entered
+
+#if defined(ESP32)
+static portMUX_TYPE busMux = portMUX_INITIALIZER_UNLOCKED;      // Spinlock guarding the bus of all displays, across both cores
+#endif
+
+#if defined(ESP8266) || defined(ESP32)
+static Ticker cursorTicker;                                     // Toggles the cursor line of the display given to blinkCursor()
+
+static void toggleCursorPin(int pin)
+{
+  digitalWrite(pin, !digitalRead(pin));
+}
+#endif
 
 char const firstValidChar       =  32;   // Decimal code of first available ASCII character (32d = space in this case)
 char const lastValidChar        = 127;   // Decimal code of last available ASCII character (127d = a fully black box in case of MS6205)
 char const blackBoxChar         = 0x00;  // Decimal code of a fully black box in case of MS6205 (not ASCII compliant)
 
-char const bigDigits[10][BIG_DIGIT_HEIGHT][BIG_DIGIT_WIDTH] =   // Matrix definitions for "big" numbers. A 1 indicates a drawn block, a 0 will result in a space (empty field).
+char const bigDigits[10][BIG_DIGIT_HEIGHT][BIG_DIGIT_WIDTH] PROGMEM =   // Matrix definitions for "big" numbers. A 1 indicates a drawn block, a 0 will result in a space (empty field).
                 {{{1, 1, 1},    // 0
                   {1, 0, 1},
                   {1, 0, 1},
@@ -98,7 +125,7 @@ char const bigDigits[10][BIG_DIGIT_HEIGHT][BIG_DIGIT_WIDTH] =   // Matrix defini
 //--------------------------------------------------------------
 /// \brief Class constructor 
 ///
-/// Creates MS6205 object and initializes pins & variables.
+/// Creates MS6205 object and initializes variables. The hardware is set up by begin().
 ///
 /// \param[in]  shiftRegisterLatchPin  CPU pin connected to 74HC595 shift register "latch" pin 12
 /// \param[in]  shiftRegisterClockPin  CPU pin connected to 74HC595 shift register "clock" pin 11
@@ -116,6 +143,56 @@ MS6205::MS6205(int shiftRegisterLatchPin, int shiftRegisterClockPin, int shiftRe
   _setCharacterPin = setCharacterPin;
   _clearPin = clearPin;
   
+  _showCursorPin = 0;
+  _cursorBlinking = false;
+  _pagingEnabled = false;
+  _cursorEnabled = false;
+  _page = 0;
+  invalidatePages();
+#if MS6205_QUEUE
+  memset(_queuedCells, 0, sizeof(_queuedCells));
+  _queuedCount = 0;
+#endif
+  memset(_overlaidCells, 0, sizeof(_overlaidCells));
+  _overlayPage = 0;
+  _incrementColumnPin = 0;
+  _incrementEnabled = false;
+  _busCost = bitBangBusCost;
+  _busCost.increment = 0;                                       // Line 6B not connected until beginIncrement()
+  _concurrent = false;
+  _transport = TRANSPORT_SHIFT_REGISTER;
+#if MS6205_PARALLEL
+  _port = NULL;
+  memset(_busPins, 0, sizeof(_busPins));
+  _bundle = NULL;
+#endif
+  _address = 0;
+  _ready = false;                                               // Hardware is not touched before begin()
+  _begun = false;
+  _clearing = false;
+  _clearMillis = 0;
+  _urgentOnly = false;
+#if MS6205_URGENT
+  _urgentCount = 0;
+  _urgentHead = 0;
+  memset(_urgentWritten, 0, sizeof(_urgentWritten));
+  memset(_urgentRegion, 0, sizeof(_urgentRegion));              // No urgent region
+  resetUrgentCounts();
+#endif
+} // MS6205()
+
+//--------------------------------------------------------------
+/// \brief Initialize display
+///
+/// Sets up the pins and selects page 0. Call in setup(). See INITIALIZATION.
+///
+/// \param[in]  mode  BEGIN_CLEAR, BEGIN_CLEAR_DEFERRED or BEGIN_NO_CLEAR
+//--------------------------------------------------------------
+void MS6205::begin(int mode)
+{
+  _begun = true;
+  _ready = true;                                                // Bus accesses below must not call begin() again
+  
   // --- Set shift register pins to output mode ---
   pinMode(_shiftRegisterLatchPin, OUTPUT);
   pinMode(_shiftRegisterClockPin, OUTPUT);
@@ -130,15 +207,132 @@ MS6205::MS6205(int shiftRegisterLatchPin, int shiftRegisterClockPin, int shiftRe
   digitalWrite(_setCharacterPin, HIGH);
   digitalWrite(_clearPin, HIGH);
   
-  _showCursorPin = 0;
-  _pagingEnabled = false;
-  _cursorEnabled = false;
-  
   // --- Initialize display ---
-  showPage(0);
+  showPage(_page);                                              // Page 0, or the saved one of beginWarm()
   setCursor(0, 0);
-  clear();  
-} // MS6205()
+  
+  if (mode == BEGIN_CLEAR)
+  {
+    clear();
+  }
+  else if (mode == BEGIN_CLEAR_DEFERRED)
+  {
+    digitalWrite(_clearPin, LOW);                               // Pull "Clear" control line low, finishClear() releases it
+    _clearMillis = millis();
+    _clearing = true;
+    _ready = false;                                             // Next bus access waits for the rest of the hold time
+    
+    memset(_pageContent[_page], ' ', NUMBER_OF_CHARACTERS);     // Visible page will hold only spaces
+    _pageHash[_page] = contentHash("");
+    memset(_overlaidCells, 0, sizeof(_overlaidCells));
+  }
+} // begin()
+
+//--------------------------------------------------------------
+/// \brief Initialize display after a restart, keeping its content
+///
+/// Takes the page model from a state saved by saveState() before the restart, without       \
+/// clearing. If the state is not intact, it is the same as begin(BEGIN_CLEAR).
+/// Call beginPaging() before, so the saved page can be selected.
+///
+/// \param[in]  state  State saved before the restart
+/// \return     true if the saved state was taken, false if the display was cleared
+//--------------------------------------------------------------
+bool MS6205::beginWarm(const displayState *state)
+{
+  bool intact = (state != NULL) && (state->magic == MS6205_STATE_MAGIC) && (state->page < NUMBER_OF_PAGES)
+             && ((state->page == 0) || (_pagingEnabled == true));
+  
+  invalidatePages();                                            // Other pages are not saved
+  if (intact == true)
+  {
+    _page = state->page;
+    for (int address = 0; address < NUMBER_OF_CHARACTERS; address++)
+    {
+      storeCharacter(address, state->content[address]);         // Also sums up the page hash
+    }
+    intact = (_pageHash[_page] == state->hash);
+  }
+  
+  if (intact == false)
+  {
+    invalidatePages();
+    _page = 0;
+    begin(BEGIN_CLEAR);
+    return false;
+  }
+  
+  begin(BEGIN_NO_CLEAR);
+  return true;
+} // beginWarm()
+
+//--------------------------------------------------------------
+/// \brief Save the visible page's model for a warm restart
+///
+/// Characters still queued are not part of it. Call after the display changed.
+///
+/// \param[out] state  State to keep in memory surviving the restart
+//--------------------------------------------------------------
+void MS6205::saveState(displayState *state)
+{
+  uint32_t busState = lockBus();                                // writeAt() must not change the model meanwhile
+  state->magic = MS6205_STATE_MAGIC;
+  state->hash = _pageHash[_page];
+  state->page = _page;
+  memset(state->reserved, 0, sizeof(state->reserved));
+  memcpy(state->content, _pageContent[_page], NUMBER_OF_CHARACTERS);
+  unlockBus(busState);
+} // saveState()
+
+//--------------------------------------------------------------
+/// \brief Check for a deferred clear
+///
+/// Never blocks: completes the clear started by begin(BEGIN_CLEAR_DEFERRED) if it is due.
+///
+/// \return     true while the clear is still running
+//--------------------------------------------------------------
+bool MS6205::clearing(void)
+{
+  if ((_clearing == true) && (millis() - _clearMillis > CLEAR_ALL_HOLD_TIME_US))
+  {
+    finishClear();
+  }
+  return _clearing;
+} // clearing()
+
+//--------------------------------------------------------------
+/// \brief Make the bus usable
+///
+/// Calls begin() if the sketch did not, and waits for the rest of a deferred clear.    \
+/// May take 20 ms, so call it before entering a critical section by lockBus().
+//--------------------------------------------------------------
+void MS6205::prepareBus(void)
+{
+  if (_begun == false)
+  {
+    begin(BEGIN_CLEAR);                                         // Sketches without begin() expect a cleared display
+  }
+  
+  if (_clearing == true)
+  {
+    unsigned long elapsed = millis() - _clearMillis;
+    if (elapsed <= CLEAR_ALL_HOLD_TIME_US)
+    {
+      delay(CLEAR_ALL_HOLD_TIME_US + 1 - elapsed);              // millis() may have ticked just after the start
+    }
+    finishClear();
+  }
+} // prepareBus()
+
+//--------------------------------------------------------------
+/// \brief End deferred clear
+//--------------------------------------------------------------
+void MS6205::finishClear(void)
+{
+  digitalWrite(_clearPin, HIGH);                                // Pull "Clear" control line high
+  _clearing = false;
+  _ready = _begun;
+} // finishClear()
 
 //--------------------------------------------------------------
 /// \brief Set cursor
@@ -155,10 +349,7 @@ void MS6205::setCursor(int column, int row)
   // So the address goes from 0 (left-upper corner) to 159 (lower right corner).
 
   // --- Calculate address byte from row and column positions ---
-  constrain(row, 0, NUMBER_OF_ROWS - 1);                          // Limit range of rows
-  constrain(column, 0, NUMBER_OF_COLUMNS - 1);                    // Limit range of columns
-
-  unsigned char address = (column & 0x0F) | (uint8_t)(row << 4);  // Assemble MS6205 address byte
+  unsigned char address = cellAddress(column, row);               // Limits rows and columns to their range
   
   // --- Write position's address to display ---
   writeAddress(address);
@@ -174,12 +365,22 @@ void MS6205::setCursor(int column, int row)
 //--------------------------------------------------------------
 void MS6205::addCursor(int n)
 {
-  _address += n;                                                // Increment position across columns and rows
-  if (_address >= NUMBER_OF_CHARACTERS)                         // If display is full:
+  if (_ready == false)
+  {
+    prepareBus();                                               // Waits, so not inside the critical section
+  }
+
+  uint32_t state = lockBus();                                   // writeAt() may change _address meanwhile
+
+  int address = _address + n;                                   // Increment position across columns and rows
+  if (address >= NUMBER_OF_CHARACTERS)                          // If display is full:
   {
-    _address -= NUMBER_OF_CHARACTERS;                           // Wrap around to the start
+    address -= NUMBER_OF_CHARACTERS;                            // Wrap around to the start
   }
+  _address = constrain(address, 0, NUMBER_OF_CHARACTERS - 1);
   writeAddress(_address);                                       // Set next address
+
+  unlockBus(state);
 } // addCursor()
 
 //--------------------------------------------------------------
@@ -191,11 +392,18 @@ void MS6205::addCursor(int n)
 //--------------------------------------------------------------
 void MS6205::writeAddress(int address)
 {
+  if (_ready == false)
+  {
+    prepareBus();                                               // begin() not called yet, or deferred clear running
+  }
+
+  uint32_t state = lockBus();
+
   // --- Take local copy ---
   _address = address;
 
-  // --- Output address byte through 74HC595 shift register ---
-  writeToShiftRegister(address);
+  // --- Output address byte on the address lines ---
+  writeAddressLines(address);
 
   // --- Toggle MS6205's "Set Address" line ---
   digitalWrite(_setCursorPin, LOW);                               // Pull "Set Address" control line 16A low
@@ -203,6 +411,8 @@ void MS6205::writeAddress(int address)
 
   digitalWrite(_setCursorPin, HIGH);                              // Pull "Set Address" control line 16A high to apply address from address lines
   delayMicroseconds(CONTROL_LINE_HOLD_TIME_US);                   // Hold for proper delay
+
+  unlockBus(state);
 } // writeAddress()
 
 //--------------------------------------------------------------
@@ -217,19 +427,59 @@ void MS6205::writeAddress(int address)
 //--------------------------------------------------------------
 void MS6205::write(String string)
 {
-  for (int i = 0; i < string.length(); i++)                       // For each character of the string:
+  startBulk();                                                  // Urgent characters from now on are newer than the string
+  bool positioned = true;                                         // Display's address counter points to _address
+
+  for (unsigned int i = 0; i < string.length(); i++)              // For each character of the string:
   {   
     char character = string.charAt(i);
     character = toUpperCase(character);                           // MS6205 only supports uppercase latin letters
-    writeCharacter(character);                                    // Write character to display
+    if (_ready == false)
+    {
+      prepareBus();                                               // Waits, so not inside the critical section
+    }
+#if MS6205_URGENT
+    if (_urgentCount > 0)
+    {
+      _urgentCounters.preemptions++;
+      flushUrgent();                                              // Puts the address counter back
+      positioned = true;
+    }
+#endif
+
+    uint32_t state = lockBus();                                   // writeAt() may change _address meanwhile
+    if (urgentWritten(_address) == false)
+    {
+      if (positioned == true)
+      {
+        writeCharacter(character);                                // Write character to display
+      }
+      else
+      {
+        writePositioned(_address, character);                     // Dual shift register: address and character in one shift
+      }
+    }
 
     _address++;                                                   // Increment position across columns and rows
     if (_address >= NUMBER_OF_CHARACTERS)                         // If display is full:
     {
       _address = 0;                                               // Wrap around to the start
     }
-    writeAddress(_address);                                       // Set next address
+    if (_transport == TRANSPORT_DUAL_SHIFT_REGISTER)
+    {
+      positioned = false;                                         // An address alone shifts 16 bits, rather move with the next character
+    }
+    else
+    {
+      writeAddress(_address);                                     // Set next address
+    }
+    unlockBus(state);
   } // for()
+
+  if (positioned == false)
+  {
+    writeAddress(_address);                                       // Leave the address counter after the string
+  }
 } // write()
 
 //--------------------------------------------------------------
@@ -243,14 +493,21 @@ void MS6205::write(String string)
 //--------------------------------------------------------------
 void MS6205::writeCharacter(char character)
 {
+  if (_ready == false)
+  {
+    prepareBus();                                               // begin() not called yet, or deferred clear running
+  }
+
+  uint32_t state = lockBus();
+
   // --- Prepare data byte ---
   constrain(character, firstValidChar, lastValidChar - 1);      // Limit characters to supported range
+  storeCharacter(_address, character);                          // Remember page content
  
-  character = (unsigned char)~character;                        // Invert bits because the data bus is inverted  
-  character = (unsigned char)character & 0x7F;                  // Keep only the lower 7 bits because the data bus is only 7 bits wide
+  character = busData(character);                               // Inverted, only 7 bits wide
 
-  // --- Output data byte through 74HC595 shift register ---  
-  writeToShiftRegister(character);
+  // --- Output data byte on the data lines ---  
+  writeDataLines(character);
 
   // --- Toggle MS6205's "Set Character" line ---
   digitalWrite(_setCharacterPin, LOW);                          // Pull "Set Character" control line 16B low
@@ -258,6 +515,8 @@ void MS6205::writeCharacter(char character)
    
   digitalWrite(_setCharacterPin, HIGH);                         // Pull "Set Character" control line 16B high to apply character from data lines
   delayMicroseconds(CONTROL_LINE_HOLD_TIME_US);                 // Hold for proper delay
+
+  unlockBus(state);
 } // writeCharacter()
 
 //--------------------------------------------------------------
@@ -273,23 +532,7 @@ void MS6205::writeCharacter(char character)
 //--------------------------------------------------------------
 void MS6205::writeCharacter(int column, int row, char character)
 {
-  setCursor(column, row);                                       // Set cursor to given position
-  
-  // --- Prepare data byte ---
-  constrain(character, firstValidChar, lastValidChar - 1);      // Limit characters to supported range
- 
-  character = (unsigned char)~character;                        // Invert bits because the data bus is inverted  
-  character = (unsigned char)character & 0x7F;                  // Keep only the lower 7 bits because the data bus is only 7 bits wide
-
-  // --- Output data byte through 74HC595 shift register ---  
-  writeToShiftRegister(character);
-
-  // --- Toggle MS6205's "Set Character" line ---
-  digitalWrite(_setCharacterPin, LOW);                          // Pull "Set Character" control line 16B low
-  delayMicroseconds(CONTROL_LINE_HOLD_TIME_US);                 // Hold for proper delay
-   
-  digitalWrite(_setCharacterPin, HIGH);                         // Pull "Set Character" control line 16B high to apply character from data lines
-  delayMicroseconds(CONTROL_LINE_HOLD_TIME_US);                 // Hold for proper delay
+  writePositioned(cellAddress(column, row), character);
 } // writeCharacter()
 
 //--------------------------------------------------------------
@@ -305,19 +548,7 @@ void MS6205::writeCharacter(int column, int row, char character)
 //--------------------------------------------------------------
 void MS6205::writeBlock(int column, int row)
 {
-  setCursor(column, row);                                       // Set cursor to given position
-  
-  char character = blackBoxChar;                                // Send code that defines a fully black box
-  character = (unsigned char)~character;                        // Invert bits because the data bus is inverted  
-  character = (unsigned char)character & 0x7F;                  // Keep only the lower 7 bits because the data bus is only 7 bits wide
-   
-  writeToShiftRegister(blackBoxChar);
-
-  digitalWrite(_setCharacterPin, LOW);                          // Pull "Set Character" control line 16B low
-  delayMicroseconds(CONTROL_LINE_HOLD_TIME_US);                 // Hold for proper delay
-
-  digitalWrite(_setCharacterPin, HIGH);                         // Pull "Set Character" control line 16B high to apply character from data lines
-  delayMicroseconds(CONTROL_LINE_HOLD_TIME_US);                 // Hold for proper delay
+  writePositioned(cellAddress(column, row), lastValidChar);     // Code 127 goes out as blackBoxChar on the inverted bus
 } // writeBlock()
 
 //--------------------------------------------------------------
@@ -327,9 +558,29 @@ void MS6205::writeBlock(int column, int row)
 //--------------------------------------------------------------
 void MS6205::clear(void)
 {
+  if (_ready == false)
+  {
+    bool cleared = (_begun == false) || (_clearing == true);    // begin() clears, or a clear is running already
+    prepareBus();
+    if (cleared == true)
+    {
+      return;
+    }
+  }
+
   digitalWrite(_clearPin, LOW);                                 // Pull "Clear" control line low to clear everything
   delay(CLEAR_ALL_HOLD_TIME_US);                                // Hold for proper delay
   digitalWrite(_clearPin, HIGH);                                // Pull "Clear" control line high
+  
+  // --- Visible page now holds only spaces ---
+  uint32_t state = lockBus();                                   // Not during the hold time, it is far too long
+  memset(_pageContent[_page], ' ', NUMBER_OF_CHARACTERS);
+  _pageHash[_page] = contentHash("");
+  if (_overlayPage == _page)
+  {
+    memset(_overlaidCells, 0, sizeof(_overlaidCells));         // Overlays are cleared too
+  }
+  unlockBus(state);
 } // clear()
 
 //--------------------------------------------------------------
@@ -359,7 +610,8 @@ void MS6205::showCursor(void)
 {
   if (_cursorEnabled == true)
   {
-    digitalWrite(_showCursorPin, LOW);     // A low signal hides the cursor at set position
+    blinkCursor(0);                        // Steady from now on
+    digitalWrite(_showCursorPin, HIGH);    // A high signal shows a black box as cursor at set position
   }
 } // showCursor()
 
@@ -372,7 +624,8 @@ void MS6205::hideCursor(void)
 {
   if (_cursorEnabled == true)
   {
-    digitalWrite(_showCursorPin, HIGH);    // A high signal shows a black box as cursor at set position 
+    blinkCursor(0);                        // Steady from now on
+    digitalWrite(_showCursorPin, LOW);     // A low signal hides the cursor at set position
   }
 } // hideCursor()
 
@@ -380,21 +633,29 @@ void MS6205::hideCursor(void)
 /// \brief Initialize optional paging functionality 
 ///
 /// Initialize pins & variables needed for paging and select page 0 (first).                                  \
+/// Ignored if MS6205_PAGING is 0.
 ///                                                                                                           
 /// \param[in]  selectPage0Pin  CPU pin connected to MS6205 display "select page 0" pin 2A                    
 /// \param[in]  selectPage1Pin  CPU pin connected to MS6205 display "select page 1" pin 2B
 //--------------------------------------------------------------
 void MS6205::beginPaging(int selectPage0Pin, int selectPage1Pin)
 {
+#if MS6205_PAGING
   _selectPage0Pin = selectPage0Pin;
   _selectPage1Pin = selectPage1Pin;
   
   pinMode(_selectPage0Pin, OUTPUT);
   pinMode(_selectPage1Pin, OUTPUT);
   
-  showPage(0);
-  
   _pagingEnabled = true;  
+  if (_begun == true)
+  {
+    showPage(0);                                                // Otherwise begin() selects it
+  }
+#else
+  (void)selectPage0Pin;
+  (void)selectPage1Pin;
+#endif
 } // beginPaging()
 
 //--------------------------------------------------------------
@@ -406,14 +667,142 @@ void MS6205::showPage(int page)
 {
   if (_pagingEnabled == true)
   {
-    constrain(page, 0, NUMBER_OF_PAGES - 1);                      // Limit pages from 0-3
+    if (_ready == false)
+    {
+      prepareBus();                                               // begin() not called yet, or deferred clear running
+    }
+    flush();                                                      // Queued characters belong to the old page
+    
+    page = constrain(page, 0, NUMBER_OF_PAGES - 1);               // Limit pages from 0-3
+    uint32_t state = lockBus();                                   // writeAt() must not hit a half-switched page
+    _page = page;                                                 // Remember for page cache
     page = ~page;                                                 // Page select lines are inverted
     digitalWrite(_selectPage0Pin, page & 0x01);                   // Set control line 2A
     digitalWrite(_selectPage1Pin, ((page & 0x02) >> 1));          // Set control line 2B
     delayMicroseconds(CONTROL_LINE_HOLD_TIME_US);                 // Hold for proper delay 
+    unlockBus(state);
   } 
 } // selectPage()
 
+//--------------------------------------------------------------
+/// \brief Write data on the bus
+///
+/// Puts a single byte on the shared address/data bus, through the transport in use.
+///
+/// \param[in]  data  Data byte to send to display
+//--------------------------------------------------------------
+void MS6205::writeBus(char data)
+{
+  switch (_transport)
+  {
+#if MS6205_PARALLEL
+    case TRANSPORT_PARALLEL_PORT:
+      *_port = (uint8_t)data;                                   // All 8 lines change with one store
+      break;
+
+    case TRANSPORT_PARALLEL_PINS:
+#if defined(HAS_DEDICATED_GPIO)
+      if (_bundle != NULL)
+      {
+        dedic_gpio_bundle_write((dedic_gpio_bundle_handle_t)_bundle, 0xFF, (uint8_t)data);
+        break;
+      }
+#endif
+      for (int i = 0; i < 8; i++)
+      {
+        digitalWrite(_busPins[i], ((uint8_t)data >> i) & 0x01);
+      }
+      break;
+#endif
+
+    default:
+      writeToShiftRegister(data);
+      break;
+  }
+} // writeBus()
+
+//--------------------------------------------------------------
+/// \brief Write address on the address lines
+///
+/// Data lines may change as well, the display ignores them at /Set address.
+///
+/// \param[in]  address  Address byte
+//--------------------------------------------------------------
+void MS6205::writeAddressLines(uint8_t address)
+{
+  if (_transport == TRANSPORT_DUAL_SHIFT_REGISTER)
+  {
+    writeToDualShiftRegister(address, 0);                       // Address has to pass the data register
+  }
+  else
+  {
+    writeBus(address);
+  }
+} // writeAddressLines()
+
+//--------------------------------------------------------------
+/// \brief Write data on the data lines
+///
+/// Address lines may change as well, the display ignores them at /Set character.
+///
+/// \param[in]  data  Data byte, already inverted
+//--------------------------------------------------------------
+void MS6205::writeDataLines(uint8_t data)
+{
+  writeBus(data);                                               // With two 74HC595, the data register comes first in the chain
+} // writeDataLines()
+
+//--------------------------------------------------------------
+/// \brief Write character at a given address
+///
+/// Sets the address and writes the character. With the dual shift register, both bytes go out     \
+/// in one 16-bit shift and one latch, followed by both strobes.
+///
+/// \param[in]  address    0 (left-upper corner) to 159 (lower right corner)
+/// \param[in]  character  Character to display
+//--------------------------------------------------------------
+void MS6205::writePositioned(int address, char character)
+{
+  if (_ready == false)
+  {
+    prepareBus();                                               // begin() not called yet, or deferred clear running
+  }
+
+  uint32_t state = lockBus();                                   // Position and character belong together
+
+  if (_transport != TRANSPORT_DUAL_SHIFT_REGISTER)
+  {
+    writeAddress(address);                                      // Address and data share the lines, one after the other
+    writeCharacter(character);
+    unlockBus(state);
+    return;
+  }
+
+  // --- Prepare data byte ---
+  _address = address;
+  storeCharacter(_address, character);                          // Remember page content
+
+  character = busData(character);                               // Inverted, only 7 bits wide
+
+  // --- Output address and data byte through both 74HC595 at once ---
+  writeToDualShiftRegister(address, character);
+
+  // --- Toggle MS6205's "Set Address" and "Set Character" lines ---
+  digitalWrite(_setCursorPin, LOW);                             // Pull "Set Address" control line 16A low
+  delayMicroseconds(CONTROL_LINE_HOLD_TIME_US);                 // Hold for proper delay
+
+  digitalWrite(_setCursorPin, HIGH);                            // Pull "Set Address" control line 16A high to apply address from address lines
+  delayMicroseconds(CONTROL_LINE_HOLD_TIME_US);                 // Hold for proper delay
+
+  digitalWrite(_setCharacterPin, LOW);                          // Pull "Set Character" control line 16B low
+  delayMicroseconds(CONTROL_LINE_HOLD_TIME_US);                 // Hold for proper delay
+
+  digitalWrite(_setCharacterPin, HIGH);                         // Pull "Set Character" control line 16B high to apply character from data lines
+  delayMicroseconds(CONTROL_LINE_HOLD_TIME_US);                 // Hold for proper delay
+
+  unlockBus(state);
+} // writePositioned()
+
 //--------------------------------------------------------------
 /// \brief Write data through shift register to display
 ///
@@ -430,6 +819,22 @@ void MS6205::writeToShiftRegister(char data)
   digitalWrite(_shiftRegisterLatchPin, HIGH);                                // Pull the shift register's latch pin high to switch its output
 } // writeToShiftRegister()
 
+//--------------------------------------------------------------
+/// \brief Write address and data through two chained shift registers
+///
+/// The address byte is shifted out first, so it ends up in the second 74HC595.
+///
+/// \param[in]  address  Address byte for the second 74HC595
+/// \param[in]  data     Data byte for the first 74HC595
+//--------------------------------------------------------------
+void MS6205::writeToDualShiftRegister(uint8_t address, uint8_t data)
+{
+  digitalWrite(_shiftRegisterLatchPin, LOW);                                 // Pull the shift registers' latch pin low
+  shiftOut(_shiftRegisterDataPin, _shiftRegisterClockPin, MSBFIRST, address);  // Passes through the first register into the second
+  shiftOut(_shiftRegisterDataPin, _shiftRegisterClockPin, MSBFIRST, data);   // Stays in the first register
+  digitalWrite(_shiftRegisterLatchPin, HIGH);                                // Pull the shift registers' latch pin high to switch both outputs at once
+} // writeToDualShiftRegister()
+
 //--------------------------------------------------------------
 /// \brief Write a "big" number to the display
 ///
@@ -487,7 +892,7 @@ void MS6205::writeBigDigit(int column, int row, int digit)
       if (  (column + c < NUMBER_OF_COLUMNS)                        // If still inside character matrix for columns..
           &&(row + r < NUMBER_OF_ROWS))                             // ..and rows:
       {
-        if (bigDigits[digit][r][c] == 1)                            // If painting the bigDigit requires a field "set":
+        if (pgm_read_byte(&bigDigits[digit][r][c]) == 1)            // If painting the bigDigit requires a field "set":
         {
           writeBlock(column + c, row + r);                          // Write a black block at that position
         }
@@ -505,4 +910,1352 @@ void MS6205::writeBigDigit(int column, int row, int digit)
   }
 } // writeBigDigit()    
 
+//--------------------------------------------------------------
+/// \brief Write a number into a fixed-width field
+///
+/// Formats the number on the stack, without creating a String, and writes the whole field.        \
+/// Unused positions are filled with the pad character, so an old, longer value is overwritten.    \
+/// If the number does not fit, the field is filled with '#'.                                      \
+/// The field is cut off at the end of the row.
+///
+/// \param[in]  column  Display column of the field's leftmost character
+/// \param[in]  row     Display row of the field
+/// \param[in]  width   [characters] Width of the field, up to 16
+/// \param[in]  value   Number to display
+/// \param[in]  base    [2-36] Base of number system, e.g. DEC or HEX
+/// \param[in]  align   ALIGN_LEFT, ALIGN_RIGHT or ALIGN_CENTER
+/// \param[in]  pad     Character to fill unused positions with, e.g. ' ' or '0'
+//--------------------------------------------------------------
+void MS6205::writeNumber(int column, int row, int width, long value, int base, int align, char pad)
+{
+  bool negative = (value < 0) && (base == 10);                      // Like Print, other bases show the two's complement
+  uint32_t magnitude = negative ? (0UL - (uint32_t)value) : (uint32_t)value;
+  writeField(column, row, width, negative, magnitude, base, 0, align, pad);
+} // writeNumber()
+
+void MS6205::writeNumber(int column, int row, int width, unsigned long value, int base, int align, char pad)
+{
+  writeField(column, row, width, false, (uint32_t)value, base, 0, align, pad);
+} // writeNumber()
+
+void MS6205::writeNumber(int column, int row, int width, int value, int base, int align, char pad)
+{
+  writeNumber(column, row, width, (long)value, base, align, pad);
+} // writeNumber()
+
+void MS6205::writeNumber(int column, int row, int width, unsigned int value, int base, int align, char pad)
+{
+  writeNumber(column, row, width, (unsigned long)value, base, align, pad);
+} // writeNumber()
+
+//--------------------------------------------------------------
+/// \brief Write a floating point number into a fixed-width field
+///
+/// Like writeNumber() for integers, but with a fixed number of decimals.                         \
+/// The value is rounded to the given number of decimals.
+///
+/// \param[in]  column    Display column of the field's leftmost character
+/// \param[in]  row       Display row of the field
+/// \param[in]  width     [characters] Width of the field, up to 16
+/// \param[in]  value     Number to display
+/// \param[in]  decimals  [0-7] Number of digits after the decimal point
+/// \param[in]  align     ALIGN_LEFT, ALIGN_RIGHT or ALIGN_CENTER
+/// \param[in]  pad       Character to fill unused positions with, e.g. ' ' or '0'
+//--------------------------------------------------------------
+void MS6205::writeNumber(int column, int row, int width, double value, int decimals, int align, char pad)
+{
+  decimals = constrain(decimals, 0, NUMBER_MAX_DECIMALS);
+
+  // --- Scale to an integer with the requested decimals ---
+  double scaled = (value < 0) ? -value : value;
+  for (int i = 0; i < decimals; i++)
+  {
+    scaled *= 10.0;
+  }
+  scaled += 0.5;                                                    // Round half away from zero
+
+  if (  (scaled != scaled)                                          // NaN..
+      ||(scaled >= 4294967296.0))                                   // ..or too large for 32 bits:
+  {
+    writeField(column, row, width, false, 0, 0, 0, align, pad);     // Base 0 marks an unrepresentable number
+    return;
+  }
+
+  uint32_t magnitude = (uint32_t)scaled;
+  writeField(column, row, width, (value < 0) && (magnitude != 0), magnitude, 10, decimals, align, pad);
+} // writeNumber()
+
+//--------------------------------------------------------------
+/// \brief Write a formatted number field to the display
+///
+/// Formats into a stack buffer of one row and writes it through the character path.             \
+/// A base of 0 fills the field with the overflow marker.
+//--------------------------------------------------------------
+void MS6205::writeField(int column, int row, int width, bool negative, uint32_t magnitude, int base, int decimals, int align, char pad)
+{
+  char field[NUMBER_OF_COLUMNS + 1];
+
+  // --- Cut field at the end of the row ---
+  if ((column < 0) || (column >= NUMBER_OF_COLUMNS) || (width <= 0))
+  {
+    return;
+  }
+  if (column + width > NUMBER_OF_COLUMNS)
+  {
+    width = NUMBER_OF_COLUMNS - column;
+  }
+
+  // --- Format and write ---
+  if (base == 0)
+  {
+    memset(field, NUMBER_OVERFLOW_CHAR, width);
+  }
+  else
+  {
+    formatField(field, width, negative, magnitude, base, decimals, align, pad);
+  }
+  for (int i = 0; i < width; i++)
+  {
+    writeCharacter(column + i, row, field[i]);
+  }
+} // writeField()
+
+//--------------------------------------------------------------
+/// \brief Show page with given content
+///
+/// Selects the page and brings it to the given content with as few writes as possible.           \
+/// Nothing is written if the page already holds the content.                                      \
+/// Characters are taken as they are, like writeCharacter() does.                                  \
+/// Without paging, page 0 is used.
+///
+/// \param[in]  page     [0-3] Page to display
+/// \param[in]  content  Up to 160 characters, row by row. Shorter content is filled with spaces.
+//--------------------------------------------------------------
+void MS6205::renderPage(int page, const char *content)
+{
+  if (_pagingEnabled == false)
+  {
+    page = 0;
+  }
+  page = constrain(page, 0, NUMBER_OF_PAGES - 1);
+  showPage(page);                                               // Only the visible page can be written
+
+  // --- Page already holds content? ---
+  if (pageHolds(page, contentHash(content)))
+  {
+    return;
+  }
+
+  // --- Count writes with and without clearing first ---
+  int length = strnlen(content, NUMBER_OF_CHARACTERS);
+  int differing = 0;
+  int nonSpaces = 0;
+  for (int address = 0; address < NUMBER_OF_CHARACTERS; address++)
+  {
+    char character = contentCharacter(content, length, address);
+    if (character != _pageContent[page][address])
+    {
+      differing++;
+    }
+    if (character != ' ')
+    {
+      nonSpaces++;
+    }
+  }
+
+  if ((_urgentOnly == false) && (CLEAR_COST_IN_WRITES + nonSpaces < differing))
+  {
+    clear();
+  }
+
+  // --- Write differing cells only, urgent characters go first at every cell ---
+  startBulk();
+  for (int address = 0; address < NUMBER_OF_CHARACTERS; address++)
+  {
+    char character = contentCharacter(content, length, address);
+    if (character != _pageContent[page][address])
+    {
+      preemptBulk(UNKNOWN_POSITION);
+      if (urgentWritten(address) == false)                      // Not taken by a newer urgent character
+      {
+        writeCharacter(address & 0x0F, address >> 4, character);
+      }
+    }
+  }
+  writeUrgent();                                                // Queued during the last cell
+} // renderPage()
+
+//--------------------------------------------------------------
+/// \brief Optional: Show page with a screen asset
+///
+/// Like renderPage(), but decodes a compressed screen asset from flash on the fly,               \
+/// see MS6205_screen.h. Without paging, page 0 is used.
+///
+/// \param[in]  page    [0-3] Page to display
+/// \param[in]  screen  Screen asset in PROGMEM
+//--------------------------------------------------------------
+void MS6205::drawScreen(int page, const uint8_t *screen)
+{
+  if (_pagingEnabled == false)
+  {
+    page = 0;
+  }
+  page = constrain(page, 0, NUMBER_OF_PAGES - 1);
+  showPage(page);                                               // Only the visible page can be written
+
+  // --- Count writes with and without clearing first; decoding twice is cheaper than a buffer ---
+  screenReader counter(screen);
+  int differing = 0;
+  int nonSpaces = 0;
+  for (int address = 0; address < NUMBER_OF_CHARACTERS; address++)
+  {
+    char character = counter.next();
+    if (character != _pageContent[page][address])
+    {
+      differing++;
+    }
+    if (character != ' ')
+    {
+      nonSpaces++;
+    }
+  }
+
+  if (differing == 0)
+  {
+    return;
+  }
+  if ((_urgentOnly == false) && (CLEAR_COST_IN_WRITES + nonSpaces < differing))
+  {
+    clear();
+  }
+
+  // --- Write differing cells only, straight from the decoder, urgent characters first ---
+  screenReader reader(screen);
+  uint32_t state = lockBus();
+  int position = _address;
+  unlockBus(state);
+  startBulk();
+  for (int address = 0; address < NUMBER_OF_CHARACTERS; address++)
+  {
+    char character = reader.next();
+    if (character != _pageContent[page][address])
+    {
+      position = preemptBulk(position);
+      if (urgentWritten(address) == false)                      // Not taken by a newer urgent character
+      {
+        position = writeCell(position, address, character);
+      }
+    }
+  }
+  writeUrgent();                                                // Queued during the last cell
+} // drawScreen()
+
+//--------------------------------------------------------------
+/// \brief Repaint several pages
+///
+/// Renders pages 0 to count - 1 and shows the previously visible page again.                      \
+/// Use after invalidatePages() to restore all pages after a brownout.
+///
+/// \param[in]  pages  Content of each page, NULL to leave a page alone
+/// \param[in]  count  [1-4] Number of pages
+//--------------------------------------------------------------
+void MS6205::restorePages(const char * const pages[], int count)
+{
+  int visiblePage = _page;
+
+  count = constrain(count, 0, MS6205_MODEL_PAGES);
+  for (int page = 0; page < count; page++)
+  {
+    if (pages[page] != NULL)
+    {
+      renderPage(page, pages[page]);
+    }
+  }
+
+  showPage(visiblePage);
+} // restorePages()
+
+//--------------------------------------------------------------
+/// \brief Forget the content of all pages
+///
+/// Marks all cells of all pages unknown, so the next renderPage() writes everything.              \
+/// Use when the display may have lost or garbled its content.
+//--------------------------------------------------------------
+void MS6205::invalidatePages(void)
+{
+  memset(_pageContent, UNKNOWN_CHARACTER, sizeof(_pageContent));
+  for (int page = 0; page < MS6205_MODEL_PAGES; page++)
+  {
+    _pageHash[page] = 0;                                        // Unknown cells don't add to the hash
+  }
+} // invalidatePages()
+
+//--------------------------------------------------------------
+/// \brief Check if a page holds some content
+///
+/// \param[in]  page  [0-3] Page to check
+/// \param[in]  hash  Hash of the content, see contentHash()
+/// \return     true if the page holds content with this hash
+//--------------------------------------------------------------
+bool MS6205::pageHolds(int page, uint32_t hash)
+{
+  page = constrain(page, 0, MS6205_MODEL_PAGES - 1);
+  return (_pageHash[page] == hash);
+} // pageHolds()
+
+//--------------------------------------------------------------
+/// \brief Calculate hash of a page content
+///
+/// Precalculate the hash of a page's content once, to check it with pageHolds() later.
+///
+/// \param[in]  content  Up to 160 characters, row by row. Shorter content is filled with spaces.
+/// \return     Hash of content
+//--------------------------------------------------------------
+uint32_t MS6205::contentHash(const char *content)
+{
+  int length = strnlen(content, NUMBER_OF_CHARACTERS);
+  uint32_t hash = 0;
+  for (int address = 0; address < NUMBER_OF_CHARACTERS; address++)
+  {
+    hash += cellHash(address, contentCharacter(content, length, address));
+  }
+  return hash;
+} // contentHash()
+
+//--------------------------------------------------------------
+/// \brief Remember character written to visible page
+///
+/// Updates the page cache and the page's hash.                                                    \
+/// The hash is a sum over all cells, so it can be updated for a single cell.
+///
+/// \param[in]  address    0 (left-upper corner) to 159 (lower right corner)
+/// \param[in]  character  Character written
+//--------------------------------------------------------------
+void MS6205::storeCharacter(int address, char character)
+{
+  if ((address < 0) || (address >= NUMBER_OF_CHARACTERS))
+  {
+    return;
+  }
+
+  character &= 0x7F;                                            // Only 7 bits reach the display
+  setOverlaid(address, false);                                  // A normal write ends an overlay
+  char *cell = &_pageContent[_page][address];
+  _pageHash[_page] += cellHash(address, character) - cellHash(address, *cell);
+  *cell = character;
+} // storeCharacter()
+
+//--------------------------------------------------------------
+/// \brief Hash of a single cell
+///
+/// Mixes position and character, so equal characters at different positions differ.             \
+/// Unknown cells hash to 0.
+///
+/// \param[in]  address    0 (left-upper corner) to 159 (lower right corner)
+/// \param[in]  character  Character in cell
+/// \return     Hash of cell
+//--------------------------------------------------------------
+uint32_t MS6205::cellHash(int address, char character)
+{
+  if (character == UNKNOWN_CHARACTER)
+  {
+    return 0;
+  }
+
+  uint32_t hash = ((uint32_t)address << 8) | (uint8_t)character;
+  hash *= 0x9E3779B1UL;                                         // Multiply-xorshift mixing
+  hash ^= hash >> 15;
+  hash *= 0x85EBCA77UL;
+  hash ^= hash >> 13;
+  return hash;
+} // cellHash()
+
+//--------------------------------------------------------------
+/// \brief Character of a page content at given address
+///
+/// \param[in]  content  Page content
+/// \param[in]  length   Length of content, at most 160
+/// \param[in]  address  0 (left-upper corner) to 159 (lower right corner)
+/// \return     Character, space behind the end of content
+//--------------------------------------------------------------
+char MS6205::contentCharacter(const char *content, int length, int address)
+{
+  return (address < length) ? (content[address] & 0x7F) : ' ';
+} // contentCharacter()
+
+//--------------------------------------------------------------
+/// \brief Queue single character for the next flush()
+///
+/// Notes the character for a cell of the visible page without writing it yet.                   \
+/// Queuing the character a cell already shows cancels a queued change.                         \
+/// Urgent characters, and all characters inside the urgent region, go to queueUrgent() instead.     \
+/// Written right away if MS6205_QUEUE is 0.
+///
+/// \param[in]  column     Display column to write to, 0 (left) to 15 (right)
+/// \param[in]  row        Display row to write to, 0 (upper) to 9 (lower)
+/// \param[in]  character  Character to display
+/// \param[in]  priority   PRIORITY_BULK or PRIORITY_URGENT
+//--------------------------------------------------------------
+void MS6205::queueCharacter(int column, int row, char character, int priority)
+{
+  row = constrain(row, 0, NUMBER_OF_ROWS - 1);                  // Limit range of rows
+  column = constrain(column, 0, NUMBER_OF_COLUMNS - 1);         // Limit range of columns
+  int address = column | (row << 4);
+  character &= 0x7F;                                            // Only 7 bits reach the display
+
+#if MS6205_URGENT
+  int left = column - _urgentRegion[0];
+  int top = row - _urgentRegion[1];
+  if ((left >= 0) && (left < _urgentRegion[2]) && (top >= 0) && (top < _urgentRegion[3]))
+  {
+    priority = PRIORITY_URGENT;
+  }
+#endif
+  if (priority == PRIORITY_URGENT)
+  {
+    queueUrgent(column, row, character);
+    return;
+  }
+
+#if MS6205_QUEUE
+  if (character == _pageContent[_page][address])                // Already shown:
+  {
+    setQueued(address, false);                                  // Nothing to do, drop older queued change
+  }
+  else
+  {
+    _queuedContent[address] = character;
+    setQueued(address, true);
+  }
+#else
+  if (character != _pageContent[_page][address])                // No queue, write right away
+  {
+    writeCell(UNKNOWN_POSITION, address, character);
+  }
+#endif
+} // queueCharacter()
+
+//--------------------------------------------------------------
+/// \brief Queue text for the next flush()
+///
+/// Like write(), but only notes the characters. Wraps around to the next line and               \
+/// to the very beginning (upper-left corner) if text is too long.
+///
+/// \param[in]  column  Display column of first character, 0 (left) to 15 (right)
+/// \param[in]  row     Display row of first character, 0 (upper) to 9 (lower)
+/// \param[in]  text    Text to display
+//--------------------------------------------------------------
+void MS6205::queueText(int column, int row, const char *text)
+{
+  row = constrain(row, 0, NUMBER_OF_ROWS - 1);
+  column = constrain(column, 0, NUMBER_OF_COLUMNS - 1);
+  int address = column | (row << 4);
+
+  for (; *text != '\0'; text++)                                 // For each character of the text:
+  {
+    queueCharacter(address & 0x0F, address >> 4, toUpperCase(*text));   // MS6205 only supports uppercase latin letters
+
+    address++;                                                  // Increment position across columns and rows
+    if (address >= NUMBER_OF_CHARACTERS)                        // If display is full:
+    {
+      address = 0;                                              // Wrap around to the start
+    }
+  }
+} // queueText()
+
+//--------------------------------------------------------------
+/// \brief Write queued characters
+///
+/// Writes queued characters in address order with the cheapest address moves.                  \
+/// Limit the number of characters to spread a large update over several calls.                  \
+/// Writes only urgent characters if MS6205_QUEUE is 0.
+///
+/// \param[in]  maxCharacters  Maximum number of characters to write
+/// \return     Number of characters still queued
+//--------------------------------------------------------------
+int MS6205::flush(int maxCharacters)
+{
+#if MS6205_QUEUE
+  uint32_t state = lockBus();
+  int position = _address;                                      // Where the display's address counter points to
+  unlockBus(state);
+
+  // --- Walking the bitmap visits queued cells in address order, no sorting needed ---
+  for (int address = 0; (address < NUMBER_OF_CHARACTERS) && (maxCharacters > 0) && (_queuedCount > 0); address++)
+  {
+    if (isQueued(address) == false)
+    {
+      continue;
+    }
+
+    position = preemptBulk(position);                           // Urgent characters first, they drop older queued changes
+    if (isQueued(address) == false)
+    {
+      continue;
+    }
+
+    position = writeCell(position, address, _queuedContent[address]);
+    setQueued(address, false);
+    maxCharacters--;
+  }
+  writeUrgent();                                                // Queued during the last cell
+
+  return _queuedCount;
+#else
+  (void)maxCharacters;
+  writeUrgent();
+  return 0;                                                     // queueCharacter() wrote everything already
+#endif
+} // flush()
+
+//--------------------------------------------------------------
+/// \brief Write a cell with the cheapest address move
+///
+/// \param[in]  position   Where the display's address counter points to, or UNKNOWN_POSITION
+/// \param[in]  address    0 (left-upper corner) to 159 (lower right corner)
+/// \param[in]  character  Character to display
+/// \return     Where the display's address counter points to afterwards, or UNKNOWN_POSITION
+//--------------------------------------------------------------
+int MS6205::writeCell(int position, int address, char character)
+{
+  if (_ready == false)
+  {
+    prepareBus();                                               // Waits, so not inside the critical section
+  }
+
+  char *content = _pageContent[_page];
+  uint32_t state = lockBus();                                   // Move, write and auto-increment must not be split by writeAt()
+
+  // --- Move address counter to the cell ---
+  bool written = false;
+  switch (planMove(position, address, _busCost, content))
+  {
+    case MOVE_ADDRESS:
+      writePositioned(address, character);                      // One shift with the dual shift register
+      written = true;
+      break;
+
+    case MOVE_INCREMENT:
+      while (_address < address)
+      {
+        incrementColumn();
+      }
+      break;
+
+    case MOVE_REWRITE:
+      while (_address < address)
+      {
+        writeCharacter(content[_address]);                      // Same character again, display advances by itself
+        _address++;
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  // --- Write the cell ---
+  if (written == false)
+  {
+    writeCharacter(character);
+  }
+
+  if (_busCost.autoIncrement)
+  {
+    _address++;                                                 // Display advanced by itself..
+    position = ((_address & 0x0F) == 0) ? UNKNOWN_POSITION : _address;  // ..but where to after the end of a row is unknown
+  }
+  else
+  {
+    position = _address;
+  }
+
+  unlockBus(state);
+  return position;
+} // writeCell()
+
+//--------------------------------------------------------------
+/// \brief Number of queued characters
+///
+/// \return     Number of characters waiting for flush()
+//--------------------------------------------------------------
+int MS6205::queuedCharacters(void)
+{
+#if MS6205_QUEUE
+  return _queuedCount;
+#else
+  return 0;
+#endif
+} // queuedCharacters()
+
+//--------------------------------------------------------------
+/// \brief Drop queued characters
+///
+/// Forgets all queued characters without writing them.
+//--------------------------------------------------------------
+void MS6205::discardQueued(void)
+{
+#if MS6205_QUEUE
+  memset(_queuedCells, 0, sizeof(_queuedCells));
+  _queuedCount = 0;
+#endif
+} // discardQueued()
+
+//--------------------------------------------------------------
+/// \brief Queue single character for the next bus slot
+///
+/// Urgent characters, e.g. alarms, preempt bulk updates: renderPage(), drawScreen(), write() and      \
+/// flush() write them before their next cell and then resume where they were. Safe to call from      \
+/// interrupts, timer callbacks or other tasks; the character is only noted there. See PRIORITY LANES. \
+/// Written right away by writeAt() if MS6205_URGENT is 0.
+///
+/// \param[in]  column     Display column to write to, 0 (left) to 15 (right)
+/// \param[in]  row        Display row to write to, 0 (upper) to 9 (lower)
+/// \param[in]  character  Character to display
+/// \return     false if all URGENT_SLOTS were taken and the character was dropped, or writeAt() dropped it
+//--------------------------------------------------------------
+bool MS6205::queueUrgent(int column, int row, char character)
+{
+#if MS6205_URGENT
+  int address = cellAddress(column, row);
+  character &= 0x7F;                                            // Only 7 bits reach the display
+  unsigned long now = micros();
+  bool queued = true;
+
+  uint32_t state = lockBus(true);                               // Always atomic, main code and other interrupts queue too
+  _urgentOnly = true;                                           // Bulk updates must not clear from now on
+
+  // --- A cell still waiting takes the newer character, keeping its place and time ---
+  int slot = _urgentHead;
+  int i = 0;
+  while ((i < _urgentCount) && (_urgentAddress[slot] != address))
+  {
+    slot = (slot + 1) % URGENT_SLOTS;
+    i++;
+  }
+
+  if (i < _urgentCount)
+  {
+    _urgentCharacter[slot] = character;
+  }
+  else if (_urgentCount < URGENT_SLOTS)
+  {
+    _urgentAddress[slot] = address;                             // Slot after the newest one
+    _urgentCharacter[slot] = character;
+    _urgentMicros[slot] = now;
+    _urgentCount++;
+  }
+  else
+  {
+    _urgentCounters.dropped++;
+    queued = false;
+  }
+
+  unlockBus(state);
+  return queued;
+#else
+  _urgentOnly = true;                                           // Bulk updates must not clear from now on
+  return writeAt(column, row, character);                       // No lane, write right away; never waits
+#endif
+} // queueUrgent()
+
+//--------------------------------------------------------------
+/// \brief Write urgent characters now
+///
+/// Call from loop() to write urgent characters while no bulk update is running.
+///
+/// \return     Number of urgent characters handled
+//--------------------------------------------------------------
+int MS6205::flushUrgent(void)
+{
+#if MS6205_URGENT
+  uint32_t state = lockBus();
+  int previous = _address;                                      // Main code may be between setCursor() and writeCharacter()
+  unlockBus(state);
+
+  int handled = writeUrgent();
+  if (handled > 0)
+  {
+    writeAddress(previous);                                     // Leave the address counter as main code expects it
+  }
+
+  return handled;
+#else
+  return 0;                                                     // queueUrgent() wrote everything already
+#endif
+} // flushUrgent()
+
+//--------------------------------------------------------------
+/// \brief Set region whose queued characters are urgent
+///
+/// queueCharacter() and queueText() hand characters for cells inside the region to queueUrgent().  \
+/// A width or height of 0 removes the region. Ignored if MS6205_URGENT is 0.
+///
+/// \param[in]  column  Left column of the region, 0 (left) to 15 (right)
+/// \param[in]  row     Upper row of the region, 0 (upper) to 9 (lower)
+/// \param[in]  width   [columns] Width of the region
+/// \param[in]  height  [rows] Height of the region
+//--------------------------------------------------------------
+void MS6205::setUrgentRegion(int column, int row, int width, int height)
+{
+#if MS6205_URGENT
+  _urgentRegion[0] = constrain(column, 0, NUMBER_OF_COLUMNS - 1);
+  _urgentRegion[1] = constrain(row, 0, NUMBER_OF_ROWS - 1);
+  _urgentRegion[2] = constrain(width, 0, NUMBER_OF_COLUMNS - _urgentRegion[0]);
+  _urgentRegion[3] = constrain(height, 0, NUMBER_OF_ROWS - _urgentRegion[1]);
+  if ((_urgentRegion[2] > 0) && (_urgentRegion[3] > 0))
+  {
+    _urgentOnly = true;                                         // Bulk updates must not clear from now on
+  }
+#else
+  (void)column;
+  (void)row;
+  (void)width;
+  (void)height;
+#endif
+} // setUrgentRegion()
+
+//--------------------------------------------------------------
+/// \brief Optional: Keep urgent latency below one cell write
+///
+/// renderPage() and drawScreen() no longer clear the page when that is cheaper than writing      \
+/// the differing cells, as urgent characters would wait for the 20 ms hold of clear().          \
+/// The first queueUrgent() or setUrgentRegion() does the same; call this before the first bulk update.
+//--------------------------------------------------------------
+void MS6205::beginUrgent(void)
+{
+  _urgentOnly = true;
+} // beginUrgent()
+
+//--------------------------------------------------------------
+/// \brief Counters of the urgent lane
+///
+/// \return     Counters since construction or resetUrgentCounts()
+//--------------------------------------------------------------
+const urgentCounters &MS6205::urgentCounts(void)
+{
+#if MS6205_URGENT
+  return _urgentCounters;
+#else
+  static const urgentCounters none = {0, 0, 0, 0, 0};           // No lane, nothing to count
+  return none;
+#endif
+} // urgentCounts()
+
+//--------------------------------------------------------------
+/// \brief Reset counters of the urgent lane
+//--------------------------------------------------------------
+void MS6205::resetUrgentCounts(void)
+{
+#if MS6205_URGENT
+  uint32_t state = lockBus(true);                               // queueUrgent() counts drops from interrupts
+  memset(&_urgentCounters, 0, sizeof(_urgentCounters));
+  unlockBus(state);
+#endif
+} // resetUrgentCounts()
+
+//--------------------------------------------------------------
+/// \brief Write waiting urgent characters, oldest first
+///
+/// Each cell is written positioned; a bulk change still queued for it is outdated and dropped,     \
+/// and the running bulk update must not overwrite it either. The address counter is left behind.
+///
+/// \return     Number of urgent characters handled
+//--------------------------------------------------------------
+int MS6205::writeUrgent(void)
+{
+  int handled = 0;
+#if MS6205_URGENT
+
+  while (_urgentCount > 0)
+  {
+    // --- Take the oldest one, interrupts may add more meanwhile ---
+    uint32_t state = lockBus(true);
+    int address = _urgentAddress[_urgentHead];
+    char character = _urgentCharacter[_urgentHead];
+    unsigned long queued = _urgentMicros[_urgentHead];
+    _urgentHead = (_urgentHead + 1) % URGENT_SLOTS;
+    _urgentCount--;
+    unlockBus(state);
+
+    if (character != _pageContent[_page][address])
+    {
+      writePositioned(address, character);
+    }
+    setQueued(address, false);
+    _urgentWritten[address >> 3] |= 1 << (address & 0x07);
+
+    unsigned long latency = micros() - queued;
+    _urgentCounters.written++;
+    _urgentCounters.totalLatencyUs += latency;
+    if (latency > _urgentCounters.maxLatencyUs)
+    {
+      _urgentCounters.maxLatencyUs = latency;
+    }
+    handled++;
+  }
+#endif
+
+  return handled;
+} // writeUrgent()
+
+//--------------------------------------------------------------
+/// \brief Let urgent characters preempt a bulk update
+///
+/// Called by bulk updates before each cell, the bus slot urgent characters may take.
+///
+/// \param[in]  position  Where the display's address counter points to, or UNKNOWN_POSITION
+/// \return     Where it points to afterwards, UNKNOWN_POSITION after urgent writes
+//--------------------------------------------------------------
+int MS6205::preemptBulk(int position)
+{
+#if MS6205_URGENT
+  if (_urgentCount == 0)
+  {
+    return position;
+  }
+
+  _urgentCounters.preemptions++;
+  writeUrgent();
+  return UNKNOWN_POSITION;
+#else
+  return position;
+#endif
+} // preemptBulk()
+
+//--------------------------------------------------------------
+/// \brief Start a bulk update
+///
+/// Urgent characters written from now on are newer than the bulk update's content.
+//--------------------------------------------------------------
+void MS6205::startBulk(void)
+{
+#if MS6205_URGENT
+  memset(_urgentWritten, 0, sizeof(_urgentWritten));
+#endif
+} // startBulk()
+
+//--------------------------------------------------------------
+/// \brief Check if the running bulk update must leave a cell alone
+///
+/// \param[in]  address  0 (left-upper corner) to 159 (lower right corner)
+/// \return     true if an urgent character was written there since the bulk update started
+//--------------------------------------------------------------
+bool MS6205::urgentWritten(int address)
+{
+#if MS6205_URGENT
+  return (_urgentWritten[address >> 3] & (1 << (address & 0x07))) != 0;
+#else
+  (void)address;
+  return false;
+#endif
+} // urgentWritten()
+
+//--------------------------------------------------------------
+/// \brief Set cost of bus operations
+///
+/// Tells flush() how expensive address writes, character writes and increment pulses are      \
+/// with the transport in use. Defaults to bitBangBusCost.
+///
+/// \param[in]  cost  Cost of bus operations
+//--------------------------------------------------------------
+void MS6205::setBusCost(const busCost &cost)
+{
+  _busCost = cost;
+  if (_incrementEnabled == false)
+  {
+    _busCost.increment = 0;                                     // Increment pulses need line 6B
+  }
+} // setBusCost()
+
+//--------------------------------------------------------------
+/// \brief Initialize optional column increment functionality
+///
+/// Lets flush() move the address counter by pulsing "increment column address" 6B.
+///
+/// \param[in]  incrementColumnPin  CPU pin connected to MS6205 display "increment column address" pin 6B
+//--------------------------------------------------------------
+void MS6205::beginIncrement(int incrementColumnPin)
+{
+  _incrementColumnPin = incrementColumnPin;
+
+  pinMode(_incrementColumnPin, OUTPUT);
+  digitalWrite(_incrementColumnPin, HIGH);
+
+  _incrementEnabled = true;
+  if (_busCost.increment == 0)
+  {
+    _busCost.increment = bitBangBusCost.increment;
+  }
+} // beginIncrement()
+
+//--------------------------------------------------------------
+/// \brief Increment column address
+///
+/// Moves the display's address counter one cell to the right, inside the current row.
+//--------------------------------------------------------------
+void MS6205::incrementColumn(void)
+{
+  if (_ready == false)
+  {
+    prepareBus();                                               // begin() not called yet, or deferred clear running
+  }
+
+  uint32_t state = lockBus();
+
+  digitalWrite(_incrementColumnPin, LOW);                       // Pull "Increment column address" control line 6B low
+  delayMicroseconds(CONTROL_LINE_HOLD_TIME_US);                 // Hold for proper delay
+
+  digitalWrite(_incrementColumnPin, HIGH);                      // Pull "Increment column address" control line 6B high
+  delayMicroseconds(CONTROL_LINE_HOLD_TIME_US);                 // Hold for proper delay
+
+  _address = (_address & 0xF0) | ((_address + 1) & 0x0F);       // Column counter has 4 bits
+
+  unlockBus(state);
+} // incrementColumn()
+
+//--------------------------------------------------------------
+/// \brief Write single character at a given position, atomically
+///
+/// Sets the position and writes the character inside one critical section, then restores the         \
+/// previous address. Safe to call from interrupts, timer callbacks or other tasks, see beginConcurrent().  \
+/// Never waits: before begin() and while a deferred clear is running, the character is dropped.
+///
+/// \param[in]  column     Display column to write to, 0 (left) to 15 (right)
+/// \param[in]  row        Display row to write to, 0 (upper) to 9 (lower)
+/// \param[in]  character  Character to display
+/// \return     false if dropped, as begin() was not called yet or a deferred clear is running
+//--------------------------------------------------------------
+bool MS6205::writeAt(int column, int row, char character)
+{
+  int address = cellAddress(column, row);
+
+  uint32_t state = lockBus(true);                               // Always atomic, even without beginConcurrent()
+  if (_ready == false)
+  {
+    unlockBus(state);
+    return false;                                               // Never wait here, the caller may be an interrupt
+  }
+
+  int previous = _address;                                      // Main code may be between setCursor() and writeCharacter()
+
+  writePositioned(address, character);
+
+  if ((previous != address) || (_busCost.autoIncrement == true))
+  {
+    writeAddress(previous);                                     // Leave the address counter as main code expects it
+  }
+
+  unlockBus(state);
+  return true;
+} // writeAt()
+
+//--------------------------------------------------------------
+/// \brief Optional: Initialize concurrent use
+///
+/// Guards every bus access by a short critical section, so writeAt() may interleave              \
+/// with all other methods called from main code.
+//--------------------------------------------------------------
+void MS6205::beginConcurrent(void)
+{
+  _concurrent = true;
+} // beginConcurrent()
+
+//--------------------------------------------------------------
+/// \brief Enter critical section guarding the bus
+///
+/// Critical sections nest: each unlockBus() restores the interrupt state its lockBus() found,\
+/// so the bus is only released by the outermost one, and never from an interrupt or from\
+/// inside the caller's own noInterrupts() section.
+///
+/// \param[in]  always  Enter even without beginConcurrent()
+/// \return     State to hand to unlockBus()
+//--------------------------------------------------------------
+uint32_t MS6205::lockBus(bool always)
+{
+  if ((_concurrent == false) && (always == false))
+  {
+    return BUS_UNLOCKED;
+  }
+
+#if defined(__AVR__)
+  uint32_t state = SREG;                                        // Remember if interrupts were enabled
+  cli();
+  return state;
+#elif defined(ESP8266)
+  return xt_rsil(15);                                           // Mask all interrupt levels, returns previous level
+#elif defined(ESP32)
+  portENTER_CRITICAL_SAFE(&busMux);                             // Works from tasks and interrupts, nests on the same core
+  return 0;
+#elif defined(__arm__)
+  uint32_t state;
+  __asm__ volatile ("mrs %0, primask" : "=r" (state));          // Remember if interrupts were enabled
+  __asm__ volatile ("cpsid i" ::: "memory");
+  return state;
+#else
+  uint32_t state = __get_PRIMASK();                             // CMSIS names, emulated by the host build
+  __disable_irq();
+  return state;
+#endif
+} // lockBus()
+
+//--------------------------------------------------------------
+/// \brief Leave critical section guarding the bus
+///
+/// \param[in]  state  Value returned by the matching lockBus()
+//--------------------------------------------------------------
+void MS6205::unlockBus(uint32_t state)
+{
+  if (state == BUS_UNLOCKED)
+  {
+    return;
+  }
+
+#if defined(__AVR__)
+  SREG = (uint8_t)state;
+#elif defined(ESP8266)
+  xt_wsr_ps(state);
+#elif defined(ESP32)
+  portEXIT_CRITICAL_SAFE(&busMux);
+#elif defined(__arm__)
+  __asm__ volatile ("msr primask, %0" :: "r" (state) : "memory");
+#else
+  __set_PRIMASK(state);
+#endif
+} // unlockBus()
+
+//--------------------------------------------------------------
+/// \brief Check if cell is queued
+///
+/// \param[in]  address  0 (left-upper corner) to 159 (lower right corner)
+/// \return     true if cell waits for flush()
+//--------------------------------------------------------------
+bool MS6205::isQueued(int address)
+{
+#if MS6205_QUEUE
+  return (_queuedCells[address >> 3] & (1 << (address & 0x07))) != 0;
+#else
+  (void)address;
+  return false;
+#endif
+} // isQueued()
+
+//--------------------------------------------------------------
+/// \brief Mark cell queued or not
+///
+/// \param[in]  address  0 (left-upper corner) to 159 (lower right corner)
+/// \param[in]  queued   true if cell waits for flush()
+//--------------------------------------------------------------
+void MS6205::setQueued(int address, bool queued)
+{
+#if MS6205_QUEUE
+  uint8_t mask = 1 << (address & 0x07);
+  bool wasQueued = (_queuedCells[address >> 3] & mask) != 0;
+
+  if (queued && !wasQueued)
+  {
+    _queuedCells[address >> 3] |= mask;
+    _queuedCount++;
+  }
+  else if (!queued && wasQueued)
+  {
+    _queuedCells[address >> 3] &= ~mask;
+    _queuedCount--;
+  }
+#else
+  (void)address;
+  (void)queued;
+#endif
+} // setQueued()
+
+//--------------------------------------------------------------
+/// \brief Check if cell shows a character of writeOverlay()
+///
+/// \param[in]  address  0 (left-upper corner) to 159 (lower right corner)
+/// \return     true if the visible page shows an overlay there
+//--------------------------------------------------------------
+bool MS6205::isOverlaid(int address)
+{
+  return (_overlayPage == _page) && ((_overlaidCells[address >> 3] & (1 << (address & 0x07))) != 0);
+} // isOverlaid()
+
+//--------------------------------------------------------------
+/// \brief Mark cell of the visible page overlaid or not
+///
+/// \param[in]  address   0 (left-upper corner) to 159 (lower right corner)
+/// \param[in]  overlaid  true if the cell shows a character of writeOverlay()
+//--------------------------------------------------------------
+void MS6205::setOverlaid(int address, bool overlaid)
+{
+  if (_overlayPage != _page)
+  {
+    return;                                                     // Only writeOverlay() takes over another page
+  }
+  if (overlaid == true)
+  {
+    _overlaidCells[address >> 3] |= (1 << (address & 0x07));
+  }
+  else
+  {
+    _overlaidCells[address >> 3] &= ~(1 << (address & 0x07));
+  }
+} // setOverlaid()
+
+//--------------------------------------------------------------
+/// \brief Optional: Drive the bus from an 8-bit output port
+///
+/// Address and data bytes are written by a single store to the port instead of through      \
+/// the 74HC595. Sets the bus cost to parallelBusCost. See PARALLEL BUS.                    \
+/// Ignored if MS6205_PARALLEL is 0.
+///
+/// \param[in]  port       Output register of the port, e.g. &PORTD
+/// \param[in]  direction  Data direction register of the port, e.g. &DDRD
+//--------------------------------------------------------------
+void MS6205::beginParallel(volatile uint8_t *port, volatile uint8_t *direction)
+{
+#if MS6205_PARALLEL
+  uint32_t state = lockBus();                                   // writeAt() must not see a half-switched transport
+
+  *direction = 0xFF;                                            // All 8 lines are outputs
+  _port = port;
+  *_port = (uint8_t)_address;                                   // Same level the shift register drives
+  _transport = TRANSPORT_PARALLEL_PORT;
+  busCost cost = parallelBusCost;
+  cost.autoIncrement = _busCost.autoIncrement;                  // Property of the display, not of the transport
+  setBusCost(cost);
+
+  unlockBus(state);
+#else
+  (void)port;
+  (void)direction;
+#endif
+} // beginParallel()
+
+//--------------------------------------------------------------
+/// \brief Optional: Drive the bus from 8 individual pins
+///
+/// Address and data bytes are written to the pins instead of through the 74HC595.             \
+/// Sets the bus cost to parallelPinsBusCost. See PARALLEL BUS.                             \
+/// Ignored if MS6205_PARALLEL is 0.
+///
+/// \param[in]  pins  CPU pins connected to bus bits 1 to 8, lowest bit first
+//--------------------------------------------------------------
+void MS6205::beginParallel(const uint8_t pins[8])
+{
+#if MS6205_PARALLEL
+  for (int i = 0; i < 8; i++)
+  {
+    _busPins[i] = pins[i];
+    pinMode(_busPins[i], OUTPUT);
+  }
+
+#if defined(HAS_DEDICATED_GPIO)
+  // --- Bundle the pins, so one instruction writes all of them ---
+  if (_bundle == NULL)
+  {
+    int gpios[8];
+    for (int i = 0; i < 8; i++)
+    {
+      gpios[i] = _busPins[i];
+    }
+
+    dedic_gpio_bundle_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.gpio_array = gpios;
+    config.array_size = 8;
+    config.flags.out_en = 1;
+
+    dedic_gpio_bundle_handle_t bundle = NULL;
+    if (dedic_gpio_new_bundle(&config, &bundle) == ESP_OK)
+    {
+      _bundle = bundle;                                         // Otherwise digitalWrite() per pin
+    }
+  }
+#endif
+
+  uint32_t state = lockBus();                                   // writeAt() must not see a half-switched transport
+  _transport = TRANSPORT_PARALLEL_PINS;
+  busCost cost = parallelPinsBusCost;
+  cost.autoIncrement = _busCost.autoIncrement;                  // Property of the display, not of the transport
+  setBusCost(cost);
+  unlockBus(state);
+#else
+  (void)pins;
+#endif
+} // beginParallel()
+
+//--------------------------------------------------------------
+/// \brief Optional: Drive address and data lines through two chained 74HC595
+///
+/// A positioned character write then takes one 16-bit shift and one latch, followed          \
+/// by /Set address and /Set character. An address alone shifts 16 bits too, so write()      \
+/// moves on with the next character. Sets the bus cost to dualShiftBusCost. See DUAL SHIFT REGISTER.
+//--------------------------------------------------------------
+void MS6205::beginDualShiftRegister(void)
+{
+  uint32_t state = lockBus();                                   // writeAt() must not see a half-switched transport
+  _transport = TRANSPORT_DUAL_SHIFT_REGISTER;
+  busCost cost = dualShiftBusCost;
+  cost.autoIncrement = _busCost.autoIncrement;                  // Property of the display, not of the transport
+  setBusCost(cost);
+  unlockBus(state);
+} // beginDualShiftRegister()
+
+//--------------------------------------------------------------
+/// \brief Optional: Blink cursor without CPU polling
+///
+/// Lets a timer toggle "show cursor" 8A: the Ticker on ESP8266 and ESP32, or Timer1 in hardware        \
+/// on an ATmega328P if 8A is connected to pin 9 (OC1A) or 10 (OC1B). Timer1 is not usable for          \
+/// anything else then. showCursor() and hideCursor() stop blinking. Call beginCursor() before use.
+///
+/// \param[in]  interval  [ms] Time between two toggles, 0 to stop blinking
+/// \return     true if a timer blinks the cursor, false if not possible with this CPU or pin
+//--------------------------------------------------------------
+bool MS6205::blinkCursor(unsigned int interval)
+{
+  if ((_cursorEnabled == false) || ((interval == 0) && (_cursorBlinking == false)))
+  {
+    return false;
+  }
+
+#if defined(ESP8266) || defined(ESP32)
+  cursorTicker.detach();
+  if (interval > 0)
+  {
+    cursorTicker.attach_ms(interval, toggleCursorPin, _showCursorPin);
+  }
+#elif defined(__AVR_ATmega328P__) || defined(__AVR_ATmega168__)
+  if ((_showCursorPin != 9) && (_showCursorPin != 10))
+  {
+    return false;                                               // Only OC1A and OC1B are toggled by Timer1
+  }
+
+  TCCR1B = 0;                                                   // Stop Timer1
+  TCCR1A = 0;                                                   // Disconnect OC1A and OC1B, the pin keeps its level
+  if (interval > 0)
+  {
+    uint32_t top = ((uint32_t)(F_CPU / 1024UL) * interval) / 1000UL;
+    top = constrain(top, 1UL, 65536UL) - 1;                     // Longest interval is ~4.2 s at 16 MHz
+    TCNT1 = 0;
+    OCR1A = (uint16_t)top;                                      // TOP in CTC mode
+    OCR1B = (uint16_t)top;
+    TCCR1A = (_showCursorPin == 9) ? _BV(COM1A0) : _BV(COM1B0); // Toggle the pin on compare match
+    TCCR1B = _BV(WGM12) | _BV(CS12) | _BV(CS10);                // CTC mode, clock / 1024
+  }
+#else
+  return false;
+#endif
+
+  _cursorBlinking = (interval > 0);
+  return true;
+} // blinkCursor()
+
+//--------------------------------------------------------------
+/// \brief Character of a page in the page model
+///
+/// \param[in]  page     [0-3] Page
+/// \param[in]  address  0 (left-upper corner) to 159 (lower right corner)
+/// \return     Character written there last, UNKNOWN_CHARACTER if not known
+//--------------------------------------------------------------
+char MS6205::pageCharacter(int page, int address)
+{
+  if ((address < 0) || (address >= NUMBER_OF_CHARACTERS))
+  {
+    return UNKNOWN_CHARACTER;
+  }
+  return _pageContent[constrain(page, 0, MS6205_MODEL_PAGES - 1)][address];
+} // pageCharacter()
+
+//--------------------------------------------------------------
+/// \brief Visible page
+///
+/// \return     [0-3] Page selected by showPage(), 0 without paging
+//--------------------------------------------------------------
+int MS6205::currentPage(void)
+{
+  return _page;
+} // currentPage()
+
+//--------------------------------------------------------------
+/// \brief Write a temporary character, keeping the page model
+///
+/// Writes the character to the visible page, but the page model keeps what normal writes put      \
+/// there. Meant for effects like blinking: writing the model's character again ends the effect,    \
+/// and normal writes meanwhile are not lost. Until then, refreshCell() leaves the cell alone.
+///
+/// \param[in]  address    0 (left-upper corner) to 159 (lower right corner)
+/// \param[in]  character  Character to show for now
+//--------------------------------------------------------------
+void MS6205::writeOverlay(int address, char character)
+{
+  if ((address < 0) || (address >= NUMBER_OF_CHARACTERS))
+  {
+    return;
+  }
+
+  if (_ready == false)
+  {
+    prepareBus();                                               // Waits, so not inside the critical section
+  }
+
+  uint32_t state = lockBus();                                   // Model must not change between write and restore
+  int previous = _address;                                      // Main code may be between setCursor() and writeCharacter()
+  char shadow = _pageContent[_page][address];
+
+  writePositioned(address, character);
+  storeCharacter(address, shadow);                              // Model keeps what normal writes put there
+  if (_overlayPage != _page)
+  {
+    memset(_overlaidCells, 0, sizeof(_overlaidCells));         // Overlays of another page stay there, untracked
+    _overlayPage = _page;
+  }
+  setOverlaid(address, (character & 0x7F) != shadow);          // Model's character ends the overlay
+
+  if ((previous != address) || (_busCost.autoIncrement == true))
+  {
+    writeAddress(previous);                                     // Leave the address counter as main code expects it
+  }
+
+  unlockBus(state);
+} // writeOverlay()
+
+//--------------------------------------------------------------
+/// \brief Write a cell again from the page model
+///
+/// Repairs a cell corrupted by noise on the bus, as the display cannot be read back.         \
+/// The address counter is left where main code expects it. Cells showing a character of       \
+/// writeOverlay() are skipped, until a normal write or the model's character ends the overlay.
+///
+/// \param[in]  address  0 (left-upper corner) to 159 (lower right corner)
+/// \return     true if written, false if the page model does not know the cell or it is overlaid
+//--------------------------------------------------------------
+bool MS6205::refreshCell(int address)
+{
+  if ((address < 0) || (address >= NUMBER_OF_CHARACTERS))
+  {
+    return false;
+  }
+
+  if (_ready == false)
+  {
+    prepareBus();                                               // Waits, so not inside the critical section
+  }
+
+  uint32_t state = lockBus();                                   // Model must not change before the write
+  char character = _pageContent[_page][address];
+  if ((character == UNKNOWN_CHARACTER) || (isOverlaid(address) == true))
+  {
+    unlockBus(state);
+    return false;                                               // Never written, nothing to repair, or an effect shows there
+  }
+
+  int previous = _address;                                      // Main code may be between setCursor() and writeCharacter()
+  writePositioned(address, character);
+  if ((previous != address) || (_busCost.autoIncrement == true))
+  {
+    writeAddress(previous);                                     // Leave the address counter as main code expects it
+  }
 
+  unlockBus(state);
+  return true;
+} // refreshCell()
@@ -52,11 +52,31 @@
    Character  Ю  А  Б  Ц  Д   Е   Ф   Г   Х   И   Й   К   Л   М   Н   О   П   Я   Р   С   Т   У   Ж   В   Ь   Ы   З   Ш   Э   Щ   Ч   █
    
    
+  INITIALIZATION
+  =======================
+    The constructor only remembers pins, it does not touch the hardware, so a global MS6205 object is
+    safe before the core is up. begin() in setup() sets up the pins, selects page 0 and clears it:
+
+      BEGIN_CLEAR           Blocking clear, 20 ms
+      BEGIN_CLEAR_DEFERRED  Starts the clear and returns at once; the first bus access waits for the rest
+                            of the 20 ms, so other setup work overlaps the clear
+      BEGIN_NO_CLEAR        No clear at all; the page model is unknown, so renderPage() writes every cell
+
+    Optional begin...() calls for paging, cursor, transport etc. may come before or after begin().
+    Without begin(), the first bus access calls begin(BEGIN_CLEAR), as older sketches expect.
+
+    Warm restart: the display keeps its content while the CPU restarts. saveState() copies the model of
+    the visible page into a displayState, which the application keeps in memory surviving the restart
+    (MS6205_RETAINED on AVR and ESP32, RTC user memory on ESP8266). beginWarm() takes the model back
+    if the saved state is intact, so the next renderPage() only writes the cells that changed.
+   
+   
   CURSOR (optional)
   =======================
     MS6205 can show a black box at the cursor's current position.
     If control line 8A is low, the cursor is hidden.
     If control line 8A is high, a black box is shown.  
+    blinkCursor() lets a timer toggle 8A, so the cursor blinks without any CPU time in loop().
   
   
   PAGING (optional)
@@ -83,6 +103,91 @@
     8. Optionally repeat above steps to define more pages    
     
     
+  PAGE CACHE
+  =======================
+    The library keeps a model of every page's content, as far as it has been written through this library,
+    together with a hash of each page. Cells never written since power-up are unknown.
+    renderPage() and drawScreen() compare a requested page content with that model: if the page already holds it,
+    only the page is selected. Otherwise only the differing cells are written, or the page is cleared
+    first if that is cheaper than writing every differing cell (see CLEAR_COST_IN_WRITES).
+    clear() is assumed to clear the visible page only, as used in the paging steps above.
+    After a brownout, call invalidatePages() and then restorePages() to repaint all pages.
+    
+    
+  QUEUED WRITES
+  =======================
+    queueCharacter() and queueText() only note what a cell of the visible page should show.
+    flush() writes all noted cells in address order, skipping cells that already show their character.
+    Between two cells, the cheapest way to move the display's address counter is chosen
+    by the bus cost model, see MS6205_planner.h. If "increment column address" 6B is connected
+    to the CPU (beginIncrement()), short forward moves inside a row use increment pulses
+    instead of a full address write.
+    With MS6205_QUEUE 0, there is no queue: queueCharacter() and queueText() write differing cells
+    right away, and flush() has nothing left to write.
+    
+    
+  CONCURRENT USE
+  =======================
+    Address and data share one 74HC595, and the display keeps the address between writes.
+    So setCursor() followed by writeCharacter() is not atomic: a write from an interrupt or another
+    task in between lands at the wrong position, and an interrupted shiftOut() latches garbage.
+    writeAt() sets the position and writes the character as one operation with interrupts disabled
+    (a spinlock on the ESP32), and restores the previous address afterwards. It may be called from
+    interrupts, timer callbacks or other tasks at any time. Afterwards, interrupts are enabled again
+    only if they were enabled before (SREG on AVR, PRIMASK on ARM).
+    After beginConcurrent(), every other bus access is guarded by the same short critical section,
+    so main code keeps using all other methods from one context while writeAt() may interleave.
+    The 20 ms hold of clear() is not guarded; characters written by writeAt() meanwhile may be lost.
+    writeAt() never waits: before begin() and during a deferred clear it drops the character and
+    returns false.
+    Queued writes are not interrupt-safe; use queueCharacter() and queueText() from one context only.
+    
+    
+  PRIORITY LANES
+  =======================
+    Bulk updates (renderPage(), drawScreen(), write() and flush()) write cell by cell. Urgent characters,
+    noted by queueUrgent() from anywhere, or by queueCharacter() with PRIORITY_URGENT or inside the
+    region given to setUrgentRegion(), take the next bus slot: the bulk update writes them before its
+    next cell and then goes on where it was. Cells already written are not written again, and the bulk
+    update leaves the urgent cells alone, as they are newer. Without a bulk update running, call
+    flushUrgent() from loop(). So an urgent character waits for one cell write at most, unless a clear()
+    is running. Once the urgent lane is used (queueUrgent() or setUrgentRegion()), renderPage() and
+    drawScreen() never clear as a shortcut; beginUrgent() in setup() makes that so from the start.
+    urgentCounts() reports the worst-case and total latency from queueUrgent() to the write.
+    With MS6205_URGENT 0, there is no urgent lane: queueUrgent() writes the character by writeAt()
+    right away, setUrgentRegion() is ignored and urgentCounts() stays 0.
+    
+    
+  PARALLEL BUS (optional)
+  =======================
+    Shifting a byte through the 74HC595 takes 8 clock pulses and a latch. Boards with 8 free outputs
+    can drive the shared address/data bus directly instead, see beginParallel():
+    
+     - An 8-bit output port, e.g. PORTD of an ATmega328P: the whole byte is written by one store.
+       All 8 bits of the port belong to the bus then; on an Uno, D0 and D1 can't be used for Serial.
+     - 8 individual pins. On ESP32 variants with dedicated GPIO (S2, S3, C3, ...) they are combined
+       into a bundle written by one instruction, elsewhere each pin is written by digitalWrite().
+    
+    Bit 0 of the byte drives address bit 1 (8B) and data bit 1 (22A), and so on, in the same order
+    as the 74HC595 outputs 15, 1..7 in the wiring below. The control lines stay as they are.
+    
+    
+  DUAL SHIFT REGISTER (optional)
+  =======================
+    With a single 74HC595, address and data share its outputs, so a positioned character write
+    needs two shift and latch cycles. With two chained 74HC595 (see beginDualShiftRegister()),
+    address and data lines get their own outputs:
+    
+     - The first 74HC595 (serial data from the CPU) drives the data lines, wired like the single one.
+     - Its serial output QH' (pin 9) feeds serial input 14 of the second one, which drives the
+       address lines. Latch and clock are shared.
+    
+    A positioned write is one 16-bit shift and one latch, followed by /Set address and /Set character
+    back to back. Character-only writes shift 8 bits into the data register, as before. An address
+    alone has to pass the data register, 16 bits as well, so write() sets the next position together
+    with the next character instead of after each one.
+    
+    
   SOCKET PIN ORDER
   ===========================
   
@@ -220,16 +325,129 @@
 #define MS6205_H
 
 #include "Arduino.h"
+#include "MS6205_format.h"
+#include "MS6205_planner.h"
 
 #define NUMBER_OF_COLUMNS          16   // Number of columns in each row
 #define NUMBER_OF_ROWS             10   // Number of rows in each column
 #define NUMBER_OF_CHARACTERS      160   // Number of characters in all columns and rows (= columns * rows)
 #define NUMBER_OF_PAGES             4   // Number of pages supported
 
+#define UNKNOWN_CHARACTER           0   // Page cache content of a cell that has not been written yet
+
+#ifndef CLEAR_COST_IN_WRITES
+  #if defined(__AVR__)
+    #define CLEAR_COST_IN_WRITES  100   // [characters] Positioned character writes taking as long as one 20 ms clear()
+  #else
+    #define CLEAR_COST_IN_WRITES  400   // [characters] Positioned character writes taking as long as one 20 ms clear()
+  #endif
+#endif
+
+#ifndef MS6205_PAGING
+  #define MS6205_PAGING             1   // 0: beginPaging() is ignored, only page 0 is modelled. Saves 492 bytes RAM
+#endif
+
+#ifndef MS6205_PARALLEL
+  #define MS6205_PARALLEL           1   // 0: beginParallel() is ignored. Saves the port and bus pin fields
+#endif
+
+#ifndef MS6205_QUEUE
+  #define MS6205_QUEUE              1   // 0: queueCharacter() writes right away, see QUEUED WRITES. Saves 181 bytes RAM
+#endif
+
+#ifndef MS6205_URGENT
+  #define MS6205_URGENT             1   // 0: queueUrgent() writes by writeAt(), see PRIORITY LANES. Saves the urgent lane
+#endif
+
+#if MS6205_PAGING
+  #define MS6205_MODEL_PAGES        NUMBER_OF_PAGES
+#else
+  #define MS6205_MODEL_PAGES        1
+#endif
+
+#define TRANSPORT_SHIFT_REGISTER        0   // Address and data through the 74HC595 (default)
+#define TRANSPORT_PARALLEL_PORT         1   // Address and data by one store to an 8-bit output port
+#define TRANSPORT_PARALLEL_PINS         2   // Address and data on 8 individual pins
+#define TRANSPORT_DUAL_SHIFT_REGISTER   3   // Address and data on two chained 74HC595
+
+#define BEGIN_CLEAR                 0   // begin() clears the display, blocking for 20 ms
+#define BEGIN_CLEAR_DEFERRED        1   // begin() starts the clear, the first bus access waits for the rest
+#define BEGIN_NO_CLEAR              2   // begin() leaves the display as it is
+
+#ifndef URGENT_SLOTS
+  #define URGENT_SLOTS              8   // Urgent characters waiting for the next bus slot, see queueUrgent()
+#endif
+
+#define PRIORITY_BULK               0   // queueCharacter() notes the character for flush()
+#define PRIORITY_URGENT             1   // queueCharacter() hands the character to the urgent lane
+
+#define MS6205_STATE_MAGIC  0x36323035UL   // displayState::magic of a saved state, "6205"
+
+#if defined(__AVR__)
+  #define MS6205_RETAINED  __attribute__((section(".noinit")))   // Not initialized at startup, survives a reset
+#elif defined(ESP32)
+  #define MS6205_RETAINED  RTC_NOINIT_ATTR                       // RTC memory, survives a reset and deep sleep
+#else
+  #define MS6205_RETAINED                                        // ESP8266: copy from/to RTC user memory instead
+#endif
+
 #define BIG_DIGIT_WIDTH             3   // [columns] A "big" digit is 3 characters wide
 #define BIG_DIGIT_HEIGHT            5   // [rows] A "big" digit is 5 characters tall
 #define BIG_SPACE_WIDTH             1   // [columns] A "big" space between two "big" digits
 
+//--------------------------------------------------------------
+/// \brief Address byte of a cell
+///
+/// On MS6205 address bus, bits A1-A4 address the column (0-15) and bits A5-A8 address the row (0-9).
+///
+/// \param[in]  column  Display column, 0 (left) to 15 (right), limited to that range
+/// \param[in]  row     Display row, 0 (upper) to 9 (lower), limited to that range
+/// \return     0 (left-upper corner) to 159 (lower right corner)
+//--------------------------------------------------------------
+constexpr uint8_t cellAddress(int column, int row)
+{
+  return (uint8_t)(constrain(column, 0, NUMBER_OF_COLUMNS - 1) | (constrain(row, 0, NUMBER_OF_ROWS - 1) << 4));
+}
+
+//--------------------------------------------------------------
+/// \brief Data bus byte of a character
+///
+/// The data bus is inverted and only 7 bits wide.
+///
+/// \param[in]  character  Character to display
+/// \return     Byte to put on the data lines
+//--------------------------------------------------------------
+constexpr uint8_t busData(char character)
+{
+  return (uint8_t)(~character & 0x7F);
+}
+
+//--------------------------------------------------------------
+/// \brief Model of the visible page, saved for a warm restart
+///
+/// 172 bytes, a multiple of 4 to fit ESP8266 RTC user memory.
+//--------------------------------------------------------------
+struct displayState
+{
+  uint32_t magic;                           // MS6205_STATE_MAGIC if saved
+  uint32_t hash;                            // Page hash of the content, to detect corrupted memory
+  uint8_t page;                             // [0-3] Visible page
+  uint8_t reserved[3];
+  char content[NUMBER_OF_CHARACTERS];       // Model of the visible page, UNKNOWN_CHARACTER for unknown cells
+};
+
+//--------------------------------------------------------------
+/// \brief Counters of the urgent lane, see queueUrgent()
+//--------------------------------------------------------------
+struct urgentCounters
+{
+  unsigned long written;                    // Urgent characters written
+  unsigned long dropped;                    // Urgent characters lost, as all URGENT_SLOTS were taken
+  unsigned long preemptions;                // Bulk updates paused to write urgent characters
+  unsigned long maxLatencyUs;               // [us] Longest time from queueUrgent() to the write
+  unsigned long totalLatencyUs;             // [us] Sum of all latencies, divide by written for the average
+};
+
 class MS6205
 {
   public:
@@ -237,7 +455,7 @@ class MS6205
     //--------------------------------------------------------------
     /// \brief Class constructor 
     ///
-    /// Creates MS6205 object and initializes pins & variables.
+    /// Creates MS6205 object and initializes variables. The hardware is set up by begin().
     ///
     /// \param[in]  shiftRegisterLatchPin  CPU pin connected to 74HC595 shift register "latch" pin 12
     /// \param[in]  shiftRegisterClockPin  CPU pin connected to 74HC595 shift register "clock" pin 11
@@ -247,6 +465,45 @@ class MS6205
     /// \param[in]  clearPin               CPU pin connected to MS6205 display "clear" pin 18A
     //--------------------------------------------------------------
     MS6205(int shiftRegisterLatchPin, int shiftRegisterClockPin, int shiftRegisterDataPin, int setCursorPin, int setCharacterPin, int clearPin);
+    
+    //--------------------------------------------------------------
+    /// \brief Initialize display
+    ///
+    /// Sets up the pins and selects page 0. Call in setup(). See INITIALIZATION.
+    ///
+    /// \param[in]  mode  BEGIN_CLEAR, BEGIN_CLEAR_DEFERRED or BEGIN_NO_CLEAR
+    //--------------------------------------------------------------
+    void begin(int mode = BEGIN_CLEAR);
+    
+    //--------------------------------------------------------------
+    /// \brief Initialize display after a restart, keeping its content
+    ///
+    /// Takes the page model from a state saved by saveState() before the restart, without       \
+    /// clearing. If the state is not intact, it is the same as begin(BEGIN_CLEAR).
+    /// Call beginPaging() before, so the saved page can be selected.
+    ///
+    /// \param[in]  state  State saved before the restart
+    /// \return     true if the saved state was taken, false if the display was cleared
+    //--------------------------------------------------------------
+    bool beginWarm(const displayState *state);
+    
+    //--------------------------------------------------------------
+    /// \brief Save the visible page's model for a warm restart
+    ///
+    /// Characters still queued are not part of it. Call after the display changed.
+    ///
+    /// \param[out] state  State to keep in memory surviving the restart
+    //--------------------------------------------------------------
+    void saveState(displayState *state);
+    
+    //--------------------------------------------------------------
+    /// \brief Check for a deferred clear
+    ///
+    /// Never blocks: completes the clear started by begin(BEGIN_CLEAR_DEFERRED) if it is due.
+    ///
+    /// \return     true while the clear is still running
+    //--------------------------------------------------------------
+    bool clearing(void);
         
     //--------------------------------------------------------------
     /// \brief Set cursor
@@ -342,6 +599,43 @@ class MS6205
     //--------------------------------------------------------------
     void writeBigDigit(int column, int row, int digit);
     
+    //--------------------------------------------------------------
+    /// \brief Write a number into a fixed-width field
+    ///
+    /// Formats the number on the stack, without creating a String, and writes the whole field.        \
+    /// Unused positions are filled with the pad character, so an old, longer value is overwritten.    \
+    /// If the number does not fit, the field is filled with '#'.                                      \
+    /// The field is cut off at the end of the row.
+    ///
+    /// \param[in]  column  Display column of the field's leftmost character
+    /// \param[in]  row     Display row of the field
+    /// \param[in]  width   [characters] Width of the field, up to 16
+    /// \param[in]  value   Number to display
+    /// \param[in]  base    [2-36] Base of number system, e.g. DEC or HEX
+    /// \param[in]  align   ALIGN_LEFT, ALIGN_RIGHT or ALIGN_CENTER
+    /// \param[in]  pad     Character to fill unused positions with, e.g. ' ' or '0'
+    //--------------------------------------------------------------
+    void writeNumber(int column, int row, int width, long value, int base = 10, int align = ALIGN_RIGHT, char pad = ' ');
+    void writeNumber(int column, int row, int width, unsigned long value, int base = 10, int align = ALIGN_RIGHT, char pad = ' ');
+    void writeNumber(int column, int row, int width, int value, int base = 10, int align = ALIGN_RIGHT, char pad = ' ');
+    void writeNumber(int column, int row, int width, unsigned int value, int base = 10, int align = ALIGN_RIGHT, char pad = ' ');
+    
+    //--------------------------------------------------------------
+    /// \brief Write a floating point number into a fixed-width field
+    ///
+    /// Like writeNumber() for integers, but with a fixed number of decimals.                         \
+    /// The value is rounded to the given number of decimals.
+    ///
+    /// \param[in]  column    Display column of the field's leftmost character
+    /// \param[in]  row       Display row of the field
+    /// \param[in]  width     [characters] Width of the field, up to 16
+    /// \param[in]  value     Number to display
+    /// \param[in]  decimals  [0-7] Number of digits after the decimal point
+    /// \param[in]  align     ALIGN_LEFT, ALIGN_RIGHT or ALIGN_CENTER
+    /// \param[in]  pad       Character to fill unused positions with, e.g. ' ' or '0'
+    //--------------------------------------------------------------
+    void writeNumber(int column, int row, int width, double value, int decimals = 2, int align = ALIGN_RIGHT, char pad = ' ');
+    
     //--------------------------------------------------------------
     /// \brief Clear the display
     ///
@@ -375,10 +669,23 @@ class MS6205
     //--------------------------------------------------------------
     void hideCursor(void);
     
+    //--------------------------------------------------------------
+    /// \brief Optional: Blink cursor without CPU polling
+    ///
+    /// Lets a timer toggle "show cursor" 8A: the Ticker on ESP8266 and ESP32, or Timer1 in hardware        \
+    /// on an ATmega328P if 8A is connected to pin 9 (OC1A) or 10 (OC1B). Timer1 is not usable for          \
+    /// anything else then. showCursor() and hideCursor() stop blinking. Call beginCursor() before use.
+    ///
+    /// \param[in]  interval  [ms] Time between two toggles, 0 to stop blinking
+    /// \return     true if a timer blinks the cursor, false if not possible with this CPU or pin
+    //--------------------------------------------------------------
+    bool blinkCursor(unsigned int interval);
+    
     //--------------------------------------------------------------
     /// \brief Optional: Initialize paging functionality 
     ///
-    /// Initialize pins & variables needed for paging and select page 0 (first).                                   
+    /// Initialize pins & variables needed for paging and select page 0 (first).                                   \
+    /// Ignored if MS6205_PAGING is 0.
     ///                                                                                                           
     /// \param[in]  selectPage0Pin  CPU pin connected to MS6205 display "select page 0" pin 2A                    
     /// \param[in]  selectPage1Pin  CPU pin connected to MS6205 display "select page 1" pin 2B
@@ -394,23 +701,370 @@ class MS6205
     //--------------------------------------------------------------
     void showPage(int page);
     
+    //--------------------------------------------------------------
+    /// \brief Optional: Show page with given content
+    ///
+    /// Selects the page and brings it to the given content with as few writes as possible.           \
+    /// Nothing is written if the page already holds the content.                                      \
+    /// Characters are taken as they are, like writeCharacter() does.                                  \
+    /// Without paging, page 0 is used.
+    ///
+    /// \param[in]  page     [0-3] Page to display
+    /// \param[in]  content  Up to 160 characters, row by row. Shorter content is filled with spaces.
+    //--------------------------------------------------------------
+    void renderPage(int page, const char *content);
+    
+    //--------------------------------------------------------------
+    /// \brief Optional: Show page with a screen asset
+    ///
+    /// Like renderPage(), but decodes a compressed screen asset from flash on the fly,               \
+    /// see MS6205_screen.h. Without paging, page 0 is used.
+    ///
+    /// \param[in]  page    [0-3] Page to display
+    /// \param[in]  screen  Screen asset in PROGMEM
+    //--------------------------------------------------------------
+    void drawScreen(int page, const uint8_t *screen);
+    
+    //--------------------------------------------------------------
+    /// \brief Optional: Repaint several pages
+    ///
+    /// Renders pages 0 to count - 1 and shows the previously visible page again.                      \
+    /// Use after invalidatePages() to restore all pages after a brownout.
+    ///
+    /// \param[in]  pages  Content of each page, NULL to leave a page alone
+    /// \param[in]  count  [1-4] Number of pages
+    //--------------------------------------------------------------
+    void restorePages(const char * const pages[], int count);
+    
+    //--------------------------------------------------------------
+    /// \brief Optional: Forget the content of all pages
+    ///
+    /// Marks all cells of all pages unknown, so the next renderPage() writes everything.              \
+    /// Use when the display may have lost or garbled its content.
+    //--------------------------------------------------------------
+    void invalidatePages(void);
+    
+    //--------------------------------------------------------------
+    /// \brief Optional: Check if a page holds some content
+    ///
+    /// \param[in]  page  [0-3] Page to check
+    /// \param[in]  hash  Hash of the content, see contentHash()
+    /// \return     true if the page holds content with this hash
+    //--------------------------------------------------------------
+    bool pageHolds(int page, uint32_t hash);
+    
+    //--------------------------------------------------------------
+    /// \brief Calculate hash of a page content
+    ///
+    /// Precalculate the hash of a page's content once, to check it with pageHolds() later.
+    ///
+    /// \param[in]  content  Up to 160 characters, row by row. Shorter content is filled with spaces.
+    /// \return     Hash of content
+    //--------------------------------------------------------------
+    static uint32_t contentHash(const char *content);
+    
+    //--------------------------------------------------------------
+    /// \brief Queue single character for the next flush()
+    ///
+    /// Notes the character for a cell of the visible page without writing it yet.                   \
+    /// Queuing the character a cell already shows cancels a queued change.                         \
+    /// Urgent characters, and all characters inside the urgent region, go to queueUrgent() instead.     \
+    /// Written right away if MS6205_QUEUE is 0.
+    ///
+    /// \param[in]  column     Display column to write to, 0 (left) to 15 (right)
+    /// \param[in]  row        Display row to write to, 0 (upper) to 9 (lower)
+    /// \param[in]  character  Character to display
+    /// \param[in]  priority   PRIORITY_BULK or PRIORITY_URGENT
+    //--------------------------------------------------------------
+    void queueCharacter(int column, int row, char character, int priority = PRIORITY_BULK);
+    
+    //--------------------------------------------------------------
+    /// \brief Queue text for the next flush()
+    ///
+    /// Like write(), but only notes the characters. Wraps around to the next line and               \
+    /// to the very beginning (upper-left corner) if text is too long.
+    ///
+    /// \param[in]  column  Display column of first character, 0 (left) to 15 (right)
+    /// \param[in]  row     Display row of first character, 0 (upper) to 9 (lower)
+    /// \param[in]  text    Text to display
+    //--------------------------------------------------------------
+    void queueText(int column, int row, const char *text);
+    
+    //--------------------------------------------------------------
+    /// \brief Write queued characters
+    ///
+    /// Writes queued characters in address order with the cheapest address moves.                  \
+    /// Limit the number of characters to spread a large update over several calls.                  \
+    /// Writes only urgent characters if MS6205_QUEUE is 0.
+    ///
+    /// \param[in]  maxCharacters  Maximum number of characters to write
+    /// \return     Number of characters still queued
+    //--------------------------------------------------------------
+    int flush(int maxCharacters = NUMBER_OF_CHARACTERS);
+    
+    //--------------------------------------------------------------
+    /// \brief Number of queued characters
+    ///
+    /// \return     Number of characters waiting for flush()
+    //--------------------------------------------------------------
+    int queuedCharacters(void);
+    
+    //--------------------------------------------------------------
+    /// \brief Drop queued characters
+    ///
+    /// Forgets all queued characters without writing them.
+    //--------------------------------------------------------------
+    void discardQueued(void);
+    
+    //--------------------------------------------------------------
+    /// \brief Queue single character for the next bus slot
+    ///
+    /// Urgent characters, e.g. alarms, preempt bulk updates: renderPage(), drawScreen(), write() and      \
+    /// flush() write them before their next cell and then resume where they were. Safe to call from      \
+    /// interrupts, timer callbacks or other tasks; the character is only noted there. See PRIORITY LANES. \
+    /// Written right away by writeAt() if MS6205_URGENT is 0.
+    ///
+    /// \param[in]  column     Display column to write to, 0 (left) to 15 (right)
+    /// \param[in]  row        Display row to write to, 0 (upper) to 9 (lower)
+    /// \param[in]  character  Character to display
+    /// \return     false if all URGENT_SLOTS were taken and the character was dropped, or writeAt() dropped it
+    //--------------------------------------------------------------
+    bool queueUrgent(int column, int row, char character);
+    
+    //--------------------------------------------------------------
+    /// \brief Write urgent characters now
+    ///
+    /// Call from loop() to write urgent characters while no bulk update is running.
+    ///
+    /// \return     Number of urgent characters handled
+    //--------------------------------------------------------------
+    int flushUrgent(void);
+    
+    //--------------------------------------------------------------
+    /// \brief Set region whose queued characters are urgent
+    ///
+    /// queueCharacter() and queueText() hand characters for cells inside the region to queueUrgent().  \
+    /// A width or height of 0 removes the region. Ignored if MS6205_URGENT is 0.
+    ///
+    /// \param[in]  column  Left column of the region, 0 (left) to 15 (right)
+    /// \param[in]  row     Upper row of the region, 0 (upper) to 9 (lower)
+    /// \param[in]  width   [columns] Width of the region
+    /// \param[in]  height  [rows] Height of the region
+    //--------------------------------------------------------------
+    void setUrgentRegion(int column, int row, int width, int height);
+    
+    //--------------------------------------------------------------
+    /// \brief Optional: Keep urgent latency below one cell write
+    ///
+    /// renderPage() and drawScreen() no longer clear the page when that is cheaper than writing      \
+    /// the differing cells, as urgent characters would wait for the 20 ms hold of clear().          \
+    /// The first queueUrgent() or setUrgentRegion() does the same; call this before the first bulk update.
+    //--------------------------------------------------------------
+    void beginUrgent(void);
+    
+    //--------------------------------------------------------------
+    /// \brief Counters of the urgent lane
+    ///
+    /// \return     Counters since construction or resetUrgentCounts()
+    //--------------------------------------------------------------
+    const urgentCounters &urgentCounts(void);
+    
+    //--------------------------------------------------------------
+    /// \brief Reset counters of the urgent lane
+    //--------------------------------------------------------------
+    void resetUrgentCounts(void);
+    
+    //--------------------------------------------------------------
+    /// \brief Set cost of bus operations
+    ///
+    /// Tells flush() how expensive address writes, character writes and increment pulses are      \
+    /// with the transport in use. Defaults to bitBangBusCost.
+    ///
+    /// \param[in]  cost  Cost of bus operations
+    //--------------------------------------------------------------
+    void setBusCost(const busCost &cost);
+    
+    //--------------------------------------------------------------
+    /// \brief Optional: Initialize column increment functionality
+    ///
+    /// Lets flush() move the address counter by pulsing "increment column address" 6B.
+    ///
+    /// \param[in]  incrementColumnPin  CPU pin connected to MS6205 display "increment column address" pin 6B
+    //--------------------------------------------------------------
+    void beginIncrement(int incrementColumnPin);
+    
+    //--------------------------------------------------------------
+    /// \brief Write single character at a given position, atomically
+    ///
+    /// Sets the position and writes the character inside one critical section, then restores the         \
+    /// previous address. Safe to call from interrupts, timer callbacks or other tasks, see beginConcurrent().  \
+    /// Never waits: before begin() and while a deferred clear is running, the character is dropped.
+    ///
+    /// \param[in]  column     Display column to write to, 0 (left) to 15 (right)
+    /// \param[in]  row        Display row to write to, 0 (upper) to 9 (lower)
+    /// \param[in]  character  Character to display
+    /// \return     false if dropped, as begin() was not called yet or a deferred clear is running
+    //--------------------------------------------------------------
+    bool writeAt(int column, int row, char character);
+    
+    //--------------------------------------------------------------
+    /// \brief Optional: Initialize concurrent use
+    ///
+    /// Guards every bus access by a short critical section, so writeAt() may interleave              \
+    /// with all other methods called from main code.
+    //--------------------------------------------------------------
+    void beginConcurrent(void);
+    
+    //--------------------------------------------------------------
+    /// \brief Optional: Drive the bus from an 8-bit output port
+    ///
+    /// Address and data bytes are written by a single store to the port instead of through      \
+    /// the 74HC595. Sets the bus cost to parallelBusCost. See PARALLEL BUS.                    \
+    /// Ignored if MS6205_PARALLEL is 0.
+    ///
+    /// \param[in]  port       Output register of the port, e.g. &PORTD
+    /// \param[in]  direction  Data direction register of the port, e.g. &DDRD
+    //--------------------------------------------------------------
+    void beginParallel(volatile uint8_t *port, volatile uint8_t *direction);
+    
+    //--------------------------------------------------------------
+    /// \brief Optional: Drive the bus from 8 individual pins
+    ///
+    /// Address and data bytes are written to the pins instead of through the 74HC595.             \
+    /// Sets the bus cost to parallelPinsBusCost. See PARALLEL BUS.                             \
+    /// Ignored if MS6205_PARALLEL is 0.
+    ///
+    /// \param[in]  pins  CPU pins connected to bus bits 1 to 8, lowest bit first
+    //--------------------------------------------------------------
+    void beginParallel(const uint8_t pins[8]);
+    
+    //--------------------------------------------------------------
+    /// \brief Optional: Drive address and data lines through two chained 74HC595
+    ///
+    /// A positioned character write then takes one 16-bit shift and one latch, followed          \
+    /// by /Set address and /Set character. An address alone shifts 16 bits too, so write()      \
+    /// moves on with the next character. Sets the bus cost to dualShiftBusCost. See DUAL SHIFT REGISTER.
+    //--------------------------------------------------------------
+    void beginDualShiftRegister(void);
+    
+    //--------------------------------------------------------------
+    /// \brief Character of a page in the page model
+    ///
+    /// \param[in]  page     [0-3] Page
+    /// \param[in]  address  0 (left-upper corner) to 159 (lower right corner)
+    /// \return     Character written there last, UNKNOWN_CHARACTER if not known
+    //--------------------------------------------------------------
+    char pageCharacter(int page, int address);
+    
+    //--------------------------------------------------------------
+    /// \brief Visible page
+    ///
+    /// \return     [0-3] Page selected by showPage(), 0 without paging
+    //--------------------------------------------------------------
+    int currentPage(void);
+    
+    //--------------------------------------------------------------
+    /// \brief Write a temporary character, keeping the page model
+    ///
+    /// Writes the character to the visible page, but the page model keeps what normal writes put      \
+    /// there. Meant for effects like blinking: writing the model's character again ends the effect,    \
+    /// and normal writes meanwhile are not lost. Until then, refreshCell() leaves the cell alone.
+    ///
+    /// \param[in]  address    0 (left-upper corner) to 159 (lower right corner)
+    /// \param[in]  character  Character to show for now
+    //--------------------------------------------------------------
+    void writeOverlay(int address, char character);
+    
+    //--------------------------------------------------------------
+    /// \brief Write a cell again from the page model
+    ///
+    /// Repairs a cell corrupted by noise on the bus, as the display cannot be read back.         \
+    /// The address counter is left where main code expects it. Cells showing a character of       \
+    /// writeOverlay() are skipped, until a normal write or the model's character ends the overlay.
+    ///
+    /// \param[in]  address  0 (left-upper corner) to 159 (lower right corner)
+    /// \return     true if written, false if the page model does not know the cell or it is overlaid
+    //--------------------------------------------------------------
+    bool refreshCell(int address);
+    
     
   private:
-    int _shiftRegisterLatchPin;     // CPU pin connected to 74HC595 pin 12
-    int _shiftRegisterClockPin;     // CPU pin connected to 74HC595 pin 11
-    int _shiftRegisterDataPin;      // CPU pin connected to 74HC595 pin 14
-    int _setCursorPin;              // CPU pin connected to MS6205 pin 16A
-    int _setCharacterPin;           // CPU pin connected to MS6205 pin 16B
-    int _clearPin;                  // CPU pin connected to MS6205 pin 18A
-    int _selectPage0Pin;            // CPU pin connected to MS6205 pin 2A
-    int _selectPage1Pin;            // CPU pin connected to MS6205 pin 2B
-    int _showCursorPin;             // CPU pin connected to MS6205 pin 8A
-    bool _pagingEnabled;
-    bool _cursorEnabled;
-    int _address;
+    uint8_t _shiftRegisterLatchPin;   // CPU pin connected to 74HC595 pin 12
+    uint8_t _shiftRegisterClockPin;   // CPU pin connected to 74HC595 pin 11
+    uint8_t _shiftRegisterDataPin;    // CPU pin connected to 74HC595 pin 14
+    uint8_t _setCursorPin;            // CPU pin connected to MS6205 pin 16A
+    uint8_t _setCharacterPin;         // CPU pin connected to MS6205 pin 16B
+    uint8_t _clearPin;                // CPU pin connected to MS6205 pin 18A
+    uint8_t _selectPage0Pin;          // CPU pin connected to MS6205 pin 2A
+    uint8_t _selectPage1Pin;          // CPU pin connected to MS6205 pin 2B
+    uint8_t _showCursorPin;           // CPU pin connected to MS6205 pin 8A
+    uint8_t _incrementColumnPin;      // CPU pin connected to MS6205 pin 6B
+    uint8_t _address;
+    uint8_t _page;                                                // Currently visible page
+    uint8_t _transport;                                           // TRANSPORT_SHIFT_REGISTER, _PARALLEL_PORT, _PARALLEL_PINS or _DUAL_SHIFT_REGISTER
+#if MS6205_QUEUE
+    uint8_t _queuedCount;                                         // Number of bits set in _queuedCells
+#endif
+    bool _pagingEnabled : 1;
+    bool _cursorEnabled : 1;
+    bool _cursorBlinking : 1;                                     // A timer toggles pin 8A, see blinkCursor()
+    bool _incrementEnabled : 1;
+    bool _concurrent : 1;                                         // Guard every bus access, see beginConcurrent()
+    bool _ready : 1;                                              // begin() called and no deferred clear running
+    bool _begun : 1;                                              // begin() called
+    bool _clearing : 1;                                           // Deferred clear running
+    char _pageContent[MS6205_MODEL_PAGES][NUMBER_OF_CHARACTERS];  // Model of every page's content
+    uint32_t _pageHash[MS6205_MODEL_PAGES];                       // Sum of cellHash() of every page's cells
+#if MS6205_QUEUE
+    char _queuedContent[NUMBER_OF_CHARACTERS];                    // Characters waiting for flush()
+    uint8_t _queuedCells[NUMBER_OF_CHARACTERS / 8];               // Bit set for every cell waiting for flush()
+#endif
+    uint8_t _overlaidCells[NUMBER_OF_CHARACTERS / 8];             // Bit set for every cell of _overlayPage showing a writeOverlay() character
+    uint8_t _overlayPage;                                         // Page _overlaidCells belongs to
+    busCost _busCost;                                             // Cost of bus operations for flush()
+    volatile bool _urgentOnly;                                    // Bulk updates never clear, set from interrupts, not a bit field
+#if MS6205_URGENT
+    volatile uint8_t _urgentCount;                                // Urgent characters waiting, set from interrupts
+    uint8_t _urgentHead;                                          // Slot of the oldest urgent character
+    uint8_t _urgentAddress[URGENT_SLOTS];                         // Cell of each urgent character
+    char _urgentCharacter[URGENT_SLOTS];                          // Urgent characters, oldest at _urgentHead
+    unsigned long _urgentMicros[URGENT_SLOTS];                    // [us] When each urgent character was queued
+    uint8_t _urgentWritten[NUMBER_OF_CHARACTERS / 8];             // Bit set for cells the running bulk update must not overwrite
+    uint8_t _urgentRegion[4];                                     // Column, row, width and height of the urgent region
+    urgentCounters _urgentCounters;
+#endif
+#if MS6205_PARALLEL
+    volatile uint8_t *_port;                                      // Output register for TRANSPORT_PARALLEL_PORT
+    uint8_t _busPins[8];                                          // CPU pins for TRANSPORT_PARALLEL_PINS, lowest bit first
+    void *_bundle;                                                // Dedicated GPIO bundle for TRANSPORT_PARALLEL_PINS, NULL if none
+#endif
+    unsigned long _clearMillis;                                   // [ms] Start of the deferred clear
     
+    void prepareBus(void);
+    void finishClear(void);
+    void writeBus(char data);
+    void writeAddressLines(uint8_t address);
+    void writeDataLines(uint8_t data);
+    void writePositioned(int address, char character);
     void writeToShiftRegister(char data);
+    void writeToDualShiftRegister(uint8_t address, uint8_t data);
     void writeAddress(int address);
+    void storeCharacter(int address, char character);
+    void incrementColumn(void);
+    int writeCell(int position, int address, char character);
+    uint32_t lockBus(bool always = false);
+    void unlockBus(uint32_t state);
+    bool isQueued(int address);
+    void setQueued(int address, bool queued);
+    bool isOverlaid(int address);
+    void setOverlaid(int address, bool overlaid);
+    int writeUrgent(void);
+    int preemptBulk(int position);
+    void startBulk(void);
+    bool urgentWritten(int address);
+    static uint32_t cellHash(int address, char character);
+    static char contentCharacter(const char *content, int length, int address);
+    void writeField(int column, int row, int width, bool negative, uint32_t magnitude, int base, int decimals, int align, char pad);
 };
 
 #include <MS6205_scroll.h>
@@ -0,0 +1,372 @@
+/*
+  MS6205_animation.cpp - Animation playback from flash for a MS6205 vintage soviet character display.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_animation.h"
+
+#define ANIMATION_MAX_CATCH_UP    255   // [frames] Most frames applied by one late update()
+
+//--------------------------------------------------------------
+/// \brief Class constructor
+///
+/// Creates animation player object, without playing anything yet.
+///
+/// \param[in]  pDisplay  Display to play on
+//--------------------------------------------------------------
+animationPlayer::animationPlayer(MS6205 *pDisplay)
+{
+  _pDisplay = pDisplay;
+  _animation = NULL;
+  _frames = 0;
+  _width = 0;
+  _height = 0;
+  _column = 0;
+  _row = 0;
+  _mode = ANIMATION_LOOP;
+  _frame = 0;
+  _direction = 1;
+  _playing = false;
+  _interval = 0;
+  _millis = 0;
+  _background = NULL;
+  _backgroundLength = 0;
+} // animationPlayer()
+
+//--------------------------------------------------------------
+/// \brief Start animation
+///
+/// Shows the first frame immediately.
+///
+/// \param[in]  animation  Animation data in PROGMEM, see DATA FORMAT
+/// \param[in]  column     Display column of the box's left edge
+/// \param[in]  row        Display row of the box's upper edge
+/// \param[in]  mode       ANIMATION_ONCE, ANIMATION_LOOP or ANIMATION_PING_PONG
+//--------------------------------------------------------------
+void animationPlayer::play(const uint8_t *animation, int column, int row, int mode)
+{
+  if (_pDisplay == NULL)
+  {
+    return;
+  }
+
+  if (_animation != NULL)
+  {
+    showBackground();                                           // Remove previous animation
+  }
+
+  _animation = animation;
+  _frames = pgm_read_byte(&animation[0]);
+  _width = pgm_read_byte(&animation[1]);
+  _height = pgm_read_byte(&animation[2]);
+  _column = column;
+  _row = row;
+  _mode = mode;
+  _frame = 0;
+  _direction = 1;
+  _playing = (_frames > 1) || (mode != ANIMATION_ONCE);
+  _millis = millis();
+
+  showFrame();
+  _pDisplay->flush();
+} // play()
+
+//--------------------------------------------------------------
+/// \brief Stop animation
+///
+/// Restores the background under the box.
+//--------------------------------------------------------------
+void animationPlayer::stop(void)
+{
+  if ((_animation != NULL) && (_pDisplay != NULL))
+  {
+    showBackground();
+    _pDisplay->flush();
+  }
+  _animation = NULL;
+  _playing = false;
+} // stop()
+
+//--------------------------------------------------------------
+/// \brief Periodic update
+///
+/// Call in loop() method.
+///
+/// \return     true while the animation is playing
+//--------------------------------------------------------------
+bool animationPlayer::update(void)
+{
+  if ((_playing == false) || (_pDisplay == NULL))
+  {
+    return false;
+  }
+
+  unsigned long interval = frameInterval();
+  unsigned long now = millis();
+  int due = 0;
+
+  // --- Apply every due frame; queued cells changing back and forth cost nothing ---
+  while ((now - _millis >= interval) && (due < ANIMATION_MAX_CATCH_UP) && _playing)
+  {
+    _millis += interval;
+    _playing = step();
+    due++;
+  }
+
+  if (now - _millis >= interval)
+  {
+    _millis = now;                                              // Too far behind, don't try to catch up any more
+  }
+
+  if (due > 0)
+  {
+    _pDisplay->flush();
+  }
+  return _playing;
+} // update()
+
+//--------------------------------------------------------------
+/// \brief Move the box
+///
+/// Restores the background at the old position and shows the current frame at the new one.
+///
+/// \param[in]  column  Display column of the box's left edge
+/// \param[in]  row     Display row of the box's upper edge
+//--------------------------------------------------------------
+void animationPlayer::moveTo(int column, int row)
+{
+  if ((_animation == NULL) || (_pDisplay == NULL))
+  {
+    _column = column;
+    _row = row;
+    return;
+  }
+
+  showBackground();                                             // Cells covered again below are not written twice
+  _column = column;
+  _row = row;
+  showFrame();
+  _pDisplay->flush();
+} // moveTo()
+
+//--------------------------------------------------------------
+/// \brief Set background
+///
+/// Transparent cells show the background's character at their display position.
+///
+/// \param[in]  background  Up to 160 characters, row by row, or NULL for spaces
+//--------------------------------------------------------------
+void animationPlayer::setBackground(const char *background)
+{
+  _background = background;
+  _backgroundLength = (background != NULL) ? strnlen(background, NUMBER_OF_CHARACTERS) : 0;
+} // setBackground()
+
+//--------------------------------------------------------------
+/// \brief Set frame interval
+///
+/// \param[in]  interval  [ms] Time between two frames, 0 for the animation's own interval
+//--------------------------------------------------------------
+void animationPlayer::setInterval(unsigned int interval)
+{
+  _interval = interval;
+} // setInterval()
+
+//--------------------------------------------------------------
+/// \brief Current frame
+///
+/// \return     Frame shown, 0 to n-1
+//--------------------------------------------------------------
+int animationPlayer::frame(void)
+{
+  return _frame;
+} // frame()
+
+//--------------------------------------------------------------
+/// \brief Check if playing
+///
+/// \return     true while the animation is playing
+//--------------------------------------------------------------
+bool animationPlayer::playing(void)
+{
+  return _playing;
+} // playing()
+
+//--------------------------------------------------------------
+/// \brief Time between two frames
+///
+/// \return     [ms] Interval set by setInterval(), or else the animation's own one. At least 1.
+//--------------------------------------------------------------
+unsigned int animationPlayer::frameInterval(void)
+{
+  unsigned int interval = _interval;
+  if (interval == 0)
+  {
+    interval = pgm_read_byte(&_animation[3]) | (pgm_read_byte(&_animation[4]) << 8);
+  }
+  return (interval > 0) ? interval : 1;
+} // frameInterval()
+
+//--------------------------------------------------------------
+/// \brief Queue next frame
+///
+/// \return     false if the animation ended
+//--------------------------------------------------------------
+bool animationPlayer::step(void)
+{
+  if (_frames <= 1)
+  {
+    return _mode != ANIMATION_ONCE;                             // Nothing ever changes
+  }
+
+  if (_mode == ANIMATION_PING_PONG)
+  {
+    if ((_frame + _direction < 0) || (_frame + _direction >= _frames))
+    {
+      _direction = -_direction;                                 // Turn around at both ends
+    }
+    if (_direction > 0)
+    {
+      _frame++;
+      applyDelta(_frame, false);
+    }
+    else
+    {
+      applyDelta(_frame, true);                                 // Delta of the frame shown leads back to the one before
+      _frame--;
+    }
+    return true;
+  }
+
+  if (_frame == _frames - 1)
+  {
+    if (_mode == ANIMATION_ONCE)
+    {
+      return false;                                             // Last frame stays
+    }
+    _frame = 0;                                                 // Delta 0 leads from the last frame to the first
+  }
+  else
+  {
+    _frame++;
+  }
+  applyDelta(_frame, false);
+  return true;
+} // step()
+
+//--------------------------------------------------------------
+/// \brief Queue cells of a delta
+///
+/// \param[in]  delta      0 to n-1
+/// \param[in]  backwards  true to queue the old characters instead of the new ones
+//--------------------------------------------------------------
+void animationPlayer::applyDelta(int delta, bool backwards)
+{
+  const uint8_t *data = deltaData(delta);
+  int count = pgm_read_byte(data++);
+
+  for (int i = 0; i < count; i++, data += 3)
+  {
+    queueCell(pgm_read_byte(&data[0]), pgm_read_byte(&data[backwards ? 1 : 2]));
+  }
+} // applyDelta()
+
+//--------------------------------------------------------------
+/// \brief Queue current frame completely
+///
+/// Replays the first frame and all deltas up to the current frame. Cells changed several times
+/// are queued several times, but written only once.
+//--------------------------------------------------------------
+void animationPlayer::showFrame(void)
+{
+  const uint8_t *data = &_animation[ANIMATION_HEADER_SIZE + 2 * _frames];
+  int count = pgm_read_byte(data++);
+
+  showBackground();                                             // Transparent cells of the first frame
+  for (int i = 0; i < count; i++, data += 2)
+  {
+    queueCell(pgm_read_byte(&data[0]), pgm_read_byte(&data[1]));
+  }
+
+  for (int delta = 1; delta <= _frame; delta++)
+  {
+    applyDelta(delta, false);
+  }
+} // showFrame()
+
+//--------------------------------------------------------------
+/// \brief Queue background for the whole box
+//--------------------------------------------------------------
+void animationPlayer::showBackground(void)
+{
+  for (int row = 0; row < _height; row++)
+  {
+    for (int column = 0; column < _width; column++)
+    {
+      queueCell(column | (row << 4), ANIMATION_TRANSPARENT);
+    }
+  }
+} // showBackground()
+
+//--------------------------------------------------------------
+/// \brief Queue a cell of the box
+///
+/// Cells outside the display are skipped.
+///
+/// \param[in]  cell       (row << 4) | column inside the box
+/// \param[in]  character  Character to show, or ANIMATION_TRANSPARENT for the background
+//--------------------------------------------------------------
+void animationPlayer::queueCell(int cell, char character)
+{
+  int column = _column + (cell & 0x0F);
+  int row = _row + (cell >> 4);
+
+  if ((column < 0) || (column >= NUMBER_OF_COLUMNS) || (row < 0) || (row >= NUMBER_OF_ROWS))
+  {
+    return;                                                     // Clipped
+  }
+
+  if (character == ANIMATION_TRANSPARENT)
+  {
+    int address = column | (row << 4);
+    character = (address < _backgroundLength) ? toUpperCase(_background[address]) : ' ';
+  }
+  _pDisplay->queueCharacter(column, row, character);
+} // queueCell()
+
+//--------------------------------------------------------------
+/// \brief Locate a delta
+///
+/// \param[in]  delta  0 to n-1
+/// \return     Pointer to the delta's cell count in PROGMEM
+//--------------------------------------------------------------
+const uint8_t *animationPlayer::deltaData(int delta)
+{
+  const uint8_t *entry = &_animation[ANIMATION_HEADER_SIZE + 2 * delta];
+  uint16_t offset = pgm_read_byte(&entry[0]) | (pgm_read_byte(&entry[1]) << 8);
+  return &_animation[offset];
+} // deltaData()
@@ -0,0 +1,181 @@
+/*
+  MS6205_animation.h - Animation playback from flash for a MS6205 vintage soviet character display.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+
+  ANIMATIONS
+  ===============
+   An animation is a sequence of frames inside a box of up to 16 x 10 cells. It is stored in flash
+   (PROGMEM) as the first frame plus, for every frame, only the cells that differ from the frame before.
+   Animations are created from text frames with extras/tools/make_animation.py.
+   Cells may be transparent: there, the background given to setBackground() shows through,
+   so an animation can run as a sprite on top of a static screen.
+
+   animationPlayer::update() is non-blocking: call it in loop(). When a frame is due, the changed cells
+   are queued on the display and flushed, so only cells that really change are written.
+   If update() is called late, all due frames are applied at once and only the end result is written.
+
+
+  DATA FORMAT
+  ===============
+   All values are bytes, unless noted.
+
+     Offset  | Content
+    ---------|-----------------------------------------------------------------------
+     0       | Number of frames n, 1 to 255
+     1       | Width of the box [columns], 1 to 16
+     2       | Height of the box [rows], 1 to 10
+     3, 4    | Frame interval [ms], uint16_t little endian
+     5       | n offsets of the deltas, uint16_t little endian, from the start of the data
+     5 + 2n  | First frame: number of cells k, then k x (cell, character)
+     ...     | Delta i, for i = 0..n-1: number of cells m, then m x (cell, old character, new character)
+
+   Delta i changes frame i-1 into frame i; delta 0 changes the last frame into the first one, for looping.
+   Playing a delta backwards (old instead of new character) is used for ping-pong.
+   A cell is (row << 4) | column inside the box, like the display's address byte.
+   Character 0 is transparent.
+*/
+
+#ifndef MS6205_ANIMATION_H
+#define MS6205_ANIMATION_H
+
+#include "Arduino.h"
+#include "MS6205.h"
+
+#define ANIMATION_ONCE              0   // Stop at the last frame, which stays on the display
+#define ANIMATION_LOOP              1   // Restart with the first frame after the last one
+#define ANIMATION_PING_PONG         2   // Play forwards and backwards in turn
+
+#define ANIMATION_TRANSPARENT       0   // Character code of a transparent cell
+
+#define ANIMATION_HEADER_SIZE       5   // [bytes] Header before the delta offsets
+
+class animationPlayer
+{
+  public:
+
+    //--------------------------------------------------------------
+    /// \brief Class constructor
+    ///
+    /// Creates animation player object, without playing anything yet.
+    ///
+    /// \param[in]  pDisplay  Display to play on
+    //--------------------------------------------------------------
+    animationPlayer(MS6205 *pDisplay);
+
+    //--------------------------------------------------------------
+    /// \brief Start animation
+    ///
+    /// Shows the first frame immediately.
+    ///
+    /// \param[in]  animation  Animation data in PROGMEM, see DATA FORMAT
+    /// \param[in]  column     Display column of the box's left edge
+    /// \param[in]  row        Display row of the box's upper edge
+    /// \param[in]  mode       ANIMATION_ONCE, ANIMATION_LOOP or ANIMATION_PING_PONG
+    //--------------------------------------------------------------
+    void play(const uint8_t *animation, int column, int row, int mode = ANIMATION_LOOP);
+
+    //--------------------------------------------------------------
+    /// \brief Stop animation
+    ///
+    /// Restores the background under the box.
+    //--------------------------------------------------------------
+    void stop(void);
+
+    //--------------------------------------------------------------
+    /// \brief Periodic update
+    ///
+    /// Call in loop() method.
+    ///
+    /// \return     true while the animation is playing
+    //--------------------------------------------------------------
+    bool update(void);
+
+    //--------------------------------------------------------------
+    /// \brief Move the box
+    ///
+    /// Restores the background at the old position and shows the current frame at the new one.
+    ///
+    /// \param[in]  column  Display column of the box's left edge
+    /// \param[in]  row     Display row of the box's upper edge
+    //--------------------------------------------------------------
+    void moveTo(int column, int row);
+
+    //--------------------------------------------------------------
+    /// \brief Set background
+    ///
+    /// Transparent cells show the background's character at their display position.
+    ///
+    /// \param[in]  background  Up to 160 characters, row by row, or NULL for spaces
+    //--------------------------------------------------------------
+    void setBackground(const char *background);
+
+    //--------------------------------------------------------------
+    /// \brief Set frame interval
+    ///
+    /// \param[in]  interval  [ms] Time between two frames, 0 for the animation's own interval
+    //--------------------------------------------------------------
+    void setInterval(unsigned int interval);
+
+    //--------------------------------------------------------------
+    /// \brief Current frame
+    ///
+    /// \return     Frame shown, 0 to n-1
+    //--------------------------------------------------------------
+    int frame(void);
+
+    //--------------------------------------------------------------
+    /// \brief Check if playing
+    ///
+    /// \return     true while the animation is playing
+    //--------------------------------------------------------------
+    bool playing(void);
+
+  private:
+    const uint8_t *_animation;    // Animation data in PROGMEM, NULL if none
+    int _frames;                  // Number of frames
+    int _width;                   // [columns] Width of the box
+    int _height;                  // [rows] Height of the box
+    int _column;                  // Display column of the box's left edge
+    int _row;                     // Display row of the box's upper edge
+    int _mode;                    // ANIMATION_ONCE, ANIMATION_LOOP or ANIMATION_PING_PONG
+    int _frame;                   // Frame shown
+    int _direction;               // +1 forwards, -1 backwards
+    bool _playing;
+    unsigned int _interval;       // [ms] Time between two frames, 0 for the animation's own interval
+    unsigned long _millis;        // [ms] Time the frame shown was due
+    const char *_background;      // Background under transparent cells, NULL for spaces
+    int _backgroundLength;        // [characters] Length of background, spaces after it
+    MS6205 * _pDisplay;           // Pointer to display to play on
+
+    unsigned int frameInterval(void);
+    bool step(void);
+    void applyDelta(int delta, bool backwards);
+    void showFrame(void);
+    void showBackground(void);
+    void queueCell(int cell, char character);
+    const uint8_t *deltaData(int delta);
+};
+
+#endif // MS6205_ANIMATION_H
@@ -0,0 +1,353 @@
+/*
+  MS6205_blink.cpp - Blinking cells for a MS6205 vintage soviet character display.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_blink.h"
+
+//--------------------------------------------------------------
+/// \brief Class constructor
+///
+/// Creates blink engine object, without any blinking region yet.
+///
+/// \param[in]  pDisplay  Display to blink on
+//--------------------------------------------------------------
+blinkEngine::blinkEngine(MS6205 *pDisplay)
+{
+  _pDisplay = pDisplay;
+  memset(_regions, 0, sizeof(_regions));
+  memset(_overlaid, 0, sizeof(_overlaid));
+  _overlayPage = 0;
+  _dirty = false;
+  _interval = BLINK_INTERVAL_MS;
+  _budget = BLINK_BUDGET;
+  _millis = millis();
+  _cursorInterval = 0;
+  _cursorMillis = 0;
+  _cursorShown = true;
+} // blinkEngine()
+
+//--------------------------------------------------------------
+/// \brief Start blinking a region
+///
+/// Where regions overlap, the higher region number wins. Regions with the same interval blink in step.
+///
+/// \param[in]  column     Column of the region's left edge
+/// \param[in]  row        Row of the region's upper edge
+/// \param[in]  width      [columns] Width of the region
+/// \param[in]  height     [rows] Height of the region
+/// \param[in]  alternate  Character shown every other phase instead of the content
+/// \param[in]  interval   [ms] Time between two phases, 0 for setInterval()'s
+/// \return     Region number for steady(), -1 if BLINK_REGIONS are blinking already
+//--------------------------------------------------------------
+int blinkEngine::blink(int column, int row, int width, int height, char alternate, unsigned int interval)
+{
+  // --- Clip to the display ---
+  int right = constrain(column + width, 0, NUMBER_OF_COLUMNS);
+  int bottom = constrain(row + height, 0, NUMBER_OF_ROWS);
+  column = constrain(column, 0, NUMBER_OF_COLUMNS);
+  row = constrain(row, 0, NUMBER_OF_ROWS);
+  if ((right <= column) || (bottom <= row))
+  {
+    return -1;
+  }
+
+  for (int i = 0; i < BLINK_REGIONS; i++)
+  {
+    if (_regions[i].width == 0)
+    {
+      _regions[i].column = column;
+      _regions[i].row = row;
+      _regions[i].width = right - column;
+      _regions[i].height = bottom - row;
+      _regions[i].alternate = toUpperCase(alternate) & 0x7F;    // As the display stores it
+      _regions[i].off = false;                                  // Phase is taken up by the next update()
+      _regions[i].interval = interval;
+      _dirty = true;
+      return i;
+    }
+  }
+  return -1;
+} // blink()
+
+//--------------------------------------------------------------
+/// \brief Stop blinking a region
+///
+/// Its cells show their content again within the next update() calls.
+///
+/// \param[in]  region  Region number returned by blink()
+//--------------------------------------------------------------
+void blinkEngine::steady(int region)
+{
+  if ((region >= 0) && (region < BLINK_REGIONS))
+  {
+    _regions[region].width = 0;
+    _dirty = true;
+  }
+} // steady()
+
+//--------------------------------------------------------------
+/// \brief Stop blinking all regions
+//--------------------------------------------------------------
+void blinkEngine::steadyAll(void)
+{
+  for (int i = 0; i < BLINK_REGIONS; i++)
+  {
+    _regions[i].width = 0;
+  }
+  _dirty = true;
+} // steadyAll()
+
+//--------------------------------------------------------------
+/// \brief Set default interval
+///
+/// \param[in]  interval  [ms] Time between two phases of regions blinking without own interval
+//--------------------------------------------------------------
+void blinkEngine::setInterval(unsigned int interval)
+{
+  _interval = (interval > 0) ? interval : 1;
+} // setInterval()
+
+//--------------------------------------------------------------
+/// \brief Set bus budget
+///
+/// \param[in]  cells  Most cells written by one update(), at least 1
+//--------------------------------------------------------------
+void blinkEngine::setBudget(int cells)
+{
+  _budget = (cells > 0) ? cells : 1;
+} // setBudget()
+
+//--------------------------------------------------------------
+/// \brief Blink cursor
+///
+/// Uses a timer if possible, see MS6205::blinkCursor(), otherwise update() toggles the cursor.
+/// Call beginCursor() on the display before use.
+///
+/// \param[in]  interval  [ms] Time between two toggles, 0 to stop blinking and show the cursor
+//--------------------------------------------------------------
+void blinkEngine::blinkCursor(unsigned int interval)
+{
+  if (_pDisplay == NULL)
+  {
+    return;
+  }
+
+  _cursorInterval = 0;
+  if ((interval > 0) && (_pDisplay->blinkCursor(interval) == true))
+  {
+    return;                                                     // Timer does it, nothing to do in update()
+  }
+
+  _pDisplay->showCursor();                                      // Also stops a timer blinking before
+  _cursorShown = true;
+  _cursorInterval = interval;
+  _cursorMillis = millis();
+} // blinkCursor()
+
+//--------------------------------------------------------------
+/// \brief Periodic update
+///
+/// Call in loop() method.
+///
+/// \return     true while cells wait for the next call
+//--------------------------------------------------------------
+bool blinkEngine::update(void)
+{
+  if (_pDisplay == NULL)
+  {
+    return false;
+  }
+
+  unsigned long now = millis();
+
+  // --- Cursor without timer: toggling the line costs no bus time ---
+  if ((_cursorInterval > 0) && (now - _cursorMillis >= _cursorInterval))
+  {
+    _cursorMillis = now;
+    _cursorShown = !_cursorShown;
+    if (_cursorShown == true)
+    {
+      _pDisplay->showCursor();
+    }
+    else
+    {
+      _pDisplay->hideCursor();
+    }
+  }
+
+  // --- Phases follow the time since the common start, so equal intervals stay in step ---
+  for (int i = 0; i < BLINK_REGIONS; i++)
+  {
+    if (_regions[i].width > 0)
+    {
+      unsigned long interval = (_regions[i].interval > 0) ? _regions[i].interval : _interval;
+      bool off = (((now - _millis) / interval) & 1) != 0;
+      if (off != _regions[i].off)
+      {
+        _regions[i].off = off;
+        _dirty = true;
+      }
+    }
+  }
+
+  if (_dirty == false)
+  {
+    return false;
+  }
+
+  // --- Alternate characters are on another page than the visible one: wait until it is back ---
+  int page = _pDisplay->currentPage();
+  if (page != _overlayPage)
+  {
+    bool anyOverlaid = false;
+    for (int i = 0; i < (int)sizeof(_overlaid); i++)
+    {
+      anyOverlaid |= (_overlaid[i] != 0);
+    }
+    if (anyOverlaid == true)
+    {
+      return true;
+    }
+    _overlayPage = page;
+  }
+
+  // --- Write cells not showing their phase, up to the budget ---
+  int written = 0;
+  for (int address = 0; address < NUMBER_OF_CHARACTERS; address++)
+  {
+    int alternate = alternateAt(address);
+    char content = _pDisplay->pageCharacter(page, address);
+    if (content == UNKNOWN_CHARACTER)
+    {
+      content = ' ';
+    }
+
+    if ((alternate < 0) != overlaid(address))
+    {
+      continue;                                                 // Shows its phase already
+    }
+    if ((alternate >= 0) && (alternate == content))
+    {
+      continue;                                                 // Alternate looks like the content, nothing to write
+    }
+
+    if (written == _budget)
+    {
+      return true;                                              // Rest follows in the next call
+    }
+
+    _pDisplay->writeOverlay(address, (alternate >= 0) ? (char)alternate : content);
+    setOverlaid(address, alternate >= 0);
+    written++;
+  }
+
+  _dirty = false;
+  return false;
+} // update()
+
+//--------------------------------------------------------------
+/// \brief Cells to write
+///
+/// \return     Number of cells not showing their current phase yet
+//--------------------------------------------------------------
+int blinkEngine::pendingCells(void)
+{
+  if ((_pDisplay == NULL) || (_dirty == false))
+  {
+    return 0;
+  }
+
+  int page = _pDisplay->currentPage();
+  int pending = 0;
+  for (int address = 0; address < NUMBER_OF_CHARACTERS; address++)
+  {
+    int alternate = alternateAt(address);
+    char content = _pDisplay->pageCharacter(page, address);
+    if (content == UNKNOWN_CHARACTER)
+    {
+      content = ' ';
+    }
+    if (((alternate < 0) == overlaid(address)) && (alternate != content))
+    {
+      pending++;
+    }
+  }
+  return pending;
+} // pendingCells()
+
+//--------------------------------------------------------------
+/// \brief Character a cell shows in its current phase
+///
+/// \param[in]  address  0 (left-upper corner) to 159 (lower right corner)
+/// \return     Alternate character if the cell is in a region's alternate phase, -1 if it shows its content
+//--------------------------------------------------------------
+int blinkEngine::alternateAt(int address)
+{
+  int column = address & 0x0F;
+  int row = address >> 4;
+
+  for (int i = BLINK_REGIONS - 1; i >= 0; i--)
+  {
+    const region &r = _regions[i];
+    if ((r.width > 0) && (column >= r.column) && (column < r.column + r.width) &&
+        (row >= r.row) && (row < r.row + r.height))
+    {
+      return (r.off == true) ? (uint8_t)r.alternate : -1;
+    }
+  }
+  return -1;
+} // alternateAt()
+
+//--------------------------------------------------------------
+/// \brief Check if a cell shows its alternate character
+///
+/// \param[in]  address  0 (left-upper corner) to 159 (lower right corner)
+/// \return     true if writeOverlay() put the alternate character there
+//--------------------------------------------------------------
+bool blinkEngine::overlaid(int address)
+{
+  return (_overlaid[address >> 3] & (1 << (address & 0x07))) != 0;
+} // overlaid()
+
+//--------------------------------------------------------------
+/// \brief Mark a cell's phase
+///
+/// \param[in]  address  0 (left-upper corner) to 159 (lower right corner)
+/// \param[in]  shown    true if the alternate character is shown
+//--------------------------------------------------------------
+void blinkEngine::setOverlaid(int address, bool shown)
+{
+  if (shown == true)
+  {
+    _overlaid[address >> 3] |= (1 << (address & 0x07));
+  }
+  else
+  {
+    _overlaid[address >> 3] &= ~(1 << (address & 0x07));
+  }
+} // setOverlaid()
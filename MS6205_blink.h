@@ -0,0 +1,167 @@
+/*
+  MS6205_blink.h - Blinking cells for a MS6205 vintage soviet character display.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+
+  BLINKING
+  ===============
+   MS6205 has no blink attribute, so blinking is emulated by writing cells: a region given to
+   blink() shows its normal content and an alternate character in turn, e.g. a space to flash
+   a value, or '_' to mark a field being edited.
+
+   blinkEngine::update() is non-blocking: call it in loop(). When a region changes its phase, only
+   its cells are written, and at most setBudget() cells per call, so a large blinking region never
+   stalls loop(). The remaining cells follow in the next calls.
+
+   The alternate character is written with MS6205::writeOverlay(), so the page model keeps the
+   normal content: text written into a blinking region meanwhile is shown again by the next phase,
+   and cells whose alternate equals their content are not written at all.
+   While another page than the blinking one is shown, update() waits.
+
+   The cursor can blink too: blinkCursor() lets a timer toggle the cursor line if the CPU and pin
+   allow it (see MS6205::blinkCursor()), otherwise update() toggles it, which costs no bus time.
+*/
+
+#ifndef MS6205_BLINK_H
+#define MS6205_BLINK_H
+
+#include "Arduino.h"
+#include "MS6205.h"
+
+#define BLINK_REGIONS               8   // Most regions blinking at once
+#define BLINK_INTERVAL_MS         500   // [ms] Default time between two phases
+#define BLINK_BUDGET               16   // [cells] Default most cells written by one update()
+
+class blinkEngine
+{
+  public:
+
+    //--------------------------------------------------------------
+    /// \brief Class constructor
+    ///
+    /// Creates blink engine object, without any blinking region yet.
+    ///
+    /// \param[in]  pDisplay  Display to blink on
+    //--------------------------------------------------------------
+    blinkEngine(MS6205 *pDisplay);
+
+    //--------------------------------------------------------------
+    /// \brief Start blinking a region
+    ///
+    /// Where regions overlap, the higher region number wins. Regions with the same interval blink in step.
+    ///
+    /// \param[in]  column     Column of the region's left edge
+    /// \param[in]  row        Row of the region's upper edge
+    /// \param[in]  width      [columns] Width of the region
+    /// \param[in]  height     [rows] Height of the region
+    /// \param[in]  alternate  Character shown every other phase instead of the content
+    /// \param[in]  interval   [ms] Time between two phases, 0 for setInterval()'s
+    /// \return     Region number for steady(), -1 if BLINK_REGIONS are blinking already
+    //--------------------------------------------------------------
+    int blink(int column, int row, int width = 1, int height = 1, char alternate = ' ', unsigned int interval = 0);
+
+    //--------------------------------------------------------------
+    /// \brief Stop blinking a region
+    ///
+    /// Its cells show their content again within the next update() calls.
+    ///
+    /// \param[in]  region  Region number returned by blink()
+    //--------------------------------------------------------------
+    void steady(int region);
+
+    //--------------------------------------------------------------
+    /// \brief Stop blinking all regions
+    //--------------------------------------------------------------
+    void steadyAll(void);
+
+    //--------------------------------------------------------------
+    /// \brief Set default interval
+    ///
+    /// \param[in]  interval  [ms] Time between two phases of regions blinking without own interval
+    //--------------------------------------------------------------
+    void setInterval(unsigned int interval);
+
+    //--------------------------------------------------------------
+    /// \brief Set bus budget
+    ///
+    /// \param[in]  cells  Most cells written by one update(), at least 1
+    //--------------------------------------------------------------
+    void setBudget(int cells);
+
+    //--------------------------------------------------------------
+    /// \brief Blink cursor
+    ///
+    /// Uses a timer if possible, see MS6205::blinkCursor(), otherwise update() toggles the cursor.
+    /// Call beginCursor() on the display before use.
+    ///
+    /// \param[in]  interval  [ms] Time between two toggles, 0 to stop blinking and show the cursor
+    //--------------------------------------------------------------
+    void blinkCursor(unsigned int interval);
+
+    //--------------------------------------------------------------
+    /// \brief Periodic update
+    ///
+    /// Call in loop() method.
+    ///
+    /// \return     true while cells wait for the next call
+    //--------------------------------------------------------------
+    bool update(void);
+
+    //--------------------------------------------------------------
+    /// \brief Cells to write
+    ///
+    /// \return     Number of cells not showing their current phase yet
+    //--------------------------------------------------------------
+    int pendingCells(void);
+
+  private:
+    struct region
+    {
+      uint8_t column;             // Column of the left edge
+      uint8_t row;                // Row of the upper edge
+      uint8_t width;              // [columns] 0 if the region is not used
+      uint8_t height;             // [rows]
+      char alternate;             // Character shown in the alternate phase
+      bool off;                   // true in the alternate phase
+      unsigned int interval;      // [ms] Time between two phases, 0 for _interval
+    };
+
+    region _regions[BLINK_REGIONS];
+    uint8_t _overlaid[NUMBER_OF_CHARACTERS / 8];   // Bit per cell: alternate character is shown
+    int _overlayPage;             // Page the alternate characters are shown on
+    bool _dirty;                  // Cells may not show their phase yet
+    unsigned int _interval;       // [ms] Default time between two phases
+    int _budget;                  // [cells] Most cells written by one update()
+    unsigned long _millis;        // [ms] Common start of all phases
+    unsigned int _cursorInterval; // [ms] Time between two cursor toggles by update(), 0 if not toggled here
+    unsigned long _cursorMillis;  // [ms] Time of the last cursor toggle
+    bool _cursorShown;
+    MS6205 * _pDisplay;           // Pointer to display to blink on
+
+    int alternateAt(int address);
+    bool overlaid(int address);
+    void setOverlaid(int address, bool shown);
+};
+
+#endif // MS6205_BLINK_H
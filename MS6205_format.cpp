@@ -0,0 +1,231 @@
+/*
+  MS6205_format.cpp - Allocation-free number formatting for a MS6205 vintage soviet character display.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include "Arduino.h"
+#include "MS6205_format.h"
+
+#if NUMBER_DIVISION_FREE
+uint32_t const powersOfTen[10] PROGMEM =         // Subtrahends for division-free decimal conversion
+                {1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL,
+                 10000UL, 1000UL, 100UL, 10UL, 1UL};
+#else
+char const digitPairs[201] PROGMEM =             // Two decimal digits per entry, halves the number of divisions
+                "00010203040506070809"
+                "10111213141516171819"
+                "20212223242526272829"
+                "30313233343536373839"
+                "40414243444546474849"
+                "50515253545556575859"
+                "60616263646566676869"
+                "70717273747576777879"
+                "80818283848586878889"
+                "90919293949596979899";
+#endif
+
+//--------------------------------------------------------------
+/// \brief Convert unsigned number to digits
+///
+/// Writes the digits of a number, most significant digit first.                  \
+/// No terminating zero is appended.
+///
+/// \param[out] digits     Buffer of at least NUMBER_MAX_DIGITS characters
+/// \param[in]  value      Number to convert
+/// \param[in]  base       [2-36] Base of number system
+/// \return     Number of digits written
+//--------------------------------------------------------------
+uint8_t formatUnsigned(char *digits, uint32_t value, uint8_t base)
+{
+  uint8_t count = 0;
+
+  if (base == 10)
+  {
+#if NUMBER_DIVISION_FREE
+    // --- Decimal: count how often each power of ten fits, no division ---
+    uint8_t i = 0;
+    while ((i < 9) && (value < pgm_read_dword(&powersOfTen[i])))   // Skip leading zeros, but keep the last digit
+    {
+      i++;
+    }
+    for (; i < 10; i++)
+    {
+      uint32_t power = pgm_read_dword(&powersOfTen[i]);
+      char digit = '0';
+      while (value >= power)
+      {
+        value -= power;
+        digit++;
+      }
+      digits[count++] = digit;
+    }
+#else
+    // --- Decimal: two digits per division, taken from the pair table ---
+    char buffer[10];
+    char *p = &buffer[sizeof(buffer)];
+    while (value >= 100)
+    {
+      uint32_t quotient = value / 100;
+      uint8_t pair = (uint8_t)(value - quotient * 100) * 2;
+      value = quotient;
+      *--p = pgm_read_byte(&digitPairs[pair + 1]);
+      *--p = pgm_read_byte(&digitPairs[pair]);
+    }
+    if (value >= 10)
+    {
+      *--p = pgm_read_byte(&digitPairs[value * 2 + 1]);
+      *--p = pgm_read_byte(&digitPairs[value * 2]);
+    }
+    else
+    {
+      *--p = '0' + value;
+    }
+    count = &buffer[sizeof(buffer)] - p;
+    memcpy(digits, p, count);
+#endif
+  }
+  else if ((base == 2) || (base == 8) || (base == 16))
+  {
+    // --- Powers of two: take bit groups from the top ---
+    uint8_t bits = (base == 2) ? 1 : ((base == 8) ? 3 : 4);
+    uint8_t mask = base - 1;
+    int8_t shift = ((32 + bits - 1) / bits - 1) * bits;             // Position of the topmost group
+    while ((shift > 0) && ((value >> shift) == 0))
+    {
+      shift -= bits;
+    }
+    for (; shift >= 0; shift -= bits)
+    {
+      uint8_t digit = (value >> shift) & mask;
+      digits[count++] = (digit < 10) ? ('0' + digit) : ('A' + digit - 10);
+    }
+  }
+  else
+  {
+    // --- Any other base: classic division, digits come out backwards ---
+    if ((base < 2) || (base > 36))
+    {
+      base = 10;
+    }
+    char reversed[NUMBER_MAX_DIGITS];
+    do
+    {
+      uint8_t digit = value % base;
+      reversed[count++] = (digit < 10) ? ('0' + digit) : ('A' + digit - 10);
+      value /= base;
+    } while (value > 0);
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+      digits[i] = reversed[count - 1 - i];
+    }
+  }
+
+  return count;
+} // formatUnsigned()
+
+//--------------------------------------------------------------
+/// \brief Format number into a fixed-width field
+///
+/// Writes exactly width characters and a terminating zero to field.
+///
+/// \param[out] field      Buffer of at least width + 1 characters
+/// \param[in]  width      [characters] Width of the field
+/// \param[in]  negative   true to prefix the number with a minus sign
+/// \param[in]  magnitude  Absolute value of the number
+/// \param[in]  base       [2-36] Base of number system
+/// \param[in]  decimals   Number of digits after the decimal point, magnitude is scaled by base^decimals
+/// \param[in]  align      ALIGN_LEFT, ALIGN_RIGHT or ALIGN_CENTER
+/// \param[in]  pad        Character to fill unused positions with. With '0' and ALIGN_RIGHT, the sign is kept leftmost.
+/// \return     false if the number did not fit and the field was filled with NUMBER_OVERFLOW_CHAR
+//--------------------------------------------------------------
+bool formatField(char *field, uint8_t width, bool negative, uint32_t magnitude, uint8_t base, uint8_t decimals, uint8_t align, char pad)
+{
+  char digits[NUMBER_MAX_DIGITS + 1];
+  uint8_t count;
+
+  field[width] = '\0';
+
+  // --- Convert, keep at least one digit in front of the decimal point ---
+  count = formatUnsigned(digits, magnitude, base);
+  if (decimals > NUMBER_MAX_DECIMALS)
+  {
+    decimals = NUMBER_MAX_DECIMALS;
+  }
+  if (count <= decimals)
+  {
+    uint8_t zeros = decimals + 1 - count;
+    memmove(&digits[zeros], digits, count);
+    memset(digits, '0', zeros);
+    count += zeros;
+  }
+
+  // --- Check if it fits ---
+  uint8_t length = count + (negative ? 1 : 0) + (decimals > 0 ? 1 : 0);
+  if (length > width)
+  {
+    memset(field, NUMBER_OVERFLOW_CHAR, width);
+    return false;
+  }
+
+  // --- Place number inside field ---
+  uint8_t before;
+  if (align == ALIGN_LEFT)
+  {
+    before = 0;
+  }
+  else if (align == ALIGN_CENTER)
+  {
+    before = (width - length) / 2;
+  }
+  else
+  {
+    before = width - length;
+  }
+
+  memset(field, pad, width);
+  char *p = &field[before];
+  if (negative)
+  {
+    if ((pad == '0') && (align == ALIGN_RIGHT))                     // Zero padding: "-0042" instead of "00-42"
+    {
+      field[0] = '-';
+    }
+    else
+    {
+      *p = '-';
+    }
+    p++;
+  }
+  for (uint8_t i = 0; i < count; i++)
+  {
+    if ((decimals > 0) && (i == count - decimals))
+    {
+      *p++ = '.';
+    }
+    *p++ = digits[i];
+  }
+
+  return true;
+} // formatField()
@@ -0,0 +1,93 @@
+/*
+  MS6205_format.h - Allocation-free number formatting for a MS6205 vintage soviet character display.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+
+  NUMBER FIELDS
+  ===============
+   Numbers are formatted into a fixed-width field on the stack, never into a String.
+
+   On CPUs without a hardware divider (AVR, ESP8266) decimal digits are produced by
+   subtracting powers of ten from a table, so no division is needed at all.
+   Everywhere else two digits are produced per division by 100 and taken from a
+   digit pair table, because the compiler turns that division into a multiplication.
+   Define NUMBER_DIVISION_FREE to 0 or 1 to choose the method yourself.
+
+   Bases 2, 8 and 16 are produced by shifting, all other bases fall back to division.
+
+   If a number does not fit into its field, the whole field is filled with '#'.
+*/
+
+#ifndef MS6205_FORMAT_H
+#define MS6205_FORMAT_H
+
+#include "Arduino.h"
+
+#define ALIGN_LEFT                  0   // Number is written to the left of its field, padded on the right
+#define ALIGN_RIGHT                 1   // Number is written to the right of its field, padded on the left
+#define ALIGN_CENTER                2   // Number is centered in its field, padded on both sides
+
+#define NUMBER_MAX_DIGITS          32   // Maximum number of digits of a 32 bit number (base 2)
+#define NUMBER_MAX_DECIMALS         7   // Maximum number of decimals of floating point numbers
+#define NUMBER_OVERFLOW_CHAR      '#'   // Character filling a field that is too small for its number
+
+#ifndef NUMBER_DIVISION_FREE
+  #if defined(__AVR__) || defined(ESP8266)
+    #define NUMBER_DIVISION_FREE    1   // Subtract powers of ten, no divider in hardware
+  #else
+    #define NUMBER_DIVISION_FREE    0   // Divide by 100 and use digit pairs
+  #endif
+#endif
+
+//--------------------------------------------------------------
+/// \brief Convert unsigned number to digits
+///
+/// Writes the digits of a number, most significant digit first.                  \
+/// No terminating zero is appended.
+///
+/// \param[out] digits     Buffer of at least NUMBER_MAX_DIGITS characters
+/// \param[in]  value      Number to convert
+/// \param[in]  base       [2-36] Base of number system
+/// \return     Number of digits written
+//--------------------------------------------------------------
+uint8_t formatUnsigned(char *digits, uint32_t value, uint8_t base);
+
+//--------------------------------------------------------------
+/// \brief Format number into a fixed-width field
+///
+/// Writes exactly width characters and a terminating zero to field.
+///
+/// \param[out] field      Buffer of at least width + 1 characters
+/// \param[in]  width      [characters] Width of the field
+/// \param[in]  negative   true to prefix the number with a minus sign
+/// \param[in]  magnitude  Absolute value of the number
+/// \param[in]  base       [2-36] Base of number system
+/// \param[in]  decimals   Number of digits after the decimal point, magnitude is scaled by base^decimals
+/// \param[in]  align      ALIGN_LEFT, ALIGN_RIGHT or ALIGN_CENTER
+/// \param[in]  pad        Character to fill unused positions with. With '0' and ALIGN_RIGHT, the sign is kept leftmost.
+/// \return     false if the number did not fit and the field was filled with NUMBER_OVERFLOW_CHAR
+//--------------------------------------------------------------
+bool formatField(char *field, uint8_t width, bool negative, uint32_t magnitude, uint8_t base, uint8_t decimals, uint8_t align, char pad);
+
+#endif // MS6205_FORMAT_H
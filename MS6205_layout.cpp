@@ -0,0 +1,432 @@
+/*
+  MS6205_layout.cpp - Text layout with word wrap for a MS6205 vintage soviet character display.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_layout.h"
+
+#define FNV_OFFSET_BASIS  0x811C9DC5UL  // 32-bit FNV-1a hash of the lines' text
+#define FNV_PRIME         0x01000193UL
+
+//--------------------------------------------------------------
+/// \brief Class constructor
+///
+/// Creates layout for the whole screen, left aligned, with pages, without text.
+///
+/// \param[in]  pDisplay  Display to write to
+//--------------------------------------------------------------
+textLayout::textLayout(MS6205 *pDisplay)
+{
+  _pDisplay = pDisplay;
+  _text = NULL;
+  _count = 0;
+  _end = 0;
+  _length = -1;
+  resetCounters();
+  setBox(0, 0, NUMBER_OF_COLUMNS, NUMBER_OF_ROWS);
+} // textLayout()
+
+//--------------------------------------------------------------
+/// \brief Set box
+///
+/// \param[in]  column  Display column of upper left corner
+/// \param[in]  row     Display row of upper left corner
+/// \param[in]  width   [columns] Width of box
+/// \param[in]  height  [rows] Height of box
+/// \param[in]  align   ALIGN_LEFT, ALIGN_RIGHT or ALIGN_CENTER
+/// \param[in]  mode    LAYOUT_PAGES, LAYOUT_ELLIPSIS or LAYOUT_LINES
+//--------------------------------------------------------------
+void textLayout::setBox(int column, int row, int width, int height, int align, int mode)
+{
+  _column = constrain(column, 0, NUMBER_OF_COLUMNS - 1);
+  _row = constrain(row, 0, NUMBER_OF_ROWS - 1);
+  _width = constrain(width, 1, NUMBER_OF_COLUMNS - _column);
+  _height = constrain(height, 1, NUMBER_OF_ROWS - _row);
+  _align = align;
+  _mode = mode;
+
+  _count = 0;                                                   // Cached line breaks are for the old box
+  _length = -1;
+  if (_text != NULL)
+  {
+    _counters.layouts++;
+    _counters.lines += layOut(0);
+  }
+} // setBox()
+
+//--------------------------------------------------------------
+/// \brief Set text and lay it out
+///
+/// Reuses the cached line breaks as far as the text did not change.
+///
+/// \param[in]  text  Zero-terminated text, '\n' starts a new line. Must stay valid while set,     \
+///                   call setText() again after changing it.
+///
+/// \return     Number of lines laid out, 0 on a cache hit
+//--------------------------------------------------------------
+int textLayout::setText(const char *text)
+{
+  if (text == NULL)
+  {
+    text = "";
+  }
+
+  int first = firstChange(text);
+  _text = text;
+  if (first < 0)
+  {
+    _counters.hits++;
+    return 0;
+  }
+
+  if ((first > 0) && (_mode != LAYOUT_LINES))
+  {
+    first--;                                                    // The changed line's first word may fit the line before now
+  }
+  int laidOut = layOut(first);
+  _counters.layouts++;
+  _counters.lines += laidOut;
+  return laidOut;
+} // setText()
+
+//--------------------------------------------------------------
+/// \brief Write a page of the text into the box
+///
+/// Fills the rest of the box with spaces. Writes only cells which change.
+///
+/// \param[in]  page  Page of the text, 0 for the first
+//--------------------------------------------------------------
+void textLayout::render(int page)
+{
+  if (_pDisplay == NULL)
+  {
+    return;
+  }
+
+  for (int row = 0; row < _height; row++)
+  {
+    int index = page * _height + row;
+    const char *text = NULL;
+    int length = 0;
+    int ellipsis = 0;
+    if ((index >= 0) && (index < _count))
+    {
+      text = &_text[_lines[index].start];
+      length = _lines[index].length;
+      ellipsis = _lines[index].ellipsis ? LAYOUT_ELLIPSIS_LENGTH : 0;
+    }
+
+    int offset = 0;                                             // ALIGN_LEFT
+    if (_align == ALIGN_RIGHT)
+    {
+      offset = _width - length - ellipsis;
+    }
+    else if (_align == ALIGN_CENTER)
+    {
+      offset = (_width - length - ellipsis) / 2;
+    }
+
+    for (int column = 0; column < _width; column++)
+    {
+      int i = column - offset;
+      char character = ' ';
+      if ((i >= 0) && (i < length))
+      {
+        character = toUpperCase(text[i]);                       // MS6205 only supports uppercase latin letters
+      }
+      else if ((i >= length) && (i < length + ellipsis))
+      {
+        character = LAYOUT_ELLIPSIS_TEXT[i - length];
+      }
+      _pDisplay->queueCharacter(_column + column, _row + row, character);   // Dropped if unchanged
+    }
+  }
+  _pDisplay->flush();
+} // render()
+
+//--------------------------------------------------------------
+/// \brief Number of lines
+///
+/// \return     Lines of the text, at most LAYOUT_MAX_LINES
+//--------------------------------------------------------------
+int textLayout::lines(void)
+{
+  return _count;
+} // lines()
+
+//--------------------------------------------------------------
+/// \brief Number of pages
+///
+/// \return     Pages of the text, at least 1
+//--------------------------------------------------------------
+int textLayout::pages(void)
+{
+  return (_count > _height) ? (_count + _height - 1) / _height : 1;
+} // pages()
+
+//--------------------------------------------------------------
+/// \brief Line of the text
+///
+/// \param[in]  line    Line number, 0 for the first
+/// \param[out] length  [characters] Length of line, without spaces at a wrap
+///
+/// \return     Start of line in the text, NULL if there is no such line
+//--------------------------------------------------------------
+const char *textLayout::line(int line, int *length)
+{
+  if ((line < 0) || (line >= _count))
+  {
+    return NULL;
+  }
+  if (length != NULL)
+  {
+    *length = _lines[line].length;
+  }
+  return &_text[_lines[line].start];
+} // line()
+
+//--------------------------------------------------------------
+/// \brief Get counters
+///
+/// \return     Counters since construction or resetCounters()
+//--------------------------------------------------------------
+const layoutCounters &textLayout::counters(void)
+{
+  return _counters;
+} // counters()
+
+//--------------------------------------------------------------
+/// \brief Reset counters
+//--------------------------------------------------------------
+void textLayout::resetCounters(void)
+{
+  memset(&_counters, 0, sizeof(_counters));
+} // resetCounters()
+
+//--------------------------------------------------------------
+/// \brief Find first line the text changed in
+///
+/// Compares the text with the hashes of the cached lines.
+///
+/// \param[in]  text  New text
+///
+/// \return     First changed line, -1 if the cached layout fits the text
+//--------------------------------------------------------------
+int textLayout::firstChange(const char *text)
+{
+  if (_length < 0)
+  {
+    return 0;                                                   // Nothing cached
+  }
+
+  for (int i = 0; i < _count; i++)
+  {
+    int end = (i + 1 < _count) ? _lines[i + 1].start : _end;
+    if (segmentHash(text, _lines[i].start, end) != _lines[i].hash)
+    {
+      return i;
+    }
+  }
+
+  if ((int)strlen(text) != _length)
+  {
+    return (_count > 0) ? _count - 1 : 0;                       // Text continues or ends differently after the last line
+  }
+  return -1;
+} // firstChange()
+
+//--------------------------------------------------------------
+/// \brief Lay out lines
+///
+/// \param[in]  first  First line to lay out, the lines before are kept
+///
+/// \return     Number of lines laid out
+//--------------------------------------------------------------
+int textLayout::layOut(int first)
+{
+  first = constrain(first, 0, _count);
+  int start = (first < _count) ? _lines[first].start : ((first > 0) ? _end : 0);
+  _length = strlen(_text);
+
+  int limit = (_mode == LAYOUT_ELLIPSIS) ? _height : LAYOUT_MAX_LINES;
+  limit = (limit < LAYOUT_MAX_LINES) ? limit : LAYOUT_MAX_LINES;
+  _count = first;
+  while ((_count < limit) && (start < _length))
+  {
+    start = breakLine(start, &_lines[_count]);
+    _count++;
+  }
+  _end = start;
+
+  // --- Text left over: mark the end of the box ---
+  if ((_mode == LAYOUT_ELLIPSIS) && (_end < _length) && (_count > 0))
+  {
+    layoutLine &last = _lines[_count - 1];
+    if (last.length + LAYOUT_ELLIPSIS_LENGTH > _width)
+    {
+      cut(&last);
+    }
+    last.ellipsis = 1;
+  }
+
+  for (int i = first; i < _count; i++)
+  {
+    int end = (i + 1 < _count) ? _lines[i + 1].start : _end;
+    _lines[i].hash = segmentHash(_text, _lines[i].start, end);
+  }
+  return _count - first;
+} // layOut()
+
+//--------------------------------------------------------------
+/// \brief Break one line off the text
+///
+/// \param[in]  start  Index of the line's first character
+/// \param[out] line   Line found
+///
+/// \return     Index of the next line's first character
+//--------------------------------------------------------------
+int textLayout::breakLine(int start, layoutLine *line)
+{
+  const char *text = _text;
+  int i = start;
+  int lastSpace = -1;                                           // Last space after a word, not in an indent
+  bool word = false;
+  while ((text[i] != '\0') && (text[i] != '\n') && (i - start < _width))
+  {
+    if (text[i] != ' ')
+    {
+      word = true;
+    }
+    else if (word)
+    {
+      lastSpace = i;
+    }
+    i++;
+  }
+
+  int length;
+  int next;
+  line->start = start;
+  line->ellipsis = 0;
+  if ((text[i] == '\0') || (text[i] == '\n'))                   // Line fits
+  {
+    length = i - start;
+    next = (text[i] == '\n') ? i + 1 : i;
+  }
+  else if (_mode == LAYOUT_LINES)                               // No wrap: cut, continue after the line's end
+  {
+    line->length = i - start;
+    cut(line);
+    length = line->length;
+    line->ellipsis = 1;
+    while ((text[i] != '\0') && (text[i] != '\n'))
+    {
+      i++;
+    }
+    next = (text[i] == '\n') ? i + 1 : i;
+  }
+  else
+  {
+    if (text[i] == ' ')                                         // Wrap right after a word
+    {
+      length = i - start;
+      next = i;
+    }
+    else if (lastSpace > start)                                 // Wrap at the last space
+    {
+      length = lastSpace - start;
+      next = lastSpace + 1;
+    }
+    else                                                        // Word longer than the box: break it
+    {
+      length = i - start;
+      next = i;
+    }
+
+    while (text[next] == ' ')                                   // Drop spaces at the wrap
+    {
+      next++;
+    }
+  }
+
+  while ((length > 0) && (text[start + length - 1] == ' '))
+  {
+    length--;
+  }
+  line->length = length;
+  return next;
+} // breakLine()
+
+//--------------------------------------------------------------
+/// \brief Shorten line to make room for the ellipsis
+///
+/// Cuts at the last space that leaves room, or in the word if there is none.
+///
+/// \param[in,out] line  Line to shorten
+//--------------------------------------------------------------
+void textLayout::cut(layoutLine *line)
+{
+  const char *text = &_text[line->start];
+  int length = (_width > LAYOUT_ELLIPSIS_LENGTH) ? _width - LAYOUT_ELLIPSIS_LENGTH : 0;
+  int space = length;
+  while ((space > 0) && (text[space] != ' '))
+  {
+    space--;
+  }
+  if (space > 0)
+  {
+    length = space;
+  }
+  while ((length > 0) && (text[length - 1] == ' '))
+  {
+    length--;
+  }
+  line->length = length;
+} // cut()
+
+//--------------------------------------------------------------
+/// \brief Hash of a part of a text
+///
+/// \param[in]  text   Text
+/// \param[in]  start  Index of first character
+/// \param[in]  end    Index after last character
+///
+/// \return     FNV-1a hash of the characters, including a terminating zero met before end
+//--------------------------------------------------------------
+uint32_t textLayout::segmentHash(const char *text, int start, int end)
+{
+  uint32_t hash = FNV_OFFSET_BASIS;
+  for (int i = start; i < end; i++)
+  {
+    hash = (hash ^ (uint8_t)text[i]) * FNV_PRIME;
+    if (text[i] == '\0')
+    {
+      break;                                                    // Text is shorter now
+    }
+  }
+  return hash;
+} // segmentHash()
@@ -0,0 +1,181 @@
+/*
+  MS6205_layout.h - Text layout with word wrap for a MS6205 vintage soviet character display.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+
+  LAYOUT
+  ===============
+   textLayout breaks a text into the lines of a box, word by word, and writes them aligned:
+
+     LAYOUT_PAGES          Words wrap at the box width, lines beyond its height go to further pages
+     LAYOUT_ELLIPSIS       Words wrap, text that does not fit the box is cut and ends in "..."
+     LAYOUT_LINES          No wrap, every line of the text ('\n') is one line, cut with "..." if too long
+
+   Words longer than the box width are broken. Spaces at a wrap are dropped. Text is cut for "..."
+   after the last word that leaves room for it.
+
+   The line breaks are cached together with a hash of each line's text. setText() checks the new
+   text line by line against the cached hashes: if nothing changed, the layout is reused as it is,
+   otherwise it is laid out again from the line before the first changed one (a shorter word may
+   move back up). render() writes through the queue, so only cells that change are written.
+*/
+
+#ifndef MS6205_LAYOUT_H
+#define MS6205_LAYOUT_H
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_format.h"
+
+#define LAYOUT_PAGES                0   // Word wrap, further pages
+#define LAYOUT_ELLIPSIS             1   // Word wrap, cut at the end of the box with "..."
+#define LAYOUT_LINES                2   // No wrap, every line cut with "..."
+
+#ifndef LAYOUT_MAX_LINES
+  #define LAYOUT_MAX_LINES         30   // Lines cached, further lines are dropped. 8 bytes RAM each
+#endif
+
+#define LAYOUT_ELLIPSIS_TEXT    "..."   // Marks cut text
+#define LAYOUT_ELLIPSIS_LENGTH      3   // [characters] Length of LAYOUT_ELLIPSIS_TEXT
+
+struct layoutCounters
+{
+  unsigned long layouts;          // setText() calls which had to lay out lines
+  unsigned long hits;             // setText() calls which reused the cached layout completely
+  unsigned long lines;            // Lines laid out
+};
+
+class textLayout
+{
+  public:
+
+    //--------------------------------------------------------------
+    /// \brief Class constructor
+    ///
+    /// Creates layout for the whole screen, left aligned, with pages, without text.
+    ///
+    /// \param[in]  pDisplay  Display to write to
+    //--------------------------------------------------------------
+    textLayout(MS6205 *pDisplay);
+
+    //--------------------------------------------------------------
+    /// \brief Set box
+    ///
+    /// \param[in]  column  Display column of upper left corner
+    /// \param[in]  row     Display row of upper left corner
+    /// \param[in]  width   [columns] Width of box
+    /// \param[in]  height  [rows] Height of box
+    /// \param[in]  align   ALIGN_LEFT, ALIGN_RIGHT or ALIGN_CENTER
+    /// \param[in]  mode    LAYOUT_PAGES, LAYOUT_ELLIPSIS or LAYOUT_LINES
+    //--------------------------------------------------------------
+    void setBox(int column, int row, int width, int height, int align = ALIGN_LEFT, int mode = LAYOUT_PAGES);
+
+    //--------------------------------------------------------------
+    /// \brief Set text and lay it out
+    ///
+    /// Reuses the cached line breaks as far as the text did not change.
+    ///
+    /// \param[in]  text  Zero-terminated text, '\n' starts a new line. Must stay valid while set,   \
+    ///                   call setText() again after changing it.
+    ///
+    /// \return     Number of lines laid out, 0 on a cache hit
+    //--------------------------------------------------------------
+    int setText(const char *text);
+
+    //--------------------------------------------------------------
+    /// \brief Write a page of the text into the box
+    ///
+    /// Fills the rest of the box with spaces. Writes only cells which change.
+    ///
+    /// \param[in]  page  Page of the text, 0 for the first
+    //--------------------------------------------------------------
+    void render(int page = 0);
+
+    //--------------------------------------------------------------
+    /// \brief Number of lines
+    ///
+    /// \return     Lines of the text, at most LAYOUT_MAX_LINES
+    //--------------------------------------------------------------
+    int lines(void);
+
+    //--------------------------------------------------------------
+    /// \brief Number of pages
+    ///
+    /// \return     Pages of the text, at least 1
+    //--------------------------------------------------------------
+    int pages(void);
+
+    //--------------------------------------------------------------
+    /// \brief Line of the text
+    ///
+    /// \param[in]  line    Line number, 0 for the first
+    /// \param[out] length  [characters] Length of line, without spaces at a wrap
+    ///
+    /// \return     Start of line in the text, NULL if there is no such line
+    //--------------------------------------------------------------
+    const char *line(int line, int *length);
+
+    //--------------------------------------------------------------
+    /// \brief Get counters
+    ///
+    /// \return     Counters since construction or resetCounters()
+    //--------------------------------------------------------------
+    const layoutCounters &counters(void);
+
+    //--------------------------------------------------------------
+    /// \brief Reset counters
+    //--------------------------------------------------------------
+    void resetCounters(void);
+
+  private:
+    struct layoutLine
+    {
+      uint16_t start;             // Index of the line's first character in the text
+      uint8_t length;             // [characters] Characters shown, without spaces at a wrap
+      uint8_t ellipsis;           // 1 if "..." follows the characters
+      uint32_t hash;              // Hash of the text from start up to the next line's start
+    };
+
+    layoutLine _lines[LAYOUT_MAX_LINES];   // Cached line breaks
+    int _count;                   // Number of cached lines
+    int _end;                     // Index after the last laid out character, the text's length if complete
+    int _length;                  // [characters] Length of the laid out text, -1 if none
+    const char *_text;            // Text, NULL if none
+    int8_t _column;               // Display column of upper left corner
+    int8_t _row;                  // Display row of upper left corner
+    int8_t _width;                // [columns] Width of box
+    int8_t _height;               // [rows] Height of box
+    int8_t _align;                // ALIGN_LEFT, ALIGN_RIGHT or ALIGN_CENTER
+    int8_t _mode;                 // LAYOUT_PAGES, LAYOUT_ELLIPSIS or LAYOUT_LINES
+    layoutCounters _counters;     // Counters
+    MS6205 * _pDisplay;           // Pointer to display to write to
+
+    int firstChange(const char *text);
+    int layOut(int first);
+    int breakLine(int start, layoutLine *line);
+    void cut(layoutLine *line);
+    static uint32_t segmentHash(const char *text, int start, int end);
+};
+
+#endif // MS6205_LAYOUT_H
@@ -0,0 +1,120 @@
+/*
+  MS6205_planner.cpp - Bus cost model and write ordering for a MS6205 vintage soviet character display.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_planner.h"
+
+busCost const bitBangBusCost = {18, 18, 2, false};        // 8 bits through shiftOut() take ~16 us, a strobe ~2 us
+busCost const parallelBusCost = {2, 2, 2, false};         // A port store is next to nothing, the strobe remains
+busCost const parallelPinsBusCost = {10, 10, 2, false};   // 8 single digitalWrite() take ~8 us
+busCost const dualShiftBusCost = {17, 18, 2, false};      // Moves are positioned writes: 8 more bits and a strobe, the latch is shared
+
+//--------------------------------------------------------------
+/// \brief Choose cheapest way to move the address counter
+///
+/// \param[in]  from    Current position of the address counter, or UNKNOWN_POSITION
+/// \param[in]  to      Address of the next cell to write
+/// \param[in]  cost    Cost of bus operations
+/// \param[in]  known   Page content, UNKNOWN_CHARACTER for cells that must not be rewritten
+/// \return     MOVE_NONE, MOVE_ADDRESS, MOVE_INCREMENT or MOVE_REWRITE
+//--------------------------------------------------------------
+uint8_t planMove(int from, int to, const busCost &cost, const char *known)
+{
+  if (from == to)
+  {
+    return MOVE_NONE;
+  }
+
+  if (  (from == UNKNOWN_POSITION)                              // Position unknown..
+      ||(to < from)                                             // ..or backwards..
+      ||((from >> 4) != (to >> 4)))                             // ..or to another row: only an absolute address helps
+  {
+    return MOVE_ADDRESS;
+  }
+
+  // --- Same row, forward: compare all possible moves ---
+  uint8_t best = MOVE_ADDRESS;
+  uint32_t bestCost = moveCost(MOVE_ADDRESS, from, to, cost);
+
+  if (cost.increment > 0)
+  {
+    uint32_t incrementCost = moveCost(MOVE_INCREMENT, from, to, cost);
+    if (incrementCost < bestCost)
+    {
+      best = MOVE_INCREMENT;
+      bestCost = incrementCost;
+    }
+  }
+
+  if (cost.autoIncrement)
+  {
+    bool allKnown = true;
+    for (int address = from; address < to; address++)
+    {
+      if (known[address] == UNKNOWN_CHARACTER)
+      {
+        allKnown = false;
+        break;
+      }
+    }
+
+    uint32_t rewriteCost = moveCost(MOVE_REWRITE, from, to, cost);
+    if (allKnown && (rewriteCost < bestCost))
+    {
+      best = MOVE_REWRITE;
+    }
+  }
+
+  return best;
+} // planMove()
+
+//--------------------------------------------------------------
+/// \brief Cost of a move chosen by planMove()
+///
+/// \param[in]  move  Move returned by planMove()
+/// \param[in]  from  Current position of the address counter
+/// \param[in]  to    Address of the next cell to write
+/// \param[in]  cost  Cost of bus operations
+/// \return     [cost] Cost of the move
+//--------------------------------------------------------------
+uint32_t moveCost(uint8_t move, int from, int to, const busCost &cost)
+{
+  switch (move)
+  {
+    case MOVE_ADDRESS:
+      return cost.address;
+
+    case MOVE_INCREMENT:
+      return (uint32_t)(to - from) * cost.increment;
+
+    case MOVE_REWRITE:
+      return (uint32_t)(to - from) * cost.data;
+
+    default:
+      return 0;
+  }
+} // moveCost()
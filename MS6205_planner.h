@@ -0,0 +1,90 @@
+/*
+  MS6205_planner.h - Bus cost model and write ordering for a MS6205 vintage soviet character display.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+
+  WRITE ORDERING
+  ================
+   Queued characters are flushed in address order. Before each character, the display's
+   address counter has to be moved from where it is to the next queued cell. There are
+   three ways to do that, and the cheapest one is picked per move:
+
+    - MOVE_ADDRESS    Shift out the absolute address and strobe /Set address (16A).
+    - MOVE_INCREMENT  Pulse "increment column address" (6B) once per cell. Only inside a row,
+                      and only if line 6B is connected to the CPU.
+    - MOVE_REWRITE    Write the unchanged cells in between once more. Only pays off with
+                      displays that advance their address after each character, and only
+                      across cells whose content is known.
+
+   Which one is cheapest depends on the transport, so the costs come from a busCost.
+*/
+
+#ifndef MS6205_PLANNER_H
+#define MS6205_PLANNER_H
+
+#include "Arduino.h"
+
+#define MOVE_NONE                   0   // Address counter already points to the cell
+#define MOVE_ADDRESS                1   // Set absolute address
+#define MOVE_INCREMENT              2   // Pulse "increment column address"
+#define MOVE_REWRITE                3   // Write the known cells in between again
+
+#define UNKNOWN_POSITION           -1   // Address counter position is not known
+
+struct busCost
+{
+  uint16_t address;                     // [cost] Put address on bus and strobe /Set address
+  uint16_t data;                        // [cost] Put character on bus and strobe /Set character
+  uint16_t increment;                   // [cost] One pulse on "increment column address" 6B, 0 if not connected
+  bool autoIncrement;                   // Display advances its address after each character
+};
+
+extern busCost const bitBangBusCost;        // 74HC595 through shiftOut() and digitalWrite(), in [us] on an ESP8266
+extern busCost const parallelBusCost;       // Whole byte by one port store, in [us]
+extern busCost const parallelPinsBusCost;   // 8 pins through digitalWrite(), in [us] on an ESP8266
+extern busCost const dualShiftBusCost;      // Two chained 74HC595 through shiftOut(), in [us] on an ESP8266
+
+//--------------------------------------------------------------
+/// \brief Choose cheapest way to move the address counter
+///
+/// \param[in]  from    Current position of the address counter, or UNKNOWN_POSITION
+/// \param[in]  to      Address of the next cell to write
+/// \param[in]  cost    Cost of bus operations
+/// \param[in]  known   Page content, UNKNOWN_CHARACTER for cells that must not be rewritten
+/// \return     MOVE_NONE, MOVE_ADDRESS, MOVE_INCREMENT or MOVE_REWRITE
+//--------------------------------------------------------------
+uint8_t planMove(int from, int to, const busCost &cost, const char *known);
+
+//--------------------------------------------------------------
+/// \brief Cost of a move chosen by planMove()
+///
+/// \param[in]  move  Move returned by planMove()
+/// \param[in]  from  Current position of the address counter
+/// \param[in]  to    Address of the next cell to write
+/// \param[in]  cost  Cost of bus operations
+/// \return     [cost] Cost of the move
+//--------------------------------------------------------------
+uint32_t moveCost(uint8_t move, int from, int to, const busCost &cost);
+
+#endif // MS6205_PLANNER_H
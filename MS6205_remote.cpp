@@ -0,0 +1,425 @@
+/*
+  MS6205_remote.cpp - Binary remote control protocol for a MS6205 vintage soviet character display.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_remote.h"
+
+#if defined(__AVR__)
+  #include <util/crc16.h>
+#endif
+
+#define STATE_SYNC                  0   // Parser states: waiting for REMOTE_SYNC..
+#define STATE_TYPE                  1
+#define STATE_LENGTH                2
+#define STATE_SEQUENCE              3
+#define STATE_PAYLOAD               4
+#define STATE_CRC_HIGH              5
+#define STATE_CRC_LOW               6
+
+#define RUN_ADDRESS                 0   // Fields of a cell run in REMOTE_CELL_RUNS
+#define RUN_COUNT                   1
+#define RUN_CHARACTERS              2
+
+#define REMOTE_CRC_INIT        0xFFFF   // Initial value of CRC-16/CCITT-FALSE
+#define REMOTE_CRC_POLYNOMIAL  0x1021
+
+//--------------------------------------------------------------
+/// \brief Class constructor
+///
+/// Creates remote protocol handler. The remote display owns the display's write queue:\
+/// a damaged frame drops all queued characters, so other code must not queue characters\
+/// on it, but may write directly.
+///
+/// \param[in]  pDisplay  Display to drive
+/// \param[in]  pStream   Stream to receive frames from and send acknowledges to
+/// \param[in]  window    [bytes] Receive window reported to the host, at most the stream's receive buffer
+//--------------------------------------------------------------
+remoteDisplay::remoteDisplay(MS6205 *pDisplay, Stream *pStream, uint16_t window)
+{
+  _pDisplay = pDisplay;
+  _pStream = pStream;
+  _window = window;
+  _state = STATE_SYNC;
+  _type = 0;
+  _length = 0;
+  _sequence = 0;
+  _received = 0;
+  _crc = REMOTE_CRC_INIT;
+  _receivedCrc = 0;
+  _runAddress = 0;
+  _runLeft = 0;
+  _runState = RUN_ADDRESS;
+  _page = 0;
+  _valid = false;
+  _millis = 0;
+  _frames = 0;
+  _errors = 0;
+} // remoteDisplay()
+
+//--------------------------------------------------------------
+/// \brief Periodic update
+///
+/// Call in loop() method. Handles all received bytes. A frame is dropped only if nothing\
+/// arrived for REMOTE_TIMEOUT_MS, so a late loop() does not drop bytes waiting in the stream.
+///
+/// \return     Number of frames applied
+//--------------------------------------------------------------
+int remoteDisplay::update(void)
+{
+  if ((_pDisplay == NULL) || (_pStream == NULL))
+  {
+    return 0;
+  }
+
+  int applied = 0;
+  bool arrived = false;
+  while (_pStream->available() > 0)
+  {
+    int data = _pStream->read();
+    if (data < 0)
+    {
+      break;
+    }
+    arrived = true;
+    _millis = millis();
+    if (receive((uint8_t)data))
+    {
+      applied++;
+    }
+  }
+
+  // --- Drop a frame that stopped arriving, the host will resend it ---
+  if ((arrived == false) && (_state != STATE_SYNC) && (millis() - _millis > REMOTE_TIMEOUT_MS))
+  {
+    _state = STATE_SYNC;
+    _pDisplay->discardQueued();                                 // Queue holds only this frame
+    _errors++;
+  }
+  return applied;
+} // update()
+
+//--------------------------------------------------------------
+/// \brief Number of applied frames
+///
+/// \return     Frames applied since start
+//--------------------------------------------------------------
+unsigned long remoteDisplay::frames(void)
+{
+  return _frames;
+} // frames()
+
+//--------------------------------------------------------------
+/// \brief Number of rejected frames
+///
+/// \return     Frames rejected since start, because of CRC, format or timeout
+//--------------------------------------------------------------
+unsigned long remoteDisplay::errors(void)
+{
+  return _errors;
+} // errors()
+
+//--------------------------------------------------------------
+/// \brief Parse a received byte
+///
+/// \param[in]  data  Byte received
+/// \return     true if a frame was completed and applied
+//--------------------------------------------------------------
+bool remoteDisplay::receive(uint8_t data)
+{
+  switch (_state)
+  {
+    case STATE_SYNC:
+      if (data == REMOTE_SYNC)
+      {
+        _crc = REMOTE_CRC_INIT;                                 // Sync byte is not covered by the CRC
+        _state = STATE_TYPE;
+      }
+      return false;
+
+    case STATE_TYPE:
+      _type = data;
+      _crc = crcUpdate(_crc, data);
+      _state = STATE_LENGTH;
+      return false;
+
+    case STATE_LENGTH:
+      _length = data;
+      _crc = crcUpdate(_crc, data);
+      _state = STATE_SEQUENCE;
+      return false;
+
+    case STATE_SEQUENCE:
+      _sequence = data;
+      _crc = crcUpdate(_crc, data);
+      startPayload();
+      _state = (_length > 0) ? STATE_PAYLOAD : STATE_CRC_HIGH;
+      return false;
+
+    case STATE_PAYLOAD:
+      _crc = crcUpdate(_crc, data);
+      receivePayload(data);
+      _received++;
+      if (_received >= _length)
+      {
+        _state = STATE_CRC_HIGH;
+      }
+      return false;
+
+    case STATE_CRC_HIGH:
+      _receivedCrc = (uint16_t)data << 8;
+      _state = STATE_CRC_LOW;
+      return false;
+
+    default:
+      _receivedCrc |= data;
+      _state = STATE_SYNC;
+      if (_receivedCrc != _crc)
+      {
+        reject(REMOTE_BAD_CRC);
+        return false;
+      }
+      if (_valid == false)
+      {
+        reject(REMOTE_BAD_FRAME);
+        return false;
+      }
+      return apply();
+  }
+} // receive()
+
+//--------------------------------------------------------------
+/// \brief Prepare for the payload of a frame
+///
+/// Checks the payload length against the type.
+//--------------------------------------------------------------
+void remoteDisplay::startPayload(void)
+{
+  _received = 0;
+  _runState = RUN_ADDRESS;
+
+  switch (_type)
+  {
+    case REMOTE_FULL_FRAME:
+    case REMOTE_CELL_RUNS:
+      if (_pDisplay->queuedCharacters() > 0)
+      {
+        _pDisplay->flush();                                     // Queue holds only this frame, so it can be dropped on errors
+      }
+      _valid = (_type == REMOTE_CELL_RUNS) || (_length == NUMBER_OF_CHARACTERS);
+      break;
+
+    case REMOTE_PAGE:
+      _valid = (_length == 1);
+      break;
+
+    case REMOTE_CLEAR:
+    case REMOTE_HELLO:
+      _valid = (_length == 0);
+      break;
+
+    default:
+      _valid = false;                                           // Unknown type, skip its payload
+      break;
+  }
+} // startPayload()
+
+//--------------------------------------------------------------
+/// \brief Handle a payload byte
+///
+/// Characters go straight into the display's queue.
+///
+/// \param[in]  data  Payload byte
+//--------------------------------------------------------------
+void remoteDisplay::receivePayload(uint8_t data)
+{
+  if (_valid == false)
+  {
+    return;
+  }
+
+  switch (_type)
+  {
+    case REMOTE_FULL_FRAME:
+      _pDisplay->queueCharacter(_received & 0x0F, _received >> 4, data);
+      break;
+
+    case REMOTE_CELL_RUNS:
+      if (_runState == RUN_ADDRESS)
+      {
+        _runAddress = data;
+        _valid = (data < NUMBER_OF_CHARACTERS);
+        _runState = RUN_COUNT;
+      }
+      else if (_runState == RUN_COUNT)
+      {
+        _runLeft = data;
+        _valid = (_runAddress + data <= NUMBER_OF_CHARACTERS);
+        _runState = (data > 0) ? RUN_CHARACTERS : RUN_ADDRESS;
+      }
+      else
+      {
+        _pDisplay->queueCharacter(_runAddress & 0x0F, _runAddress >> 4, data);
+        _runAddress++;
+        _runLeft--;
+        if (_runLeft == 0)
+        {
+          _runState = RUN_ADDRESS;
+        }
+      }
+      break;
+
+    case REMOTE_PAGE:
+      _page = data;
+      break;
+
+    default:
+      break;
+  }
+} // receivePayload()
+
+//--------------------------------------------------------------
+/// \brief Apply a complete frame with matching CRC
+///
+/// \return     true if the frame was applied
+//--------------------------------------------------------------
+bool remoteDisplay::apply(void)
+{
+  switch (_type)
+  {
+    case REMOTE_CELL_RUNS:
+      if (_runState != RUN_ADDRESS)
+      {
+        reject(REMOTE_BAD_FRAME);                               // Last run cut short
+        return false;
+      }
+      _pDisplay->flush();
+      break;
+
+    case REMOTE_FULL_FRAME:
+      _pDisplay->flush();
+      break;
+
+    case REMOTE_PAGE:
+      _pDisplay->showPage(_page);
+      break;
+
+    case REMOTE_CLEAR:
+      _pDisplay->clear();
+      break;
+
+    case REMOTE_HELLO:
+    {
+      uint8_t payload[4] = {REMOTE_OK, REMOTE_VERSION, (uint8_t)(_window & 0xFF), (uint8_t)(_window >> 8)};
+      sendFrame(REMOTE_ACK, payload, sizeof(payload));
+      _frames++;
+      return true;
+    }
+
+    default:
+      break;
+  }
+
+  _frames++;
+  acknowledge(REMOTE_OK);
+  return true;
+} // apply()
+
+//--------------------------------------------------------------
+/// \brief Reject a frame
+///
+/// Drops its queued characters, so a damaged frame changes nothing. The display's queue\
+/// belongs to the remote display, so all queued characters are this frame's.
+///
+/// \param[in]  status  REMOTE_BAD_CRC or REMOTE_BAD_FRAME
+//--------------------------------------------------------------
+void remoteDisplay::reject(uint8_t status)
+{
+  _pDisplay->discardQueued();
+  _errors++;
+  acknowledge(status);
+} // reject()
+
+//--------------------------------------------------------------
+/// \brief Acknowledge the frame received
+///
+/// \param[in]  status  REMOTE_OK, REMOTE_BAD_CRC or REMOTE_BAD_FRAME
+//--------------------------------------------------------------
+void remoteDisplay::acknowledge(uint8_t status)
+{
+  sendFrame(REMOTE_ACK, &status, 1);
+} // acknowledge()
+
+//--------------------------------------------------------------
+/// \brief Send a frame to the host
+///
+/// Uses the sequence number of the frame received.
+///
+/// \param[in]  type     Frame type
+/// \param[in]  payload  Payload bytes
+/// \param[in]  length   [bytes] Payload length
+//--------------------------------------------------------------
+void remoteDisplay::sendFrame(uint8_t type, const uint8_t *payload, uint8_t length)
+{
+  uint8_t header[4] = {REMOTE_SYNC, type, length, _sequence};
+  uint16_t crc = REMOTE_CRC_INIT;
+
+  for (int i = 1; i < 4; i++)
+  {
+    crc = crcUpdate(crc, header[i]);
+  }
+  for (int i = 0; i < length; i++)
+  {
+    crc = crcUpdate(crc, payload[i]);
+  }
+  uint8_t trailer[2] = {(uint8_t)(crc >> 8), (uint8_t)(crc & 0xFF)};
+
+  _pStream->write(header, sizeof(header));
+  _pStream->write(payload, length);
+  _pStream->write(trailer, sizeof(trailer));
+} // sendFrame()
+
+//--------------------------------------------------------------
+/// \brief Add a byte to a CRC-16/CCITT-FALSE
+///
+/// \param[in]  crc   CRC so far
+/// \param[in]  data  Byte to add
+/// \return     New CRC
+//--------------------------------------------------------------
+uint16_t remoteDisplay::crcUpdate(uint16_t crc, uint8_t data)
+{
+#if defined(__AVR__)
+  return _crc_xmodem_update(crc, data);                         // Same polynomial, MSB first
+#else
+  crc ^= (uint16_t)data << 8;
+  for (int i = 0; i < 8; i++)
+  {
+    crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ REMOTE_CRC_POLYNOMIAL) : (uint16_t)(crc << 1);
+  }
+  return crc;
+#endif
+} // crcUpdate()
@@ -0,0 +1,164 @@
+/*
+  MS6205_remote.h - Binary remote control protocol for a MS6205 vintage soviet character display.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+
+  REMOTE PROTOCOL
+  =================
+   remoteDisplay lets a PC drive the display over any Arduino Stream, e.g. Serial or a WiFiClient.
+   Every message is a frame:
+
+     Byte    | Content
+    ---------|-----------------------------------------------------------------------
+     0       | REMOTE_SYNC
+     1       | Type, see below
+     2       | Payload length n, 0 to 255
+     3       | Sequence number, echoed in the acknowledge
+     4..3+n  | Payload
+     4+n, 5+n| CRC-16/CCITT-FALSE over bytes 1..3+n, high byte first
+
+   Host to display:
+     REMOTE_FULL_FRAME   160 characters, row by row, for the visible page
+     REMOTE_CELL_RUNS    Runs of (address, count, count characters); a run may cross row ends
+     REMOTE_PAGE         Page to show, 0-3
+     REMOTE_CLEAR        No payload
+     REMOTE_HELLO        No payload
+
+   Display to host:
+     REMOTE_ACK          Status (REMOTE_OK, REMOTE_BAD_CRC or REMOTE_BAD_FRAME). The acknowledge of
+                         REMOTE_HELLO adds REMOTE_VERSION and the receive window [bytes], low byte first.
+
+   Characters are queued while they arrive, so no frame buffer is needed, and written by flush() only
+   after the CRC matched: unchanged cells are skipped, and a damaged frame changes nothing.
+   A damaged frame is dropped by discardQueued(), so the remote display owns the display's write queue:
+   other code must not use queueCharacter(), queueText() or flush() on the same display.
+   Keep MS6205_QUEUE at 1: without the queue, characters are written as they arrive, and a damaged
+   frame shows until the host's resend repairs it.
+   Every frame is acknowledged after it was applied. For flow control, the host keeps at most
+   "receive window" bytes of unacknowledged frames in flight; on an error it resends all of them.
+   All frames are idempotent, so resending never does harm.
+*/
+
+#ifndef MS6205_REMOTE_H
+#define MS6205_REMOTE_H
+
+#include "Arduino.h"
+#include "MS6205.h"
+
+#define REMOTE_SYNC              0xA5   // First byte of every frame
+#define REMOTE_VERSION              1   // Protocol version, reported by REMOTE_HELLO
+
+#define REMOTE_FULL_FRAME        0x01   // Frame types, host to display
+#define REMOTE_CELL_RUNS         0x02
+#define REMOTE_PAGE              0x03
+#define REMOTE_CLEAR             0x04
+#define REMOTE_HELLO             0x05
+#define REMOTE_ACK               0x80   // Frame type, display to host
+
+#define REMOTE_OK                   0   // Acknowledge status
+#define REMOTE_BAD_CRC              1
+#define REMOTE_BAD_FRAME            2
+
+#define REMOTE_TIMEOUT_MS         100   // [ms] Gap inside a frame after which it is dropped
+
+#if defined(SERIAL_RX_BUFFER_SIZE)
+  #define REMOTE_WINDOW   SERIAL_RX_BUFFER_SIZE // [bytes] Default receive window: the serial receive buffer
+#elif defined(ESP8266) || defined(ESP32)
+  #define REMOTE_WINDOW           256
+#else
+  #define REMOTE_WINDOW            64
+#endif
+
+class remoteDisplay
+{
+  public:
+
+    //--------------------------------------------------------------
+    /// \brief Class constructor
+    ///
+    /// Creates remote protocol handler. The remote display owns the display's write queue:\
+    /// a damaged frame drops all queued characters, so other code must not queue characters\
+    /// on it, but may write directly.
+    ///
+    /// \param[in]  pDisplay  Display to drive
+    /// \param[in]  pStream   Stream to receive frames from and send acknowledges to
+    /// \param[in]  window    [bytes] Receive window reported to the host, at most the stream's receive buffer
+    //--------------------------------------------------------------
+    remoteDisplay(MS6205 *pDisplay, Stream *pStream, uint16_t window = REMOTE_WINDOW);
+
+    //--------------------------------------------------------------
+    /// \brief Periodic update
+    ///
+    /// Call in loop() method. Handles all received bytes. A frame is dropped only if nothing\
+    /// arrived for REMOTE_TIMEOUT_MS, so a late loop() does not drop bytes waiting in the stream.
+    ///
+    /// \return     Number of frames applied
+    //--------------------------------------------------------------
+    int update(void);
+
+    //--------------------------------------------------------------
+    /// \brief Number of applied frames
+    ///
+    /// \return     Frames applied since start
+    //--------------------------------------------------------------
+    unsigned long frames(void);
+
+    //--------------------------------------------------------------
+    /// \brief Number of rejected frames
+    ///
+    /// \return     Frames rejected since start, because of CRC, format or timeout
+    //--------------------------------------------------------------
+    unsigned long errors(void);
+
+  private:
+    MS6205 * _pDisplay;           // Pointer to display to drive
+    Stream * _pStream;            // Pointer to stream to talk through
+    uint16_t _window;             // [bytes] Receive window reported to the host
+    uint8_t _state;               // Parser state
+    uint8_t _type;                // Type of frame received
+    uint8_t _length;              // [bytes] Payload length of frame received
+    uint8_t _sequence;            // Sequence number of frame received
+    uint8_t _received;            // [bytes] Payload received so far
+    uint16_t _crc;                // CRC of frame received so far
+    uint16_t _receivedCrc;        // CRC sent with the frame
+    uint8_t _runAddress;          // Next cell of the current run
+    uint8_t _runLeft;             // [characters] Characters of the current run still to come
+    uint8_t _runState;            // Run field expected next
+    uint8_t _page;                // Page of REMOTE_PAGE
+    bool _valid;                  // Payload fits the type so far
+    unsigned long _millis;        // [ms] Time of the last byte received
+    unsigned long _frames;        // Frames applied
+    unsigned long _errors;        // Frames rejected
+
+    bool receive(uint8_t data);
+    void startPayload(void);
+    void receivePayload(uint8_t data);
+    bool apply(void);
+    void reject(uint8_t status);
+    void acknowledge(uint8_t status);
+    void sendFrame(uint8_t type, const uint8_t *payload, uint8_t length);
+    static uint16_t crcUpdate(uint16_t crc, uint8_t data);
+};
+
+#endif // MS6205_REMOTE_H
@@ -0,0 +1,92 @@
+/*
+  MS6205_screen.cpp - Compressed screen assets for a MS6205 vintage soviet character display.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+
+#include "Arduino.h"
+#include "MS6205_screen.h"
+
+//--------------------------------------------------------------
+/// \brief Class constructor
+///
+/// Creates decoder for a screen asset
+///
+/// \param[in]  screen  Screen asset in PROGMEM, see DATA FORMAT
+//--------------------------------------------------------------
+screenReader::screenReader(const uint8_t *screen)
+{
+  _packed = (pgm_read_byte(&screen[0]) == SCREEN_PACKED);
+  _data = &screen[1];
+  _bits = 0;
+  _bitCount = 0;
+  _runLength = 0;
+  _runCharacter = ' ';
+} // screenReader()
+
+//--------------------------------------------------------------
+/// \brief Decode next cell
+///
+/// Cells come in address order, row by row.
+///
+/// \return     Character of the next cell
+//--------------------------------------------------------------
+char screenReader::next(void)
+{
+  if (_runLength > 0)
+  {
+    _runLength--;
+    return _runCharacter;
+  }
+
+  uint8_t symbol = nextSymbol();
+  if (symbol < SCREEN_RUN_SYMBOLS)
+  {
+    _runCharacter = nextSymbol();
+    _runLength = symbol + SCREEN_MIN_RUN - 1;                   // This call returns the first one
+    return _runCharacter;
+  }
+  return symbol;
+} // next()
+
+//--------------------------------------------------------------
+/// \brief Read next symbol
+///
+/// \return     Symbol, 0 to 127
+//--------------------------------------------------------------
+uint8_t screenReader::nextSymbol(void)
+{
+  if (_packed == false)
+  {
+    return pgm_read_byte(_data++) & 0x7F;
+  }
+
+  if (_bitCount < 7)
+  {
+    _bits = (_bits << 8) | pgm_read_byte(_data++);              // At most 6 + 8 bits, fits
+    _bitCount += 8;
+  }
+  _bitCount -= 7;
+  return (_bits >> _bitCount) & 0x7F;
+} // nextSymbol()
@@ -0,0 +1,92 @@
+/*
+  MS6205_screen.h - Compressed screen assets for a MS6205 vintage soviet character display.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+
+  SCREEN ASSETS
+  ===============
+   A screen asset holds a complete 16 x 10 page content in flash (PROGMEM), run-length encoded
+   and optionally packed to 7 bits per symbol. Screen assets are created from text files with
+   extras/tools/make_screen.py. MS6205::drawScreen() decodes them on the fly, straight into the
+   character write path: no 160 byte buffer is needed, and the screen is painted in one pass.
+
+
+  DATA FORMAT
+  ===============
+   Byte 0 is the format, SCREEN_PLAIN or SCREEN_PACKED. It is followed by a stream of 7-bit symbols:
+
+     Symbol   | Meaning
+    ----------|-------------------------------------------------------------------------------
+     0 - 31   | Run: the next symbol is a character, repeated (symbol + SCREEN_MIN_RUN) times
+     32 - 127 | Character, shown as is (127 is the fully black box)
+
+   SCREEN_PLAIN stores one symbol per byte. SCREEN_PACKED stores symbols as 7 bits each,
+   most significant bit first, so 8 symbols take 7 bytes. The stream ends after 160 cells.
+*/
+
+#ifndef MS6205_SCREEN_H
+#define MS6205_SCREEN_H
+
+#include "Arduino.h"
+
+#define SCREEN_PLAIN             0x00   // One symbol per byte
+#define SCREEN_PACKED            0x01   // 7 bits per symbol
+
+#define SCREEN_RUN_SYMBOLS         32   // Symbols 0 to 31 start a run
+#define SCREEN_MIN_RUN              3   // [characters] Shortest run, shorter ones are stored as characters
+
+class screenReader
+{
+  public:
+
+    //--------------------------------------------------------------
+    /// \brief Class constructor
+    ///
+    /// Creates decoder for a screen asset
+    ///
+    /// \param[in]  screen  Screen asset in PROGMEM, see DATA FORMAT
+    //--------------------------------------------------------------
+    screenReader(const uint8_t *screen);
+
+    //--------------------------------------------------------------
+    /// \brief Decode next cell
+    ///
+    /// Cells come in address order, row by row.
+    ///
+    /// \return     Character of the next cell
+    //--------------------------------------------------------------
+    char next(void);
+
+  private:
+    const uint8_t *_data;         // Next byte to read, in PROGMEM
+    bool _packed;                 // Symbols are packed to 7 bits
+    uint16_t _bits;               // Bits read but not decoded yet, right-aligned
+    uint8_t _bitCount;            // Number of valid bits in _bits
+    uint8_t _runLength;           // [characters] Repetitions of _runCharacter still to return
+    char _runCharacter;           // Character of the current run
+
+    uint8_t nextSymbol(void);
+};
+
+#endif // MS6205_SCREEN_H
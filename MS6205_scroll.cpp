@@ -29,6 +29,7 @@
 #include "MS6205_scroll.h"
 
 
+#if MS6205_SCROLL_STRING
 //--------------------------------------------------------------
 /// \brief Class constructor 
 ///
@@ -44,39 +45,44 @@
 //--------------------------------------------------------------
 scrollText::scrollText(int startColumn, int startRow, int endColumn, int endRow, int delayTime, String text, MS6205 *pDisplay)    //cho parameter checks
 {
-  _text = text;                                          // Text to display
-  _textLength = text.length();                           // Text length
+  _text.setText(text);                                   // Text to display
+  _pSource = &_text;                                     // Source to pull the text from
   _delayTime = delayTime;                                // [ms] Delay between scrolling to the next state
-  
-  if (startColumn >= (NUMBER_OF_COLUMNS - 1))
-    startColumn = NUMBER_OF_COLUMNS - 1;
-  
-  if (startRow >= (NUMBER_OF_ROWS - 1))
-    startRow = NUMBER_OF_ROWS - 1;
-  
-  if (endColumn >= (NUMBER_OF_COLUMNS - 1))
-    endColumn = NUMBER_OF_COLUMNS - 1;
-  
-  if (endRow >= (NUMBER_OF_ROWS - 1))
-    endRow = NUMBER_OF_ROWS - 1;  
-  
-  _areaStart = (startColumn & 0x0F) | (startRow << 4);   // [position] Address of first character to show scrolling at
-  int areaEnd = (endColumn & 0x0F) | (endRow << 4);      // [position] Address of last character to show scrolling at
-  
-  if (areaEnd > _areaStart)                              // If valid area defined:
-  {
-    _areaLength = (areaEnd - _areaStart + 1);            // [characters] Length of area to display scrolling at
-  }
-  else                                                   // Invalid area defined:
-  {
-    _areaLength = 1;                                     // Show only one character at start position, to indicate something's wrong
-  }
-  
-  _state = _areaLength + _textLength;                    // State of scrolling
+  _millis = 0;
+  _pDisplay = pDisplay;                                  // Pointer to display to show scrolling on
+  setArea(startColumn, startRow, endColumn, endRow);
   _enabled = true;                                       // Enabled/disabled scrolling
+} // scrollText()
+#endif
+
+//--------------------------------------------------------------
+/// \brief Class constructor
+///
+/// Creates scrollable text object, which pulls its text from a source
+///
+/// \param[in]  startColumn Column of first character to show scrolling at
+/// \param[in]  startRow    Row of first character to show scrolling at
+/// \param[in]  endColumn   Column of last character to show scrolling at
+/// \param[in]  endRow      Row of last character to show scrolling at
+/// \param[in]  delayTime   [ms] Delay between scrolling changes
+/// \param[in]  pSource     Source of the text, must stay valid while scrolling
+/// \param[in]  pDisplay    Display to show scrolling on
+//--------------------------------------------------------------
+scrollText::scrollText(int startColumn, int startRow, int endColumn, int endRow, int delayTime, scrollSource *pSource, MS6205 *pDisplay)
+{
+  _pSource = pSource;                                    // Source to pull the text from
+  _delayTime = delayTime;                                // [ms] Delay between scrolling to the next state
+  _millis = 0;
   _pDisplay = pDisplay;                                  // Pointer to display to show scrolling on
+  setArea(startColumn, startRow, endColumn, endRow);
+  _enabled = true;                                       // Enabled/disabled scrolling
 } // scrollText()
 
+scrollText::~scrollText(void)
+{
+  delete[] _area;
+} // ~scrollText()
+
 //--------------------------------------------------------------
 /// \brief Periodic update 
 ///
@@ -88,39 +94,53 @@ void scrollText::update(void)
       &&(_pDisplay != NULL)
       &&(millis() > (_millis + _delayTime)))
   {  
-    // --- Clear scrolling area ---
-    clearArea();
-
-    // --- Scroll text ---
-    if (_state >= _textLength)
+    // --- Pull next character, spaces after the text until it has scrolled out ---
+    int character = (_pSource != NULL) ? _pSource->next() : -1;
+    if (character < 0)
     {
-      // Scroll inside available area
-      int row = (_areaStart + _state - _textLength) >> 4;
-      int column = (_areaStart + _state - _textLength) & 0x0F;
-      _pDisplay->setCursor(column, row);      
-      _pDisplay->write(_text.substring(0, _areaLength + _textLength - _state));      
+      character = ' ';
+      _blanks++;
+      if (_blanks >= _areaLength)                        // Text has left the area:
+      {
+        if (_pSource != NULL)
+        {
+          _pSource->rewind();                            // Start over
+        }
+        _blanks = 0;
+      }
     }
     else
     {
-      // Scroll out to the left      
-      int row = _areaStart >> 4;
-      int column = _areaStart & 0x0F;
-      _pDisplay->setCursor(column, row);  
-      _pDisplay->write(_text.substring(_textLength - _state, _areaLength + _textLength - _state));
+      _blanks = 0;
     }
-  
-    // --- Count state ---
-    _state--;
-    if (_state < 0)
+
+    // --- Scroll area one character to the left ---
+    _area[_first] = toUpperCase(character);              // Leftmost character drops out, new one enters at the right
+    _first++;
+    if (_first >= _areaLength)
     {
-      _state = _areaLength + _textLength;
+      _first = 0;
     }
 
+    // --- Write changed cells ---
+    int index = _first;
+    for (int i = 0; i < _areaLength; i++)
+    {
+      int address = _areaStart + i;
+      _pDisplay->queueCharacter(address & 0x0F, address >> 4, _area[index]);   // Dropped if unchanged
+      index++;
+      if (index >= _areaLength)
+      {
+        index = 0;
+      }
+    }
+    _pDisplay->flush();
 
     _millis = millis();
   }
 } // update()
 
+#if MS6205_SCROLL_STRING
 //--------------------------------------------------------------
 /// \brief Set text 
 ///
@@ -129,14 +149,72 @@ void scrollText::update(void)
 /// \param[in]  text        String to display
 //--------------------------------------------------------------
 void scrollText::setText(String text)
+{
+  _text.setText(text);                     // Text to display
+  setSource(&_text);
+} // setText()
+#endif
+
+//--------------------------------------------------------------
+/// \brief Set source
+///
+/// Change source to pull the text from, starts over in a cleared area
+///
+/// \param[in]  pSource     Source of the text, must stay valid while scrolling
+//--------------------------------------------------------------
+void scrollText::setSource(scrollSource *pSource)
 {
   _enabled = false;                        // Disable scrolling
-  _text = text;                            // Text to display
-  _textLength = text.length();             // Text length
-  _state = _areaLength + _textLength;      // State of scrolling
+  _pSource = pSource;
+  if (_pSource != NULL)
+  {
+    _pSource->rewind();
+  }
   clearArea();                             // Clear display area  
   _enabled = true;                         // Enable scrolling
-} // setText()
+} // setSource()
+
+//--------------------------------------------------------------
+/// \brief Set scrolling area
+///
+/// Allocates the area's characters, once per object.
+///
+/// \param[in]  startColumn Column of first character to show scrolling at
+/// \param[in]  startRow    Row of first character to show scrolling at
+/// \param[in]  endColumn   Column of last character to show scrolling at
+/// \param[in]  endRow      Row of last character to show scrolling at
+//--------------------------------------------------------------
+void scrollText::setArea(int startColumn, int startRow, int endColumn, int endRow)
+{
+  if (startColumn >= (NUMBER_OF_COLUMNS - 1))
+    startColumn = NUMBER_OF_COLUMNS - 1;
+  
+  if (startRow >= (NUMBER_OF_ROWS - 1))
+    startRow = NUMBER_OF_ROWS - 1;
+  
+  if (endColumn >= (NUMBER_OF_COLUMNS - 1))
+    endColumn = NUMBER_OF_COLUMNS - 1;
+  
+  if (endRow >= (NUMBER_OF_ROWS - 1))
+    endRow = NUMBER_OF_ROWS - 1;  
+  
+  _areaStart = (startColumn & 0x0F) | (startRow << 4);   // [position] Address of first character to show scrolling at
+  int areaEnd = (endColumn & 0x0F) | (endRow << 4);      // [position] Address of last character to show scrolling at
+  
+  if (areaEnd > _areaStart)                              // If valid area defined:
+  {
+    _areaLength = (areaEnd - _areaStart + 1);            // [characters] Length of area to display scrolling at
+  }
+  else                                                   // Invalid area defined:
+  {
+    _areaLength = 1;                                     // Show only one character at start position, to indicate something's wrong
+  }
+
+  _area = new char[_areaLength];                         // Only the area is held, not the text
+  memset(_area, ' ', _areaLength);
+  _first = 0;
+  _blanks = 0;
+} // setArea()
 
 //--------------------------------------------------------------
 /// \brief Clear scrolling area 
@@ -145,20 +223,190 @@ void scrollText::setText(String text)
 //--------------------------------------------------------------
 void scrollText::clearArea(void)
 {
-  int row = _areaStart >> 4;
-  int column = _areaStart & 0x0F;
-  String spaces = "";
-  for (int i = 0; i < _areaLength; i++)
-  {
-    spaces += " "; 
-  }
-  
+  memset(_area, ' ', _areaLength);
+  _first = 0;
+  _blanks = 0;
+
   if (_pDisplay != NULL)
   {
-    _pDisplay->setCursor(column, row);
-    _pDisplay->write(spaces);
+    for (int i = 0; i < _areaLength; i++)
+    {
+      int address = _areaStart + i;
+      _pDisplay->queueCharacter(address & 0x0F, address >> 4, ' ');
+    }
+    _pDisplay->flush();
   }
 } // clearArea()
 
+#if MS6205_SCROLL_STRING
+//--------------------------------------------------------------
+/// \brief Class constructor
+///
+/// Creates source of an empty text
+//--------------------------------------------------------------
+stringSource::stringSource(void)
+{
+  _index = 0;
+} // stringSource()
+
+//--------------------------------------------------------------
+/// \brief Set text
+///
+/// \param[in]  text  String to scroll, starts over
+//--------------------------------------------------------------
+void stringSource::setText(String text)
+{
+  _text = text;
+  _index = 0;
+} // setText()
+
+int stringSource::next(void)
+{
+  return (_index < _text.length()) ? (unsigned char)_text.charAt(_index++) : -1;
+} // next()
+
+void stringSource::rewind(void)
+{
+  _index = 0;
+} // rewind()
+#endif
+
+//--------------------------------------------------------------
+/// \brief Class constructor
+///
+/// \param[in]  text  Zero-terminated text in PROGMEM, e.g. PSTR("...")
+//--------------------------------------------------------------
+flashSource::flashSource(PGM_P text)
+{
+  _text = text;
+  _index = 0;
+} // flashSource()
+
+int flashSource::next(void)
+{
+  if (_text == NULL)
+  {
+    return -1;
+  }
+
+  char character = pgm_read_byte(&_text[_index]);
+  if (character == '\0')
+  {
+    return -1;                                           // Stay at the end until rewound
+  }
+  _index++;
+  return (unsigned char)character;
+} // next()
+
+void flashSource::rewind(void)
+{
+  _index = 0;
+} // rewind()
+
+#if defined(ESP8266) || defined(ESP32)
+//--------------------------------------------------------------
+/// \brief Class constructor
+///
+/// \param[in]  file  Opened file, e.g. LittleFS.open("/news.txt", "r")
+//--------------------------------------------------------------
+fileSource::fileSource(fs::File file)
+{
+  _file = file;
+} // fileSource()
+
+int fileSource::next(void)
+{
+  return _file ? _file.read() : -1;                      // -1 at the end of the file
+} // next()
+
+void fileSource::rewind(void)
+{
+  if (_file)
+  {
+    _file.seek(0);
+  }
+} // rewind()
+#endif
+
+//--------------------------------------------------------------
+/// \brief Class constructor
+///
+/// \param[in]  pStream  Stream to scroll what arrives on, never rewound
+//--------------------------------------------------------------
+streamSource::streamSource(Stream *pStream)
+{
+  _pStream = pStream;
+} // streamSource()
+
+int streamSource::next(void)
+{
+  if ((_pStream == NULL) || (_pStream->available() <= 0))
+  {
+    return -1;                                           // Nothing arrived yet, don't wait for it
+  }
+  return _pStream->read();
+} // next()
 
+//--------------------------------------------------------------
+/// \brief Class constructor
+///
+/// \param[in]  buffer  Buffer for characters not scrolled in yet
+/// \param[in]  size    [characters] Size of buffer
+//--------------------------------------------------------------
+ringSource::ringSource(char *buffer, int size)
+{
+  _buffer = buffer;
+  _size = (buffer != NULL) ? size : 0;
+  _head = 0;
+  _count = 0;
+} // ringSource()
 
+//--------------------------------------------------------------
+/// \brief Append a character, print() and write() append text
+///
+/// \param[in]  value  Character to append
+///
+/// \return     1, or 0 if the buffer is full and the character was dropped
+//--------------------------------------------------------------
+size_t ringSource::write(uint8_t value)
+{
+  if (_count >= _size)
+  {
+    return 0;
+  }
+
+  _buffer[_head] = (char)value;
+  _head++;
+  if (_head >= _size)
+  {
+    _head = 0;
+  }
+  _count++;
+  return 1;
+} // write()
+
+//--------------------------------------------------------------
+/// \brief Characters not scrolled in yet
+///
+/// \return     [characters] Number of characters in buffer
+//--------------------------------------------------------------
+int ringSource::available(void)
+{
+  return _count;
+} // available()
+
+int ringSource::next(void)
+{
+  if (_count == 0)
+  {
+    return -1;
+  }
+
+  int tail = _head - _count;                             // Oldest character
+  if (tail < 0)
+  {
+    tail += _size;
+  }
+  _count--;
+  return (unsigned char)_buffer[tail];
+} // next()
@@ -23,6 +23,22 @@
   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
   SOFTWARE.
   
+
+  SOURCES
+  ===============
+   scrollText pulls the characters to scroll in one by one from a scrollSource, so the text can be
+   larger than the RAM: only the scrolling area's characters are held. Every update() takes one
+   character, shifts the area by one and writes the cells that changed, so its cost depends on the
+   area, not on the text.
+
+     stringSource  A String, used by the String constructor and setText()
+     flashSource   A string in flash (PROGMEM)
+     fileSource    A file, e.g. on LittleFS (ESP8266 and ESP32)
+     streamSource  Whatever arrives on a Stream, e.g. Serial or a WiFiClient
+     ringSource    A circular buffer, which can be printed to while scrolling
+
+   next() returns -1 at the end of the text, or while nothing has arrived yet. Then spaces are
+   scrolled in, until the text has left the area, and the source is rewound to start over.
 */
 
 #ifndef MS6205_SCROLL_H
@@ -31,10 +47,141 @@
 #include "Arduino.h"
 #include "MS6205.h"
 
+#if defined(ESP8266) || defined(ESP32)
+#include <FS.h>
+#endif
+
+#ifndef MS6205_SCROLL_STRING
+  #define MS6205_SCROLL_STRING      1   // 0: Without String constructor and setText(), saves a String per scrollText
+#endif
+
+class scrollSource
+{
+  public:
+    virtual ~scrollSource(void) {}
+
+    //--------------------------------------------------------------
+    /// \brief Next character to scroll in
+    ///
+    /// \return     Character, -1 at the end of the text or if nothing is available yet
+    //--------------------------------------------------------------
+    virtual int next(void) = 0;
+
+    //--------------------------------------------------------------
+    /// \brief Start text over
+    ///
+    /// Called after the text has scrolled out. Sources without a start do nothing.
+    //--------------------------------------------------------------
+    virtual void rewind(void) {}
+};
+
+#if MS6205_SCROLL_STRING
+class stringSource : public scrollSource
+{
+  public:
+    stringSource(void);
+    void setText(String text);
+    int next(void);
+    void rewind(void);
+
+  private:
+    String _text;                 // Text to scroll
+    unsigned int _index;          // Next character
+};
+#endif
+
+class flashSource : public scrollSource
+{
+  public:
+    //--------------------------------------------------------------
+    /// \brief Class constructor
+    ///
+    /// \param[in]  text  Zero-terminated text in PROGMEM, e.g. PSTR("...")
+    //--------------------------------------------------------------
+    flashSource(PGM_P text);
+    int next(void);
+    void rewind(void);
+
+  private:
+    PGM_P _text;                  // Text to scroll, in PROGMEM
+    unsigned long _index;         // Next character
+};
+
+#if defined(ESP8266) || defined(ESP32)
+class fileSource : public scrollSource
+{
+  public:
+    //--------------------------------------------------------------
+    /// \brief Class constructor
+    ///
+    /// \param[in]  file  Opened file, e.g. LittleFS.open("/news.txt", "r")
+    //--------------------------------------------------------------
+    fileSource(fs::File file);
+    int next(void);
+    void rewind(void);
+
+  private:
+    fs::File _file;               // File to scroll, read one character at a time
+};
+#endif
+
+class streamSource : public scrollSource
+{
+  public:
+    //--------------------------------------------------------------
+    /// \brief Class constructor
+    ///
+    /// \param[in]  pStream  Stream to scroll what arrives on, never rewound
+    //--------------------------------------------------------------
+    streamSource(Stream *pStream);
+    int next(void);
+
+  private:
+    Stream * _pStream;            // Pointer to stream to read from
+};
+
+class ringSource : public scrollSource, public Print
+{
+  public:
+    //--------------------------------------------------------------
+    /// \brief Class constructor
+    ///
+    /// \param[in]  buffer  Buffer for characters not scrolled in yet
+    /// \param[in]  size    [characters] Size of buffer
+    //--------------------------------------------------------------
+    ringSource(char *buffer, int size);
+
+    //--------------------------------------------------------------
+    /// \brief Append a character, print() and write() append text
+    ///
+    /// \param[in]  value  Character to append
+    ///
+    /// \return     1, or 0 if the buffer is full and the character was dropped
+    //--------------------------------------------------------------
+    size_t write(uint8_t value);
+    using Print::write;
+
+    //--------------------------------------------------------------
+    /// \brief Characters not scrolled in yet
+    ///
+    /// \return     [characters] Number of characters in buffer
+    //--------------------------------------------------------------
+    int available(void);
+
+    int next(void);
+
+  private:
+    char *_buffer;                // Buffer for characters not scrolled in yet
+    int _size;                    // [characters] Size of buffer
+    int _head;                    // Index of the next character to append
+    int _count;                   // [characters] Number of characters in buffer
+};
+
 class scrollText  
 {
   public:
   
+#if MS6205_SCROLL_STRING
     //--------------------------------------------------------------
     /// \brief Class constructor 
     ///
@@ -49,6 +196,24 @@ class scrollText
     /// \param[in]  pDisplay    Display to show scrolling on
     //--------------------------------------------------------------
     scrollText(int startColumn, int startRow, int endColumn, int endRow, int delayTime, String text, MS6205 *pDisplay);
+#endif
+
+    //--------------------------------------------------------------
+    /// \brief Class constructor
+    ///
+    /// Creates scrollable text object, which pulls its text from a source
+    ///
+    /// \param[in]  startColumn Column of first character to show scrolling at
+    /// \param[in]  startRow    Row of first character to show scrolling at
+    /// \param[in]  endColumn   Column of last character to show scrolling at
+    /// \param[in]  endRow      Row of last character to show scrolling at
+    /// \param[in]  delayTime   [ms] Delay between scrolling changes
+    /// \param[in]  pSource     Source of the text, must stay valid while scrolling
+    /// \param[in]  pDisplay    Display to show scrolling on
+    //--------------------------------------------------------------
+    scrollText(int startColumn, int startRow, int endColumn, int endRow, int delayTime, scrollSource *pSource, MS6205 *pDisplay);
+
+    ~scrollText(void);
     
     //--------------------------------------------------------------
     /// \brief Periodic update 
@@ -57,6 +222,7 @@ class scrollText
     //--------------------------------------------------------------
     void update(void);
     
+#if MS6205_SCROLL_STRING
     //--------------------------------------------------------------
     /// \brief Set text 
     ///
@@ -65,19 +231,37 @@ class scrollText
     /// \param[in]  text        String to display
     //--------------------------------------------------------------
     void setText(String text);
+#endif
+
+    //--------------------------------------------------------------
+    /// \brief Set source
+    ///
+    /// Change source to pull the text from, starts over in a cleared area
+    ///
+    /// \param[in]  pSource     Source of the text, must stay valid while scrolling
+    //--------------------------------------------------------------
+    void setSource(scrollSource *pSource);
   
   private:
     unsigned long _millis;        // [ms] State of global millis() timer
-    int _delayTime;               // [ms] Delay between scrolling to the next state
-    int _areaStart;               // [position] Address of first character to show scrolling at
-    int _areaLength;              // [characters] Length of area to display scrolling at
-    String _text;                 // Text to display
-    int _textLength;              // Text length
-    int _state;                   // State of scrolling
+    uint16_t _delayTime;          // [ms] Delay between scrolling to the next state
+    uint8_t _areaStart;           // [position] Address of first character to show scrolling at
+    uint8_t _areaLength;          // [characters] Length of area to display scrolling at
+    uint8_t _first;               // Index in _area of the character at the area's start
+    uint8_t _blanks;              // Spaces scrolled in since the end of the text
     bool _enabled;                // Enabled/disabled scrolling 
+    char *_area;                  // Characters in area, circular, _areaLength of them
+#if MS6205_SCROLL_STRING
+    stringSource _text;           // Text of the String constructor and setText()
+#endif
+    scrollSource * _pSource;      // Pointer to source to pull the text from, NULL for none
     MS6205 * _pDisplay;           // Pointer to display to show on
-    
+
+    scrollText(const scrollText &);               // Not copyable, owns _area
+    scrollText &operator=(const scrollText &);
+
+    void setArea(int startColumn, int startRow, int endColumn, int endRow);
     void clearArea(void);  
 };
 
-#endif // MS6205_SCROLL_H
\ No newline at end of file
+#endif // MS6205_SCROLL_H
@@ -0,0 +1,139 @@
+/*
+  MS6205_scrub.cpp - Background repair of glitched cells for a MS6205 vintage soviet character display.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_scrub.h"
+
+//--------------------------------------------------------------
+/// \brief Class constructor
+///
+/// Creates scrubber object, starting at the first cell of every page.
+///
+/// \param[in]  pDisplay  Display to scrub
+//--------------------------------------------------------------
+cellScrubber::cellScrubber(MS6205 *pDisplay)
+{
+  _pDisplay = pDisplay;
+  memset(_next, 0, sizeof(_next));
+  _interval = SCRUB_INTERVAL_MS;
+  _budget = SCRUB_BUDGET;
+  _millis = millis();
+  resetCounters();
+} // cellScrubber()
+
+//--------------------------------------------------------------
+/// \brief Set time between two ticks
+///
+/// \param[in]  interval  [ms] 0 to scrub at every update()
+//--------------------------------------------------------------
+void cellScrubber::setInterval(unsigned int interval)
+{
+  _interval = interval;
+} // setInterval()
+
+//--------------------------------------------------------------
+/// \brief Set bus budget
+///
+/// \param[in]  cells  Cells written per tick, 0 to stop scrubbing
+//--------------------------------------------------------------
+void cellScrubber::setBudget(int cells)
+{
+  _budget = constrain(cells, 0, NUMBER_OF_CHARACTERS);
+} // setBudget()
+
+//--------------------------------------------------------------
+/// \brief Periodic update
+///
+/// Call in loop() method.
+///
+/// \return     Number of cells written
+//--------------------------------------------------------------
+int cellScrubber::update(void)
+{
+  if ((_pDisplay == NULL) || (_budget == 0))
+  {
+    return 0;
+  }
+
+  unsigned long now = millis();
+  if (now - _millis < _interval)
+  {
+    return 0;
+  }
+  _millis = now;
+
+  if (_pDisplay->queuedCharacters() > 0)
+  {
+    _counters.paused++;                                         // Foreground output first
+    return 0;
+  }
+
+  // --- Write up to the budget; unknown cells cost no bus time, but are bounded by one round ---
+  int page = _pDisplay->currentPage();
+  int written = 0;
+  for (int visited = 0; (visited < NUMBER_OF_CHARACTERS) && (written < _budget); visited++)
+  {
+    int address = _next[page];
+    if (_pDisplay->refreshCell(address) == true)
+    {
+      written++;
+    }
+    else
+    {
+      _counters.skipped++;
+    }
+
+    if (++address >= NUMBER_OF_CHARACTERS)
+    {
+      address = 0;
+      _counters.sweeps++;
+    }
+    _next[page] = address;
+  }
+
+  _counters.cells += written;
+  return written;
+} // update()
+
+//--------------------------------------------------------------
+/// \brief Counters for tuning budget and interval
+///
+/// \return     Counters since construction or resetCounters()
+//--------------------------------------------------------------
+const scrubCounters &cellScrubber::counters(void)
+{
+  return _counters;
+} // counters()
+
+//--------------------------------------------------------------
+/// \brief Reset counters
+//--------------------------------------------------------------
+void cellScrubber::resetCounters(void)
+{
+  memset(&_counters, 0, sizeof(_counters));
+} // resetCounters()
@@ -0,0 +1,116 @@
+/*
+  MS6205_scrub.h - Background repair of glitched cells for a MS6205 vintage soviet character display.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+
+  SCRUBBING
+  ===============
+   Noise on the bus can corrupt cells, and the display cannot be read back. Instead of redrawing
+   everything (clear() plus 160 writes), cellScrubber writes a few cells per tick again from the
+   page model, round-robin, so every cell is repaired within a bounded time at a bounded cost:
+
+     repair time [ms] = 160 / budget * interval,   e.g. 160 / 4 * 50 ms = 2 s
+
+   Only the visible page can be written, so the visible page is scrubbed. Every page keeps its own
+   position: when a page is shown again, scrubbing goes on where it stopped on that page.
+   While characters are queued for flush(), scrubbing pauses, so it never delays foreground output.
+   Cells never written through the library are skipped, as their content is not known, and so are
+   cells showing a character of MS6205::writeOverlay(), e.g. the alternate phase of blinkEngine.
+*/
+
+#ifndef MS6205_SCRUB_H
+#define MS6205_SCRUB_H
+
+#include "Arduino.h"
+#include "MS6205.h"
+
+#define SCRUB_INTERVAL_MS          50   // [ms] Default time between two ticks
+#define SCRUB_BUDGET                4   // [cells] Default cells written per tick
+
+struct scrubCounters
+{
+  unsigned long cells;            // Cells written again
+  unsigned long skipped;          // Cells passed over, as the page model does not know them or they are overlaid
+  unsigned long sweeps;           // Completed rounds over all cells of a page
+  unsigned long paused;           // Ticks given up as characters were queued
+};
+
+class cellScrubber
+{
+  public:
+
+    //--------------------------------------------------------------
+    /// \brief Class constructor
+    ///
+    /// Creates scrubber object, starting at the first cell of every page.
+    ///
+    /// \param[in]  pDisplay  Display to scrub
+    //--------------------------------------------------------------
+    cellScrubber(MS6205 *pDisplay);
+
+    //--------------------------------------------------------------
+    /// \brief Set time between two ticks
+    ///
+    /// \param[in]  interval  [ms] 0 to scrub at every update()
+    //--------------------------------------------------------------
+    void setInterval(unsigned int interval);
+
+    //--------------------------------------------------------------
+    /// \brief Set bus budget
+    ///
+    /// \param[in]  cells  Cells written per tick, 0 to stop scrubbing
+    //--------------------------------------------------------------
+    void setBudget(int cells);
+
+    //--------------------------------------------------------------
+    /// \brief Periodic update
+    ///
+    /// Call in loop() method.
+    ///
+    /// \return     Number of cells written
+    //--------------------------------------------------------------
+    int update(void);
+
+    //--------------------------------------------------------------
+    /// \brief Counters for tuning budget and interval
+    ///
+    /// \return     Counters since construction or resetCounters()
+    //--------------------------------------------------------------
+    const scrubCounters &counters(void);
+
+    //--------------------------------------------------------------
+    /// \brief Reset counters
+    //--------------------------------------------------------------
+    void resetCounters(void);
+
+  private:
+    uint8_t _next[NUMBER_OF_PAGES];   // Next cell to scrub, per page
+    unsigned int _interval;       // [ms] Time between two ticks
+    int _budget;                  // [cells] Cells written per tick
+    unsigned long _millis;        // [ms] Time of the last tick
+    scrubCounters _counters;
+    MS6205 * _pDisplay;           // Pointer to display to scrub
+};
+
+#endif // MS6205_SCRUB_H
@@ -0,0 +1,257 @@
+/*
+  MS6205_task.cpp - Background display output for a MS6205 vintage soviet character display.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_task.h"
+
+#if defined(__AVR__)
+  #include <util/atomic.h>
+#endif
+
+#define MAILBOX_INDEX            0x03   // Bits of _middle holding the frame index
+#define MAILBOX_FRESH            0x04   // Bit of _middle set while the handed-over frame is not picked up
+
+//--------------------------------------------------------------
+/// \brief Class constructor
+///
+/// Creates empty mailbox
+//--------------------------------------------------------------
+frameMailbox::frameMailbox(void)
+{
+  _back = 0;
+  _middle = 1;
+  _front = 2;
+} // frameMailbox()
+
+//--------------------------------------------------------------
+/// \brief Producer: frame to fill
+///
+/// Returns the frame owned by the producer. Fill it and call publish().
+///
+/// \return     Frame to fill
+//--------------------------------------------------------------
+displayFrame *frameMailbox::back(void)
+{
+  return &_frames[_back];
+} // back()
+
+//--------------------------------------------------------------
+/// \brief Producer: hand over filled frame
+///
+/// Replaces any frame the consumer did not pick up yet.
+//--------------------------------------------------------------
+void frameMailbox::publish(void)
+{
+  _back = exchangeMiddle(_back | MAILBOX_FRESH) & MAILBOX_INDEX;   // Take whatever was in the middle as next back frame
+} // publish()
+
+//--------------------------------------------------------------
+/// \brief Producer: copy and hand over a page content
+///
+/// \param[in]  page     [0-3] Page to render
+/// \param[in]  content  Up to 160 characters, row by row. Shorter content is filled with spaces.
+//--------------------------------------------------------------
+void frameMailbox::post(int page, const char *content)
+{
+  displayFrame *frame = back();
+  int length = strnlen(content, NUMBER_OF_CHARACTERS);
+
+  frame->page = page;
+  memcpy(frame->content, content, length);
+  memset(&frame->content[length], ' ', NUMBER_OF_CHARACTERS - length);
+  publish();
+} // post()
+
+//--------------------------------------------------------------
+/// \brief Consumer: pick up latest frame
+///
+/// \return     Latest frame, or NULL if nothing new was published since the last call
+//--------------------------------------------------------------
+const displayFrame *frameMailbox::receive(void)
+{
+#if defined(__AVR__)
+  uint8_t middle = _middle;                                     // Single byte reads are atomic on AVR
+#else
+  uint8_t middle = __atomic_load_n(&_middle, __ATOMIC_ACQUIRE);
+#endif
+
+  if ((middle & MAILBOX_FRESH) == 0)                            // Only the consumer clears the flag, so this check is safe
+  {
+    return NULL;
+  }
+
+  _front = exchangeMiddle(_front) & MAILBOX_INDEX;              // Hand back old frame, take the fresh one
+  return &_frames[_front];
+} // receive()
+
+//--------------------------------------------------------------
+/// \brief Atomically swap the handed-over frame
+///
+/// \param[in]  value  New value of _middle
+/// \return     Previous value of _middle
+//--------------------------------------------------------------
+uint8_t frameMailbox::exchangeMiddle(uint8_t value)
+{
+#if defined(__AVR__)
+  uint8_t previous;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE)                             // No atomic exchange instruction on AVR
+  {
+    previous = _middle;
+    _middle = value;
+  }
+  return previous;
+#else
+  return __atomic_exchange_n(&_middle, value, __ATOMIC_ACQ_REL);
+#endif
+} // exchangeMiddle()
+
+//--------------------------------------------------------------
+/// \brief Class constructor
+///
+/// Creates display task object, without starting a task yet.
+///
+/// \param[in]  pDisplay  Display to render on
+//--------------------------------------------------------------
+displayTask::displayTask(MS6205 *pDisplay)
+{
+  _pDisplay = pDisplay;
+#if defined(ESP32)
+  _task = NULL;
+#endif
+} // displayTask()
+
+#if defined(ESP32)
+//--------------------------------------------------------------
+/// \brief Start FreeRTOS task
+///
+/// From now on, use the display only through post().
+///
+/// \param[in]  core       [0-1] Core to pin the task to
+/// \param[in]  priority   FreeRTOS priority of the task
+/// \param[in]  stackSize  [bytes] Stack size of the task
+/// \return     true if the task was started
+//--------------------------------------------------------------
+bool displayTask::begin(int core, int priority, int stackSize)
+{
+  if (_task != NULL)
+  {
+    return true;
+  }
+
+  return xTaskCreatePinnedToCore(run, "MS6205", stackSize, this, priority, &_task, core) == pdPASS;
+} // begin()
+
+//--------------------------------------------------------------
+/// \brief Task function
+///
+/// Sleeps until a frame is posted, then renders the latest one.
+///
+/// \param[in]  parameter  displayTask object
+//--------------------------------------------------------------
+void displayTask::run(void *parameter)
+{
+  displayTask *self = (displayTask *)parameter;
+
+  for (;;)
+  {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);                    // Wait for post()
+    self->update();
+  }
+} // run()
+#endif
+
+//--------------------------------------------------------------
+/// \brief Post page content to render
+///
+/// Never blocks. If the previous frame was not rendered yet, it is replaced.
+///
+/// \param[in]  page     [0-3] Page to render
+/// \param[in]  content  Up to 160 characters, row by row. Shorter content is filled with spaces.
+//--------------------------------------------------------------
+void displayTask::post(int page, const char *content)
+{
+  _mailbox.post(page, content);
+  wake();
+} // post()
+
+//--------------------------------------------------------------
+/// \brief Frame to fill in place
+///
+/// Avoids the copy made by post(). Fill the frame and call publish().
+///
+/// \return     Frame to fill
+//--------------------------------------------------------------
+displayFrame *displayTask::back(void)
+{
+  return _mailbox.back();
+} // back()
+
+//--------------------------------------------------------------
+/// \brief Hand over frame filled in place
+///
+/// Never blocks. If the previous frame was not rendered yet, it is replaced.
+//--------------------------------------------------------------
+void displayTask::publish(void)
+{
+  _mailbox.publish();
+  wake();
+} // publish()
+
+//--------------------------------------------------------------
+/// \brief Render latest frame
+///
+/// Called by the task on the ESP32. Call in loop() on other platforms.
+///
+/// \return     true if a frame was rendered
+//--------------------------------------------------------------
+bool displayTask::update(void)
+{
+  const displayFrame *frame = _mailbox.receive();
+
+  if ((frame == NULL) || (_pDisplay == NULL))
+  {
+    return false;
+  }
+
+  _pDisplay->renderPage(frame->page, frame->content);          // Writes differing cells only
+  return true;
+} // update()
+
+//--------------------------------------------------------------
+/// \brief Wake display task
+///
+/// Does nothing if no task is running.
+//--------------------------------------------------------------
+void displayTask::wake(void)
+{
+#if defined(ESP32)
+  if (_task != NULL)
+  {
+    xTaskNotifyGive(_task);                                     // Never blocks
+  }
+#endif
+} // wake()
@@ -0,0 +1,195 @@
+/*
+  MS6205_task.h - Background display output for a MS6205 vintage soviet character display.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+
+  FRAME MAILBOX
+  ===============
+   A frameMailbox passes complete page contents from one producer to one consumer without locks.
+   It holds three frames: the producer fills one, the consumer renders another, and the third
+   one is handed over between them with a single atomic exchange. If the producer posts faster
+   than the consumer renders, older frames are simply replaced: the latest frame always wins,
+   and neither side ever waits for the other.
+
+
+  DISPLAY TASK
+  ===============
+   On the ESP32, displayTask::begin() starts a FreeRTOS task that renders every posted frame
+   through MS6205::renderPage(), so only differing cells are written. Once started, the display
+   must only be used through post(); the application never blocks on the display bus.
+   By default the task runs on core 1, so the WiFi and network stack on core 0 is never held up.
+
+   On other platforms, call update() from loop() to render the latest posted frame. Frames may
+   then be posted from anywhere, e.g. network callbacks.
+*/
+
+#ifndef MS6205_TASK_H
+#define MS6205_TASK_H
+
+#include "Arduino.h"
+#include "MS6205.h"
+
+#if defined(ESP32)
+  #include "freertos/FreeRTOS.h"
+  #include "freertos/task.h"
+#endif
+
+#define MAILBOX_FRAMES              3   // Frames held by a frameMailbox
+#define DISPLAY_TASK_CORE           1   // Default core of the display task
+#define DISPLAY_TASK_PRIORITY       1   // Default FreeRTOS priority of the display task
+#define DISPLAY_TASK_STACK       2048   // [bytes] Default stack size of the display task
+
+struct displayFrame
+{
+  int page;                                     // [0-3] Page to render
+  char content[NUMBER_OF_CHARACTERS];           // Page content, row by row
+};
+
+class frameMailbox
+{
+  public:
+
+    //--------------------------------------------------------------
+    /// \brief Class constructor
+    ///
+    /// Creates empty mailbox
+    //--------------------------------------------------------------
+    frameMailbox(void);
+
+    //--------------------------------------------------------------
+    /// \brief Producer: frame to fill
+    ///
+    /// Returns the frame owned by the producer. Fill it and call publish().
+    ///
+    /// \return     Frame to fill
+    //--------------------------------------------------------------
+    displayFrame *back(void);
+
+    //--------------------------------------------------------------
+    /// \brief Producer: hand over filled frame
+    ///
+    /// Replaces any frame the consumer did not pick up yet.
+    //--------------------------------------------------------------
+    void publish(void);
+
+    //--------------------------------------------------------------
+    /// \brief Producer: copy and hand over a page content
+    ///
+    /// \param[in]  page     [0-3] Page to render
+    /// \param[in]  content  Up to 160 characters, row by row. Shorter content is filled with spaces.
+    //--------------------------------------------------------------
+    void post(int page, const char *content);
+
+    //--------------------------------------------------------------
+    /// \brief Consumer: pick up latest frame
+    ///
+    /// \return     Latest frame, or NULL if nothing new was published since the last call
+    //--------------------------------------------------------------
+    const displayFrame *receive(void);
+
+  private:
+    displayFrame _frames[MAILBOX_FRAMES];
+    volatile uint8_t _middle;                   // Index of handed-over frame, plus MAILBOX_FRESH if not picked up yet
+    uint8_t _back;                              // Index of producer's frame
+    uint8_t _front;                             // Index of consumer's frame
+
+    uint8_t exchangeMiddle(uint8_t value);
+};
+
+class displayTask
+{
+  public:
+
+    //--------------------------------------------------------------
+    /// \brief Class constructor
+    ///
+    /// Creates display task object, without starting a task yet.
+    ///
+    /// \param[in]  pDisplay  Display to render on
+    //--------------------------------------------------------------
+    displayTask(MS6205 *pDisplay);
+
+#if defined(ESP32)
+    //--------------------------------------------------------------
+    /// \brief Start FreeRTOS task
+    ///
+    /// From now on, use the display only through post().
+    ///
+    /// \param[in]  core       [0-1] Core to pin the task to
+    /// \param[in]  priority   FreeRTOS priority of the task
+    /// \param[in]  stackSize  [bytes] Stack size of the task
+    /// \return     true if the task was started
+    //--------------------------------------------------------------
+    bool begin(int core = DISPLAY_TASK_CORE, int priority = DISPLAY_TASK_PRIORITY, int stackSize = DISPLAY_TASK_STACK);
+#endif
+
+    //--------------------------------------------------------------
+    /// \brief Post page content to render
+    ///
+    /// Never blocks. If the previous frame was not rendered yet, it is replaced.
+    ///
+    /// \param[in]  page     [0-3] Page to render
+    /// \param[in]  content  Up to 160 characters, row by row. Shorter content is filled with spaces.
+    //--------------------------------------------------------------
+    void post(int page, const char *content);
+
+    //--------------------------------------------------------------
+    /// \brief Render latest frame
+    ///
+    /// Called by the task on the ESP32. Call in loop() on other platforms.
+    ///
+    /// \return     true if a frame was rendered
+    //--------------------------------------------------------------
+    bool update(void);
+
+    //--------------------------------------------------------------
+    /// \brief Frame to fill in place
+    ///
+    /// Avoids the copy made by post(). Fill the frame and call publish().
+    ///
+    /// \return     Frame to fill
+    //--------------------------------------------------------------
+    displayFrame *back(void);
+
+    //--------------------------------------------------------------
+    /// \brief Hand over frame filled in place
+    ///
+    /// Never blocks. If the previous frame was not rendered yet, it is replaced.
+    //--------------------------------------------------------------
+    void publish(void);
+
+  private:
+    frameMailbox _mailbox;
+    MS6205 * _pDisplay;           // Pointer to display to render on
+
+    void wake(void);
+
+#if defined(ESP32)
+    TaskHandle_t _task;           // FreeRTOS task, NULL if not started
+
+    static void run(void *parameter);
+#endif
+};
+
+#endif // MS6205_TASK_H
@@ -0,0 +1,434 @@
+/*
+  MS6205_template.h - Compile-time configured variant of the MS6205 library for fixed wiring.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+
+  COMPILE-TIME CONFIGURATION
+  ===========================
+   MS6205T takes all pins and optional features as template parameters:
+
+     MS6205T<15, 14, 13, 12, 2, 5> display;                                    // Like MS6205 display(15, 14, 13, 12, 2, 5)
+     MS6205T<15, 14, 13, 12, 2, 5, MS6205T_PAGING | MS6205T_CURSOR, 4, 0, 16> display;   // With paging 2A/2B and cursor 8A
+
+   Every pin operation becomes a write of a constant to a GPIO register where the core allows it
+   (ATmega328P/168, ESP8266, ESP32); elsewhere, and in host builds, digitalWrite() is used.
+   Features not selected compile away, and so do their checks. The object only holds the address.
+
+   MS6205T covers the direct write methods: setCursor(), addCursor(), write(), writeCharacter(),
+   writeBlock(), clear(), showPage(), showCursor() and hideCursor(). Page cache, queued writes and
+   transports other than the 74HC595 need state and stay with the runtime class MS6205, which is
+   the right choice if pins are only known at runtime or any of those is used.
+*/
+
+#ifndef MS6205_TEMPLATE_H
+#define MS6205_TEMPLATE_H
+
+#include "Arduino.h"
+#include "MS6205.h"
+
+#if defined(ESP32)
+#include "soc/gpio_reg.h"
+#endif
+
+#define MS6205T_NO_PIN            255   // Pin parameter of a feature not used
+
+#define MS6205T_PAGING           0x01   // Select pages through 2A and 2B
+#define MS6205T_CURSOR           0x02   // Show and hide the cursor through 8A
+
+#define MS6205T_HOLD_TIME_US        1   // [us] Hold time of control lines, same as the runtime class
+
+//--------------------------------------------------------------
+/// \brief Output pin known at compile time
+///
+/// \tparam  Pin  CPU pin
+//--------------------------------------------------------------
+template <uint8_t Pin>
+struct fastPin
+{
+  static void output(void)
+  {
+    pinMode(Pin, OUTPUT);
+  }
+
+#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega168__)
+  static constexpr uint8_t mask(void)
+  {
+    return (uint8_t)(1 << ((Pin < 8) ? Pin : ((Pin < 14) ? (Pin - 8) : ((Pin - 14) & 0x07))));
+  }
+
+  static void high(void)
+  {
+    if (Pin < 8)                        // Each branch folds to a single sbi instruction
+    {
+      PORTD |= mask();
+    }
+    else if (Pin < 14)
+    {
+      PORTB |= mask();
+    }
+    else
+    {
+      PORTC |= mask();
+    }
+  }
+
+  static void low(void)
+  {
+    if (Pin < 8)                        // Each branch folds to a single cbi instruction
+    {
+      PORTD &= (uint8_t)~mask();
+    }
+    else if (Pin < 14)
+    {
+      PORTB &= (uint8_t)~mask();
+    }
+    else
+    {
+      PORTC &= (uint8_t)~mask();
+    }
+  }
+#elif defined(ESP8266)
+  static void high(void)
+  {
+    if (Pin < 16)
+    {
+      GPOS = (1UL << (Pin & 0x0F));     // Set register, no read-modify-write
+    }
+    else
+    {
+      digitalWrite(Pin, HIGH);          // GPIO16 sits in the RTC block
+    }
+  }
+
+  static void low(void)
+  {
+    if (Pin < 16)
+    {
+      GPOC = (1UL << (Pin & 0x0F));     // Clear register, no read-modify-write
+    }
+    else
+    {
+      digitalWrite(Pin, LOW);
+    }
+  }
+#elif defined(ESP32)
+  static void high(void)
+  {
+    if (Pin < 32)
+    {
+      REG_WRITE(GPIO_OUT_W1TS_REG, 1UL << (Pin & 0x1F));
+    }
+    else
+    {
+#if defined(GPIO_OUT1_W1TS_REG)
+      REG_WRITE(GPIO_OUT1_W1TS_REG, 1UL << (Pin & 0x1F));
+#else
+      digitalWrite(Pin, HIGH);
+#endif
+    }
+  }
+
+  static void low(void)
+  {
+    if (Pin < 32)
+    {
+      REG_WRITE(GPIO_OUT_W1TC_REG, 1UL << (Pin & 0x1F));
+    }
+    else
+    {
+#if defined(GPIO_OUT1_W1TC_REG)
+      REG_WRITE(GPIO_OUT1_W1TC_REG, 1UL << (Pin & 0x1F));
+#else
+      digitalWrite(Pin, LOW);
+#endif
+    }
+  }
+#else
+  #define MS6205T_DIGITAL_WRITE                                 // No register access known for this core
+
+  static void high(void)
+  {
+    digitalWrite(Pin, HIGH);
+  }
+
+  static void low(void)
+  {
+    digitalWrite(Pin, LOW);
+  }
+#endif
+
+  static void write(bool value)
+  {
+#if defined(MS6205T_DIGITAL_WRITE)
+    digitalWrite(Pin, value ? HIGH : LOW);                      // No branch on the data bits
+#else
+    if (value)
+    {
+      high();
+    }
+    else
+    {
+      low();
+    }
+#endif
+  }
+
+  static void pulseLow(void)
+  {
+    low();                                                      // Pull control line low
+    delayMicroseconds(MS6205T_HOLD_TIME_US);                    // Hold for proper delay
+    high();                                                     // Pull control line high to apply
+    delayMicroseconds(MS6205T_HOLD_TIME_US);                    // Hold for proper delay
+  }
+};
+
+//--------------------------------------------------------------
+/// \brief MS6205 display with pins and features fixed at compile time
+///
+/// \tparam  LatchPin         CPU pin connected to 74HC595 shift register "latch" pin 12
+/// \tparam  ClockPin         CPU pin connected to 74HC595 shift register "clock" pin 11
+/// \tparam  DataPin          CPU pin connected to 74HC595 shift register "data" pin 14
+/// \tparam  SetCursorPin     CPU pin connected to MS6205 display "set cursor" pin 16A
+/// \tparam  SetCharacterPin  CPU pin connected to MS6205 display "set character" pin 16B
+/// \tparam  ClearPin         CPU pin connected to MS6205 display "clear" pin 18A
+/// \tparam  Features         MS6205T_PAGING and/or MS6205T_CURSOR, or 0
+/// \tparam  SelectPage0Pin   CPU pin connected to MS6205 display "select page 0" pin 2A, with MS6205T_PAGING
+/// \tparam  SelectPage1Pin   CPU pin connected to MS6205 display "select page 1" pin 2B, with MS6205T_PAGING
+/// \tparam  ShowCursorPin    CPU pin connected to MS6205 display "show cursor" pin 8A, with MS6205T_CURSOR
+//--------------------------------------------------------------
+template <uint8_t LatchPin, uint8_t ClockPin, uint8_t DataPin, uint8_t SetCursorPin, uint8_t SetCharacterPin, uint8_t ClearPin,
+          uint8_t Features = 0, uint8_t SelectPage0Pin = MS6205T_NO_PIN, uint8_t SelectPage1Pin = MS6205T_NO_PIN,
+          uint8_t ShowCursorPin = MS6205T_NO_PIN>
+class MS6205T
+{
+  static_assert(((Features & MS6205T_PAGING) == 0) || ((SelectPage0Pin != MS6205T_NO_PIN) && (SelectPage1Pin != MS6205T_NO_PIN)),
+                "MS6205T_PAGING needs SelectPage0Pin and SelectPage1Pin");
+  static_assert(((Features & MS6205T_CURSOR) == 0) || (ShowCursorPin != MS6205T_NO_PIN),
+                "MS6205T_CURSOR needs ShowCursorPin");
+
+  public:
+
+    //--------------------------------------------------------------
+    /// \brief Class constructor
+    ///
+    /// Does not touch the hardware, like MS6205(). Call begin() in setup().
+    //--------------------------------------------------------------
+    MS6205T(void) : _address(0)
+    {
+    }
+
+    //--------------------------------------------------------------
+    /// \brief Initialize display
+    ///
+    /// Initializes pins and selects page 0, like MS6205::begin(). There is no deferred clear,  \
+    /// as it would cost a check in every write: BEGIN_CLEAR_DEFERRED clears at once.
+    ///
+    /// \param[in]  mode  BEGIN_CLEAR or BEGIN_NO_CLEAR
+    //--------------------------------------------------------------
+    void begin(int mode = BEGIN_CLEAR)
+    {
+      fastPin<LatchPin>::output();
+      fastPin<ClockPin>::output();
+      fastPin<DataPin>::output();
+      fastPin<SetCursorPin>::output();
+      fastPin<SetCharacterPin>::output();
+      fastPin<ClearPin>::output();
+
+      fastPin<SetCursorPin>::high();
+      fastPin<SetCharacterPin>::high();
+      fastPin<ClearPin>::high();
+
+      if (Features & MS6205T_PAGING)
+      {
+        fastPin<SelectPage0Pin>::output();
+        fastPin<SelectPage1Pin>::output();
+      }
+      if (Features & MS6205T_CURSOR)
+      {
+        fastPin<ShowCursorPin>::output();
+        hideCursor();
+      }
+
+      showPage(0);
+      setCursor(0, 0);
+      if (mode != BEGIN_NO_CLEAR)
+      {
+        clear();
+      }
+    }
+
+    //--------------------------------------------------------------
+    /// \brief Set cursor
+    ///
+    /// \param[in]  column  Display column to write to, 0 (left) to 15 (right)
+    /// \param[in]  row     Display row to write to, 0 (upper) to 9 (lower)
+    //--------------------------------------------------------------
+    void setCursor(int column, int row)
+    {
+      writeAddress(cellAddress(column, row));
+    }
+
+    //--------------------------------------------------------------
+    /// \brief Increment cursor
+    ///
+    /// \param[in]  n  Positions to add to the current cursor position, wrapping around
+    //--------------------------------------------------------------
+    void addCursor(int n)
+    {
+      int address = _address + n;
+      if (address >= NUMBER_OF_CHARACTERS)
+      {
+        address -= NUMBER_OF_CHARACTERS;                        // Wrap around to the start
+      }
+      writeAddress(address);
+    }
+
+    //--------------------------------------------------------------
+    /// \brief Write text to display
+    ///
+    /// Writes at the current cursor position and advances it, wrapping around like MS6205::write().
+    ///
+    /// \param[in]  text  Text to display
+    //--------------------------------------------------------------
+    void write(const char *text)
+    {
+      for (; *text != '\0'; text++)
+      {
+        writeCharacter((char)toUpperCase(*text));               // MS6205 only supports uppercase latin letters
+        writeAddress((_address + 1 < NUMBER_OF_CHARACTERS) ? _address + 1 : 0);
+      }
+    }
+
+    void write(const String &text)
+    {
+      write(text.c_str());
+    }
+
+    //--------------------------------------------------------------
+    /// \brief Write single character at the current cursor position
+    ///
+    /// \param[in]  character  Character to display
+    //--------------------------------------------------------------
+    void writeCharacter(char character)
+    {
+      writeByte(busData(character));
+      fastPin<SetCharacterPin>::pulseLow();                     // Take over character from data lines
+    }
+
+    //--------------------------------------------------------------
+    /// \brief Write single character at a given position
+    ///
+    /// \param[in]  column     Display column to write to, 0 (left) to 15 (right)
+    /// \param[in]  row        Display row to write to, 0 (upper) to 9 (lower)
+    /// \param[in]  character  Character to display
+    //--------------------------------------------------------------
+    void writeCharacter(int column, int row, char character)
+    {
+      setCursor(column, row);
+      writeCharacter(character);
+    }
+
+    //--------------------------------------------------------------
+    /// \brief Write single "block" character at a given position
+    ///
+    /// \param[in]  column  Display column to write to, 0 (left) to 15 (right)
+    /// \param[in]  row     Display row to write to, 0 (upper) to 9 (lower)
+    //--------------------------------------------------------------
+    void writeBlock(int column, int row)
+    {
+      writeCharacter(column, row, (char)127);
+    }
+
+    //--------------------------------------------------------------
+    /// \brief Clear the display
+    //--------------------------------------------------------------
+    void clear(void)
+    {
+      fastPin<ClearPin>::low();                                 // Pull "Clear" control line low to clear everything
+      delay(20);                                                // Hold for 20 ms, according to MS6205 datasheet
+      fastPin<ClearPin>::high();
+    }
+
+    //--------------------------------------------------------------
+    /// \brief Set visible page, with MS6205T_PAGING only
+    ///
+    /// \param[in]  page  [0-3] Page to display
+    //--------------------------------------------------------------
+    void showPage(int page)
+    {
+      if (Features & MS6205T_PAGING)
+      {
+        page = constrain(page, 0, NUMBER_OF_PAGES - 1);
+        fastPin<SelectPage0Pin>::write((page & 0x01) == 0);     // Page select lines are inverted
+        fastPin<SelectPage1Pin>::write((page & 0x02) == 0);
+      }
+    }
+
+    //--------------------------------------------------------------
+    /// \brief Show cursor, with MS6205T_CURSOR only
+    //--------------------------------------------------------------
+    void showCursor(void)
+    {
+      if (Features & MS6205T_CURSOR)
+      {
+        fastPin<ShowCursorPin>::high();                         // A high signal shows a black box at set position
+      }
+    }
+
+    //--------------------------------------------------------------
+    /// \brief Hide cursor, with MS6205T_CURSOR only
+    //--------------------------------------------------------------
+    void hideCursor(void)
+    {
+      if (Features & MS6205T_CURSOR)
+      {
+        fastPin<ShowCursorPin>::low();                          // A low signal hides the cursor
+      }
+    }
+
+  private:
+    uint8_t _address;                                           // Where the display's address counter points to
+
+    void writeAddress(int address)
+    {
+      _address = (uint8_t)address;
+      writeByte(_address);
+      fastPin<SetCursorPin>::pulseLow();                        // Take over address from address lines
+    }
+
+    static void writeByte(uint8_t data)
+    {
+      // --- Same bit sequence as shiftOut(MSBFIRST), with constant pins ---
+      fastPin<LatchPin>::low();
+      for (uint8_t bit = 0x80; bit != 0; bit >>= 1)
+      {
+        fastPin<DataPin>::write((data & bit) != 0);
+        fastPin<ClockPin>::high();
+        fastPin<ClockPin>::low();
+      }
+      fastPin<LatchPin>::high();                                // Switch outputs to the new byte
+    }
+};
+
+#endif // MS6205_TEMPLATE_H
@@ -0,0 +1,257 @@
+/*
+  MS6205_transition.cpp - Screen transition effects for a MS6205 vintage soviet character display.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_transition.h"
+
+#define LFSR_TAPS                0xB8   // Taps of an 8-bit Galois LFSR, all 255 states except 0 in turn
+
+//--------------------------------------------------------------
+/// \brief Class constructor
+///
+/// Creates transition object, without running anything yet.
+///
+/// \param[in]  pDisplay  Display to change
+//--------------------------------------------------------------
+screenTransition::screenTransition(MS6205 *pDisplay)
+{
+  _pDisplay = pDisplay;
+  _content = NULL;
+  _length = 0;
+  _effect = TRANSITION_WIPE;
+  _duration = 0;
+  _millis = 0;
+  _total = 0;
+  _written = 0;
+  _step = 0;
+  _index = 0;
+  _lfsr = 1;
+} // screenTransition()
+
+//--------------------------------------------------------------
+/// \brief Start transition of the visible page
+///
+/// A running transition is finished first.
+///
+/// \param[in]  content   Up to 160 characters, row by row, spaces after them. Must stay valid until done.
+/// \param[in]  effect    TRANSITION_WIPE, TRANSITION_DISSOLVE or TRANSITION_SLIDE
+/// \param[in]  duration  [ms] Time until the new content is shown completely
+//--------------------------------------------------------------
+void screenTransition::start(const char *content, int effect, unsigned int duration)
+{
+  if ((_pDisplay == NULL) || (content == NULL))
+  {
+    return;
+  }
+
+  finish();
+
+  _content = content;
+  _length = strnlen(content, NUMBER_OF_CHARACTERS);
+  _effect = constrain(effect, TRANSITION_WIPE, TRANSITION_SLIDE);
+  _duration = duration;
+  _millis = millis();
+  _written = 0;
+  _step = 0;
+  _index = 0;
+  _lfsr = random(1, 256);                                       // Different order every time
+
+  // --- Count cell changes of all steps, to spread them evenly ---
+  _total = 0;
+  for (int step = 0; step < steps(); step++)
+  {
+    for (int address = 0; address < NUMBER_OF_CHARACTERS; address++)
+    {
+      _total += changes(step, address) ? 1 : 0;
+    }
+  }
+} // start()
+
+//--------------------------------------------------------------
+/// \brief Periodic update
+///
+/// Call in loop() method.
+///
+/// \return     true while the transition is running
+//--------------------------------------------------------------
+bool screenTransition::update(void)
+{
+  if (_content == NULL)
+  {
+    return false;
+  }
+
+  unsigned long elapsed = millis() - _millis;
+  if (elapsed >= _duration)
+  {
+    advance(NUMBER_OF_CHARACTERS * NUMBER_OF_ROWS);             // All the rest, whatever changed meanwhile
+  }
+  else
+  {
+    advance((unsigned long)_total * elapsed / _duration);
+  }
+  return _content != NULL;
+} // update()
+
+//--------------------------------------------------------------
+/// \brief Show the new content completely now
+//--------------------------------------------------------------
+void screenTransition::finish(void)
+{
+  if (_content != NULL)
+  {
+    advance(NUMBER_OF_CHARACTERS * NUMBER_OF_ROWS);
+  }
+} // finish()
+
+//--------------------------------------------------------------
+/// \brief Check if running
+///
+/// \return     true while the transition is running
+//--------------------------------------------------------------
+bool screenTransition::running(void)
+{
+  return _content != NULL;
+} // running()
+
+//--------------------------------------------------------------
+/// \brief Cells of the transition
+///
+/// \return     Number of cell changes start() counted, all steps together
+//--------------------------------------------------------------
+int screenTransition::cells(void)
+{
+  return _total;
+} // cells()
+
+//--------------------------------------------------------------
+/// \brief Queue and flush cell changes
+///
+/// \param[in]  due  Number of cell changes that should be written by now, since start()
+//--------------------------------------------------------------
+void screenTransition::advance(unsigned long due)
+{
+  while ((unsigned long)_written < due)
+  {
+    int address = nextCell();
+    if (address < 0)
+    {
+      _content = NULL;                                          // Done
+      break;
+    }
+
+    if (changes(_step, address))
+    {
+      _pDisplay->queueCharacter(address & 0x0F, address >> 4, frameCharacter(_step, address));
+      _written++;
+    }
+  }
+  _pDisplay->flush();
+} // advance()
+
+//--------------------------------------------------------------
+/// \brief Next cell in the effect's order
+///
+/// \return     0 (left-upper corner) to 159 (lower right corner), -1 after the last step
+//--------------------------------------------------------------
+int screenTransition::nextCell(void)
+{
+  while (_step < steps())
+  {
+    int count = (_effect == TRANSITION_SLIDE) ? (_step + 1) * NUMBER_OF_COLUMNS : NUMBER_OF_CHARACTERS;
+    if (_index < count)
+    {
+      int i = _index++;
+      if (_effect == TRANSITION_WIPE)
+      {
+        return (i / NUMBER_OF_ROWS) | ((i % NUMBER_OF_ROWS) << 4);       // Column by column
+      }
+      if (_effect == TRANSITION_DISSOLVE)
+      {
+        do
+        {
+          _lfsr = (_lfsr >> 1) ^ ((_lfsr & 0x01) ? LFSR_TAPS : 0);
+        } while (_lfsr > NUMBER_OF_CHARACTERS);                 // Every state 1..160 once per 255 steps
+        return _lfsr - 1;
+      }
+      return i;                                                 // Rows covered by this slide step
+    }
+    _step++;
+    _index = 0;
+  }
+  return -1;
+} // nextCell()
+
+//--------------------------------------------------------------
+/// \brief Number of steps of the effect
+///
+/// \return     NUMBER_OF_ROWS for TRANSITION_SLIDE, 1 for the other effects
+//--------------------------------------------------------------
+int screenTransition::steps(void)
+{
+  return (_effect == TRANSITION_SLIDE) ? NUMBER_OF_ROWS : 1;
+} // steps()
+
+//--------------------------------------------------------------
+/// \brief Character of a cell after a step
+///
+/// TRANSITION_SLIDE step s shows the lowest s + 1 rows of the new content in the upper rows;   \
+/// rows below still show the old content, which is the page model, as the slide has not       \
+/// written them yet.
+///
+/// \param[in]  step     Step of TRANSITION_SLIDE, 0 for the other effects
+/// \param[in]  address  0 (left-upper corner) to 159 (lower right corner)
+/// \return     Character
+//--------------------------------------------------------------
+char screenTransition::frameCharacter(int step, int address)
+{
+  int row = address >> 4;
+  if (_effect == TRANSITION_SLIDE)
+  {
+    if (row > step)
+    {
+      return _pDisplay->pageCharacter(_pDisplay->currentPage(), address);
+    }
+    address += (NUMBER_OF_ROWS - 1 - step) << 4;                // Row of the new content shown here
+  }
+  return (address < _length) ? (_content[address] & 0x7F) : ' ';
+} // frameCharacter()
+
+//--------------------------------------------------------------
+/// \brief Check if a step changes a cell
+///
+/// \param[in]  step     Step of TRANSITION_SLIDE, 0 for the other effects
+/// \param[in]  address  0 (left-upper corner) to 159 (lower right corner)
+/// \return     true if the cell shows another character after the step than before
+//--------------------------------------------------------------
+bool screenTransition::changes(int step, int address)
+{
+  char before = (step > 0) ? frameCharacter(step - 1, address)
+                           : _pDisplay->pageCharacter(_pDisplay->currentPage(), address);
+  return frameCharacter(step, address) != before;
+} // changes()
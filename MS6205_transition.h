@@ -0,0 +1,126 @@
+/*
+  MS6205_transition.h - Screen transition effects for a MS6205 vintage soviet character display.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+
+  TRANSITIONS
+  ===============
+   screenTransition changes the visible page from what it shows into new content step by step:
+
+     TRANSITION_WIPE      New content sweeps in column by column, from left to right
+     TRANSITION_DISSOLVE  Cells change in pseudo-random order
+     TRANSITION_SLIDE     New content slides down from the top, one row per step, covering the old one
+
+   Only cells that change are written, and they are spread evenly over the duration: start()
+   counts the cells to write, and every update() writes as many as are due by then. So the bus load
+   per update() is flat, and update() never blocks. Cells are queued and flushed, so the planner
+   picks the cheapest address moves. The page model is the starting frame, so no copy of the old
+   content is needed.
+*/
+
+#ifndef MS6205_TRANSITION_H
+#define MS6205_TRANSITION_H
+
+#include "Arduino.h"
+#include "MS6205.h"
+
+#define TRANSITION_WIPE             0   // Column by column, from left to right
+#define TRANSITION_DISSOLVE         1   // Cells in pseudo-random order
+#define TRANSITION_SLIDE            2   // New content slides down from the top
+
+#define TRANSITION_DURATION_MS    500   // [ms] Default duration of a transition
+
+class screenTransition
+{
+  public:
+
+    //--------------------------------------------------------------
+    /// \brief Class constructor
+    ///
+    /// Creates transition object, without running anything yet.
+    ///
+    /// \param[in]  pDisplay  Display to change
+    //--------------------------------------------------------------
+    screenTransition(MS6205 *pDisplay);
+
+    //--------------------------------------------------------------
+    /// \brief Start transition of the visible page
+    ///
+    /// A running transition is finished first.
+    ///
+    /// \param[in]  content   Up to 160 characters, row by row, spaces after them. Must stay valid until done.
+    /// \param[in]  effect    TRANSITION_WIPE, TRANSITION_DISSOLVE or TRANSITION_SLIDE
+    /// \param[in]  duration  [ms] Time until the new content is shown completely
+    //--------------------------------------------------------------
+    void start(const char *content, int effect = TRANSITION_WIPE, unsigned int duration = TRANSITION_DURATION_MS);
+
+    //--------------------------------------------------------------
+    /// \brief Periodic update
+    ///
+    /// Call in loop() method.
+    ///
+    /// \return     true while the transition is running
+    //--------------------------------------------------------------
+    bool update(void);
+
+    //--------------------------------------------------------------
+    /// \brief Show the new content completely now
+    //--------------------------------------------------------------
+    void finish(void);
+
+    //--------------------------------------------------------------
+    /// \brief Check if running
+    ///
+    /// \return     true while the transition is running
+    //--------------------------------------------------------------
+    bool running(void);
+
+    //--------------------------------------------------------------
+    /// \brief Cells of the transition
+    ///
+    /// \return     Number of cell changes start() counted, all steps together
+    //--------------------------------------------------------------
+    int cells(void);
+
+  private:
+    const char *_content;         // New content, NULL if no transition is running
+    int _length;                  // [characters] Length of new content, spaces after it
+    int _effect;                  // TRANSITION_WIPE, TRANSITION_DISSOLVE or TRANSITION_SLIDE
+    unsigned int _duration;       // [ms] Time until the new content is shown completely
+    unsigned long _millis;        // [ms] Start time
+    int _total;                   // Cell changes of all steps
+    int _written;                 // Cell changes queued so far
+    int _step;                    // Step of TRANSITION_SLIDE, 0 for the other effects
+    int _index;                   // Next cell of the step, in the effect's order
+    uint8_t _lfsr;                // State of the pseudo-random order of TRANSITION_DISSOLVE
+    MS6205 * _pDisplay;           // Pointer to display to change
+
+    void advance(unsigned long due);
+    int nextCell(void);
+    int steps(void);
+    char frameCharacter(int step, int address);
+    bool changes(int step, int address);
+};
+
+#endif // MS6205_TRANSITION_H
@@ -0,0 +1,249 @@
+/*
+  MS6205_virtual.cpp - Virtual screens mapped onto the pages of a MS6205 vintage soviet character display.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_virtual.h"
+
+//--------------------------------------------------------------
+/// \brief Class constructor
+///
+/// Without paging (see beginPaging()), pages has to be 1.
+///
+/// \param[in]  pDisplay  Display to show screens on
+/// \param[in]  pages     Number of hardware pages to use, from page 0 up
+//--------------------------------------------------------------
+screenManager::screenManager(MS6205 *pDisplay, int pages)
+{
+  _pDisplay = pDisplay;
+  _pages = constrain(pages, 1, NUMBER_OF_PAGES);
+  memset(_screens, 0, sizeof(_screens));
+  memset(_resident, VIRTUAL_NONE, sizeof(_resident));
+  memset(_used, 0, sizeof(_used));
+  _clock = 0;
+  _count = 0;
+  _visible = VIRTUAL_NONE;
+  resetCounters();
+} // screenManager()
+
+//--------------------------------------------------------------
+/// \brief Add screen
+///
+/// \param[in]  content  Up to 160 characters, row by row, spaces after them. Must stay valid.
+///
+/// \return     Screen number, VIRTUAL_NONE if VIRTUAL_SCREENS screens were added already
+//--------------------------------------------------------------
+int screenManager::addScreen(const char *content)
+{
+  if ((_count >= VIRTUAL_SCREENS) || (content == NULL))
+  {
+    return VIRTUAL_NONE;
+  }
+
+  virtualScreen &screen = _screens[_count];
+  screen.content = content;
+  screen.page = VIRTUAL_NONE;
+  screen.dirty = false;
+  screen.pinned = false;
+  return _count++;
+} // addScreen()
+
+//--------------------------------------------------------------
+/// \brief Show screen
+///
+/// Selects the screen's page if it is resident. Otherwise evicts the least recently shown          \
+/// page that is not pinned and writes the cells that differ.
+///
+/// \param[in]  screen  Screen number from addScreen()
+///
+/// \return     false if the screen is unknown or all pages are pinned to other screens
+//--------------------------------------------------------------
+bool screenManager::show(int screen)
+{
+  if ((_pDisplay == NULL) || (screen < 0) || (screen >= _count))
+  {
+    return false;
+  }
+
+  virtualScreen &s = _screens[screen];
+  if (s.page != VIRTUAL_NONE)                                   // Resident:
+  {
+    _counters.hits++;
+    if (s.dirty)
+    {
+      _pDisplay->renderPage(s.page, s.content);                 // Selects the page, writes what changed meanwhile
+      s.dirty = false;
+    }
+    else
+    {
+      _pDisplay->showPage(s.page);                              // Nothing to write
+    }
+  }
+  else
+  {
+    int page = victim();
+    if (page == VIRTUAL_NONE)
+    {
+      return false;                                             // All pages pinned
+    }
+
+    _counters.misses++;
+    if (_resident[page] != VIRTUAL_NONE)
+    {
+      _screens[_resident[page]].page = VIRTUAL_NONE;
+      _counters.evictions++;
+    }
+    _resident[page] = screen;
+    s.page = page;
+    _pDisplay->renderPage(page, s.content);                     // Writes only cells that differ from the page's old content
+    s.dirty = false;
+  }
+
+  _used[s.page] = ++_clock;
+  _visible = screen;
+  return true;
+} // show()
+
+//--------------------------------------------------------------
+/// \brief Content of screen changed
+///
+/// Writes the cells that differ if the screen is visible, otherwise when it is shown next.
+///
+/// \param[in]  screen   Screen number from addScreen()
+/// \param[in]  content  New content, NULL to keep the buffer, which was changed in place
+//--------------------------------------------------------------
+void screenManager::changed(int screen, const char *content)
+{
+  if ((screen < 0) || (screen >= _count))
+  {
+    return;
+  }
+
+  virtualScreen &s = _screens[screen];
+  if (content != NULL)
+  {
+    s.content = content;
+  }
+
+  if ((screen == _visible) && (s.page != VIRTUAL_NONE) && (_pDisplay != NULL))
+  {
+    _pDisplay->renderPage(s.page, s.content);
+    s.dirty = false;
+  }
+  else
+  {
+    s.dirty = true;
+  }
+} // changed()
+
+//--------------------------------------------------------------
+/// \brief Pin screen to its page
+///
+/// A pinned screen is never evicted. Pinning a screen that is not resident shows it.
+///
+/// \param[in]  screen  Screen number from addScreen()
+/// \param[in]  pinned  true to pin, false to release
+///
+/// \return     false if the screen could not get a page
+//--------------------------------------------------------------
+bool screenManager::pin(int screen, bool pinned)
+{
+  if ((screen < 0) || (screen >= _count))
+  {
+    return false;
+  }
+
+  if (pinned && (_screens[screen].page == VIRTUAL_NONE) && (show(screen) == false))
+  {
+    return false;
+  }
+  _screens[screen].pinned = pinned;
+  return true;
+} // pin()
+
+//--------------------------------------------------------------
+/// \brief Page of a screen
+///
+/// \param[in]  screen  Screen number from addScreen()
+///
+/// \return     Hardware page holding the screen, VIRTUAL_NONE if not resident
+//--------------------------------------------------------------
+int screenManager::pageOf(int screen)
+{
+  return ((screen >= 0) && (screen < _count)) ? _screens[screen].page : VIRTUAL_NONE;
+} // pageOf()
+
+//--------------------------------------------------------------
+/// \brief Visible screen
+///
+/// \return     Screen number, VIRTUAL_NONE before the first show()
+//--------------------------------------------------------------
+int screenManager::visible(void)
+{
+  return _visible;
+} // visible()
+
+//--------------------------------------------------------------
+/// \brief Get counters
+///
+/// \return     Counters since construction or resetCounters()
+//--------------------------------------------------------------
+const virtualCounters &screenManager::counters(void)
+{
+  return _counters;
+} // counters()
+
+//--------------------------------------------------------------
+/// \brief Reset counters
+//--------------------------------------------------------------
+void screenManager::resetCounters(void)
+{
+  memset(&_counters, 0, sizeof(_counters));
+} // resetCounters()
+
+//--------------------------------------------------------------
+/// \brief Choose page for a screen that is not resident
+///
+/// \return     Free page, else least recently shown page without a pinned screen,                  \
+///             VIRTUAL_NONE if all pages are pinned
+//--------------------------------------------------------------
+int screenManager::victim(void)
+{
+  int oldest = VIRTUAL_NONE;
+  for (int page = 0; page < _pages; page++)
+  {
+    if (_resident[page] == VIRTUAL_NONE)
+    {
+      return page;
+    }
+    if ((_screens[_resident[page]].pinned == false) && ((oldest == VIRTUAL_NONE) || (_used[page] < _used[oldest])))
+    {
+      oldest = page;
+    }
+  }
+  return oldest;
+} // victim()
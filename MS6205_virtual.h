@@ -0,0 +1,167 @@
+/*
+  MS6205_virtual.h - Virtual screens mapped onto the pages of a MS6205 vintage soviet character display.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+
+  VIRTUAL SCREENS
+  ===============
+   screenManager shows any number of screens, held in RAM by the sketch, on the display's hardware
+   pages. A screen that is resident on a page is shown by selecting the page only. Any other screen
+   takes over the least recently shown page that is not pinned, and only the cells where it differs
+   from what the page held are written (see renderPage()).
+
+     screen:   0   1   2   3   4   5   6   7   8   9  10  11
+     page:     -   2   -   0   -   -   1   -   -   3   -   -      0 pinned, 1..3 least recently used first
+
+   After changing a screen's content, call changed(): a visible screen is written at once, others
+   when they are shown next.
+*/
+
+#ifndef MS6205_VIRTUAL_H
+#define MS6205_VIRTUAL_H
+
+#include "Arduino.h"
+#include "MS6205.h"
+
+#ifndef VIRTUAL_SCREENS
+  #define VIRTUAL_SCREENS          16   // Screens managed, 4 bytes RAM each plus the sketch's content
+#endif
+
+#define VIRTUAL_NONE               -1   // No screen or page
+
+struct virtualCounters
+{
+  unsigned long hits;             // show() of a resident screen
+  unsigned long misses;           // show() that wrote a screen onto a page
+  unsigned long evictions;        // Misses that replaced another screen
+};
+
+class screenManager
+{
+  public:
+
+    //--------------------------------------------------------------
+    /// \brief Class constructor
+    ///
+    /// Without paging (see beginPaging()), pages has to be 1.
+    ///
+    /// \param[in]  pDisplay  Display to show screens on
+    /// \param[in]  pages     Number of hardware pages to use, from page 0 up
+    //--------------------------------------------------------------
+    screenManager(MS6205 *pDisplay, int pages = NUMBER_OF_PAGES);
+
+    //--------------------------------------------------------------
+    /// \brief Add screen
+    ///
+    /// \param[in]  content  Up to 160 characters, row by row, spaces after them. Must stay valid.
+    ///
+    /// \return     Screen number, VIRTUAL_NONE if VIRTUAL_SCREENS screens were added already
+    //--------------------------------------------------------------
+    int addScreen(const char *content);
+
+    //--------------------------------------------------------------
+    /// \brief Show screen
+    ///
+    /// Selects the screen's page if it is resident. Otherwise evicts the least recently shown
+    /// page that is not pinned and writes the cells that differ.
+    ///
+    /// \param[in]  screen  Screen number from addScreen()
+    ///
+    /// \return     false if the screen is unknown or all pages are pinned to other screens
+    //--------------------------------------------------------------
+    bool show(int screen);
+
+    //--------------------------------------------------------------
+    /// \brief Content of screen changed
+    ///
+    /// Writes the cells that differ if the screen is visible, otherwise when it is shown next.
+    ///
+    /// \param[in]  screen   Screen number from addScreen()
+    /// \param[in]  content  New content, NULL to keep the buffer, which was changed in place
+    //--------------------------------------------------------------
+    void changed(int screen, const char *content = NULL);
+
+    //--------------------------------------------------------------
+    /// \brief Pin screen to its page
+    ///
+    /// A pinned screen is never evicted. Pinning a screen that is not resident shows it.
+    ///
+    /// \param[in]  screen  Screen number from addScreen()
+    /// \param[in]  pinned  true to pin, false to release
+    ///
+    /// \return     false if the screen could not get a page
+    //--------------------------------------------------------------
+    bool pin(int screen, bool pinned = true);
+
+    //--------------------------------------------------------------
+    /// \brief Page of a screen
+    ///
+    /// \param[in]  screen  Screen number from addScreen()
+    ///
+    /// \return     Hardware page holding the screen, VIRTUAL_NONE if not resident
+    //--------------------------------------------------------------
+    int pageOf(int screen);
+
+    //--------------------------------------------------------------
+    /// \brief Visible screen
+    ///
+    /// \return     Screen number, VIRTUAL_NONE before the first show()
+    //--------------------------------------------------------------
+    int visible(void);
+
+    //--------------------------------------------------------------
+    /// \brief Get counters
+    ///
+    /// \return     Counters since construction or resetCounters()
+    //--------------------------------------------------------------
+    const virtualCounters &counters(void);
+
+    //--------------------------------------------------------------
+    /// \brief Reset counters
+    //--------------------------------------------------------------
+    void resetCounters(void);
+
+  private:
+    struct virtualScreen
+    {
+      const char *content;        // Content, row by row
+      int8_t page;                // Hardware page holding the screen, VIRTUAL_NONE if not resident
+      bool dirty;                 // Content changed since it was written to its page
+      bool pinned;                // Never evicted
+    };
+
+    virtualScreen _screens[VIRTUAL_SCREENS];   // Screens by number
+    int8_t _resident[NUMBER_OF_PAGES];         // Screen on each page, VIRTUAL_NONE if none
+    unsigned long _used[NUMBER_OF_PAGES];      // Value of _clock when each page was shown last
+    unsigned long _clock;         // Counts show() calls, orders the pages by use
+    int _count;                   // Number of screens added
+    int _pages;                   // Number of hardware pages to use
+    int _visible;                 // Visible screen, VIRTUAL_NONE if none
+    virtualCounters _counters;    // Counters
+    MS6205 * _pDisplay;           // Pointer to display to show screens on
+
+    int victim(void);
+};
+
+#endif // MS6205_VIRTUAL_H
@@ -0,0 +1,297 @@
+/*
+  MS6205_window.cpp - Window stack for popups on a MS6205 vintage soviet character display.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_window.h"
+
+//--------------------------------------------------------------
+/// \brief Class constructor
+///
+/// Creates window stack without windows and with a blank background. Writes nothing yet.
+///
+/// \param[in]  pDisplay  Display to composite on
+//--------------------------------------------------------------
+windowStack::windowStack(MS6205 *pDisplay)
+{
+  _pDisplay = pDisplay;
+  memset(_windows, 0, sizeof(_windows));
+  memset(_order, WINDOW_NONE, sizeof(_order));
+  _count = 0;
+  _background = NULL;
+  _backgroundLength = 0;
+} // windowStack()
+
+//--------------------------------------------------------------
+/// \brief Set background
+///
+/// Writes the cells of the background which are not covered by a window and differ.
+///
+/// \param[in]  content  Up to 160 characters, row by row, spaces after them. NULL for a blank      \
+///                      background. Must stay valid while set.
+//--------------------------------------------------------------
+void windowStack::setBackground(const char *content)
+{
+  _background = content;
+  _backgroundLength = (content != NULL) ? strnlen(content, NUMBER_OF_CHARACTERS) : 0;
+  redraw();
+} // setBackground()
+
+//--------------------------------------------------------------
+/// \brief Open window on top of the others
+///
+/// Windows may reach beyond the screen, only the visible part is written.
+///
+/// \param[in]  column   Display column of upper left corner
+/// \param[in]  row      Display row of upper left corner
+/// \param[in]  width    [columns] Width of window
+/// \param[in]  height   [rows] Height of window
+/// \param[in]  content  Up to width * height characters, row by row, spaces after them. Must stay  \
+///                      valid while the window is open.
+///
+/// \return     Window handle, WINDOW_NONE if all WINDOW_LAYERS windows are open
+//--------------------------------------------------------------
+int windowStack::open(int column, int row, int width, int height, const char *content)
+{
+  if ((_count >= WINDOW_LAYERS) || (content == NULL))
+  {
+    return WINDOW_NONE;
+  }
+
+  int handle = 0;
+  while (layer(handle) >= 0)                                    // First free handle
+  {
+    handle++;
+  }
+
+  window &w = _windows[handle];
+  w.column = constrain(column, -NUMBER_OF_COLUMNS, NUMBER_OF_COLUMNS);
+  w.row = constrain(row, -NUMBER_OF_ROWS, NUMBER_OF_ROWS);
+  w.width = constrain(width, 1, NUMBER_OF_COLUMNS);
+  w.height = constrain(height, 1, NUMBER_OF_ROWS);
+  w.content = content;
+  w.length = strnlen(content, w.width * w.height);
+  _order[_count++] = handle;
+
+  redraw(w);
+  return handle;
+} // open()
+
+//--------------------------------------------------------------
+/// \brief Close window
+///
+/// Restores what is underneath from the other windows and the background.
+///
+/// \param[in]  window  Window handle from open()
+//--------------------------------------------------------------
+void windowStack::close(int window)
+{
+  int index = layer(window);
+  if (index < 0)
+  {
+    return;
+  }
+
+  for (; index < _count - 1; index++)                           // Remove from stack
+  {
+    _order[index] = _order[index + 1];
+  }
+  _order[--_count] = WINDOW_NONE;
+
+  redraw(_windows[window]);
+} // close()
+
+//--------------------------------------------------------------
+/// \brief Move window
+///
+/// \param[in]  window  Window handle from open()
+/// \param[in]  column  New display column of upper left corner
+/// \param[in]  row     New display row of upper left corner
+//--------------------------------------------------------------
+void windowStack::move(int window, int column, int row)
+{
+  if (layer(window) < 0)
+  {
+    return;
+  }
+
+  struct window &w = _windows[window];
+  struct window old = w;
+  w.column = constrain(column, -NUMBER_OF_COLUMNS, NUMBER_OF_COLUMNS);
+  w.row = constrain(row, -NUMBER_OF_ROWS, NUMBER_OF_ROWS);
+
+  // --- Bounding box of old and new position, queued together so uncovered cells are flushed with the rest ---
+  int left = (old.column < w.column) ? old.column : w.column;
+  int top = (old.row < w.row) ? old.row : w.row;
+  int right = ((old.column > w.column) ? old.column : w.column) + w.width;
+  int bottom = ((old.row > w.row) ? old.row : w.row) + w.height;
+  redraw(left, top, right - left, bottom - top);
+} // move()
+
+//--------------------------------------------------------------
+/// \brief Bring window to the top
+///
+/// \param[in]  window  Window handle from open()
+//--------------------------------------------------------------
+void windowStack::raise(int window)
+{
+  int index = layer(window);
+  if (index < 0)
+  {
+    return;
+  }
+
+  for (; index < _count - 1; index++)
+  {
+    _order[index] = _order[index + 1];
+  }
+  _order[_count - 1] = window;
+
+  redraw(_windows[window]);
+} // raise()
+
+//--------------------------------------------------------------
+/// \brief Replace content of a window
+///
+/// Also call it after changing the window's buffer.
+///
+/// \param[in]  window   Window handle from open()
+/// \param[in]  content  Up to width * height characters, row by row, spaces after them
+//--------------------------------------------------------------
+void windowStack::setContent(int window, const char *content)
+{
+  if ((layer(window) < 0) || (content == NULL))
+  {
+    return;
+  }
+
+  struct window &w = _windows[window];
+  w.content = content;
+  w.length = strnlen(content, w.width * w.height);
+  redraw(w);
+} // setContent()
+
+//--------------------------------------------------------------
+/// \brief Composite rectangle again
+///
+/// Call it after changing the background buffer. Writes only the cells which differ.
+///
+/// \param[in]  column  Display column of upper left corner
+/// \param[in]  row     Display row of upper left corner
+/// \param[in]  width   [columns] Width of rectangle
+/// \param[in]  height  [rows] Height of rectangle
+//--------------------------------------------------------------
+void windowStack::redraw(int column, int row, int width, int height)
+{
+  if (_pDisplay == NULL)
+  {
+    return;
+  }
+
+  int right = constrain(column + width, 0, NUMBER_OF_COLUMNS);  // Clip to screen
+  int bottom = constrain(row + height, 0, NUMBER_OF_ROWS);
+  for (int y = constrain(row, 0, NUMBER_OF_ROWS); y < bottom; y++)
+  {
+    for (int x = constrain(column, 0, NUMBER_OF_COLUMNS); x < right; x++)
+    {
+      _pDisplay->queueCharacter(x, y, character(x, y));         // Dropped if the page model already holds it
+    }
+  }
+  _pDisplay->flush();
+} // redraw()
+
+//--------------------------------------------------------------
+/// \brief Topmost window at a cell
+///
+/// \param[in]  column  Display column
+/// \param[in]  row     Display row
+///
+/// \return     Window handle, WINDOW_NONE if the background shows there
+//--------------------------------------------------------------
+int windowStack::windowAt(int column, int row)
+{
+  for (int index = _count - 1; index >= 0; index--)             // From top to bottom
+  {
+    const window &w = _windows[_order[index]];
+    if ((column >= w.column) && (column < w.column + w.width) && (row >= w.row) && (row < w.row + w.height))
+    {
+      return _order[index];
+    }
+  }
+  return WINDOW_NONE;
+} // windowAt()
+
+//--------------------------------------------------------------
+/// \brief Position of a window in the stack
+///
+/// \param[in]  window  Window handle
+///
+/// \return     Index in stack, 0 at the bottom, -1 if the window is not open
+//--------------------------------------------------------------
+int windowStack::layer(int window)
+{
+  for (int index = 0; index < _count; index++)
+  {
+    if (_order[index] == window)
+    {
+      return index;
+    }
+  }
+  return -1;
+} // layer()
+
+//--------------------------------------------------------------
+/// \brief Composited character of a cell
+///
+/// \param[in]  column  Display column
+/// \param[in]  row     Display row
+///
+/// \return     Character of the topmost window there, or of the background
+//--------------------------------------------------------------
+char windowStack::character(int column, int row)
+{
+  int top = windowAt(column, row);
+  if (top != WINDOW_NONE)
+  {
+    const window &w = _windows[top];
+    int index = (row - w.row) * w.width + (column - w.column);
+    return (index < w.length) ? w.content[index] : ' ';
+  }
+
+  int address = column | (row << 4);
+  return (address < _backgroundLength) ? _background[address] : ' ';
+} // character()
+
+//--------------------------------------------------------------
+/// \brief Composite area of a window again
+///
+/// \param[in]  area  Window whose rectangle to composite, open or just closed
+//--------------------------------------------------------------
+void windowStack::redraw(const window &area)
+{
+  redraw(area.column, area.row, area.width, area.height);
+} // redraw()
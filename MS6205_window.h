@@ -0,0 +1,172 @@
+/*
+  MS6205_window.h - Window stack for popups on a MS6205 vintage soviet character display.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+
+  WINDOWS
+  ===============
+   windowStack composites windows over a background on the visible page. The background and every
+   window are character buffers owned by the sketch; a window covers a rectangle, the last opened
+   or raised window is on top.
+
+     +----------------+
+     |DASHBOARD   12.5|       open() writes only the popup's cells that differ from what is shown,
+     |  +------+      |       close() writes only the cells the popup covered that differ from
+     |  |SAVED!|      |       what is underneath, taken from the other windows and the background.
+     |  +------+      |       So dismissing a 6 x 3 popup costs at most 18 writes, not a repaint.
+     +----------------+
+
+   Changes are queued and flushed, so cells that come out as the page model already holds them
+   are not written, and the planner picks the cheapest address moves.
+*/
+
+#ifndef MS6205_WINDOW_H
+#define MS6205_WINDOW_H
+
+#include "Arduino.h"
+#include "MS6205.h"
+
+#define WINDOW_LAYERS               4   // Windows open at the same time, on top of the background
+#define WINDOW_NONE                -1   // No window, e.g. open() with all layers in use
+
+class windowStack
+{
+  public:
+
+    //--------------------------------------------------------------
+    /// \brief Class constructor
+    ///
+    /// Creates window stack without windows and with a blank background. Writes nothing yet.
+    ///
+    /// \param[in]  pDisplay  Display to composite on
+    //--------------------------------------------------------------
+    windowStack(MS6205 *pDisplay);
+
+    //--------------------------------------------------------------
+    /// \brief Set background
+    ///
+    /// Writes the cells of the background which are not covered by a window and differ.
+    ///
+    /// \param[in]  content  Up to 160 characters, row by row, spaces after them. NULL for a blank
+    ///                      background. Must stay valid while set.
+    //--------------------------------------------------------------
+    void setBackground(const char *content);
+
+    //--------------------------------------------------------------
+    /// \brief Open window on top of the others
+    ///
+    /// Windows may reach beyond the screen, only the visible part is written.
+    ///
+    /// \param[in]  column   Display column of upper left corner
+    /// \param[in]  row      Display row of upper left corner
+    /// \param[in]  width    [columns] Width of window
+    /// \param[in]  height   [rows] Height of window
+    /// \param[in]  content  Up to width * height characters, row by row, spaces after them. Must stay
+    ///                      valid while the window is open.
+    ///
+    /// \return     Window handle, WINDOW_NONE if all WINDOW_LAYERS windows are open
+    //--------------------------------------------------------------
+    int open(int column, int row, int width, int height, const char *content);
+
+    //--------------------------------------------------------------
+    /// \brief Close window
+    ///
+    /// Restores what is underneath from the other windows and the background.
+    ///
+    /// \param[in]  window  Window handle from open()
+    //--------------------------------------------------------------
+    void close(int window);
+
+    //--------------------------------------------------------------
+    /// \brief Move window
+    ///
+    /// \param[in]  window  Window handle from open()
+    /// \param[in]  column  New display column of upper left corner
+    /// \param[in]  row     New display row of upper left corner
+    //--------------------------------------------------------------
+    void move(int window, int column, int row);
+
+    //--------------------------------------------------------------
+    /// \brief Bring window to the top
+    ///
+    /// \param[in]  window  Window handle from open()
+    //--------------------------------------------------------------
+    void raise(int window);
+
+    //--------------------------------------------------------------
+    /// \brief Replace content of a window
+    ///
+    /// Also call it after changing the window's buffer.
+    ///
+    /// \param[in]  window   Window handle from open()
+    /// \param[in]  content  Up to width * height characters, row by row, spaces after them
+    //--------------------------------------------------------------
+    void setContent(int window, const char *content);
+
+    //--------------------------------------------------------------
+    /// \brief Composite rectangle again
+    ///
+    /// Call it after changing the background buffer. Writes only the cells which differ.
+    ///
+    /// \param[in]  column  Display column of upper left corner
+    /// \param[in]  row     Display row of upper left corner
+    /// \param[in]  width   [columns] Width of rectangle
+    /// \param[in]  height  [rows] Height of rectangle
+    //--------------------------------------------------------------
+    void redraw(int column = 0, int row = 0, int width = NUMBER_OF_COLUMNS, int height = NUMBER_OF_ROWS);
+
+    //--------------------------------------------------------------
+    /// \brief Topmost window at a cell
+    ///
+    /// \param[in]  column  Display column
+    /// \param[in]  row     Display row
+    ///
+    /// \return     Window handle, WINDOW_NONE if the background shows there
+    //--------------------------------------------------------------
+    int windowAt(int column, int row);
+
+  private:
+    struct window
+    {
+      int8_t column;              // Display column of upper left corner, may be off screen
+      int8_t row;                 // Display row of upper left corner, may be off screen
+      uint8_t width;              // [columns] Width of window
+      uint8_t height;             // [rows] Height of window
+      const char *content;        // Window content, row by row
+      uint8_t length;             // [characters] Length of content, spaces after it
+    };
+
+    window _windows[WINDOW_LAYERS];   // Windows by handle
+    int8_t _order[WINDOW_LAYERS];     // Handles of open windows, bottom to top
+    int _count;                       // Number of open windows
+    const char *_background;          // Background content, NULL for blank
+    int _backgroundLength;            // [characters] Length of background content, spaces after it
+    MS6205 * _pDisplay;               // Pointer to display to composite on
+
+    int layer(int window);
+    char character(int column, int row);
+    void redraw(const window &area);
+};
+
+#endif // MS6205_WINDOW_H
@@ -0,0 +1,48 @@
+#include <MS6205.h>             // https://github.com/holzachr/MS6205-arduino-library
+#include <MS6205_animation.h>
+#include "spinner.h"            // Generated from spinner.txt by extras/tools/make_animation.py
+    
+int const shiftRegisterLatchPin  = 15; // GPIO15 = Pin D8 on NodeMCU board. Pin 12 on 74HC595.
+int const shiftRegisterClockPin  = 14; // GPIO14 = Pin D5 on NodeMCU board. Pin 11 on 74HC595.
+int const shiftRegisterDataPin   = 13; // GPIO13 = Pin D7 on NodeMCU board. Pin 14 on 74HC595.
+int const displaySetPositionPin  = 12; // GPIO12 = Pin D6 on NodeMCU board. Pin 16A on MS6205.
+int const displaySetCharacterPin = 2;  // GPIO2  = Pin D4 on NodeMCU board. Pin 16B on MS6205.
+int const displayClearPin        = 5;  // GPIO5  = Pin D1 on NodeMCU board. Pin 18A on MS6205.
+  
+// Static screen, the spinners run on top of it
+char const background[] = "   LOADING...   "
+                          "                "
+                          "----------------"
+                          "----------------"
+                          "----------------"
+                          "----------------"
+                          "----------------"
+                          "                "
+                          "                "
+                          "                ";
+
+// Display declaration  
+MS6205 display(shiftRegisterLatchPin, shiftRegisterClockPin, shiftRegisterDataPin, displaySetPositionPin, displaySetCharacterPin, displayClearPin);
+  
+// Two players of the same animation, one looping, one playing forwards and backwards
+animationPlayer leftSpinner(&display);
+animationPlayer rightSpinner(&display);
+  
+void setup() 
+{
+  display.begin();
+  display.renderPage(0, background);
+  
+  leftSpinner.setBackground(background);
+  leftSpinner.play(spinner, 2, 3, ANIMATION_LOOP);
+  
+  rightSpinner.setBackground(background);
+  rightSpinner.setInterval(60);                                 // Twice as fast as stored
+  rightSpinner.play(spinner, 11, 3, ANIMATION_PING_PONG);
+}
+  
+void loop()
+{
+  leftSpinner.update();
+  rightSpinner.update();
+}
@@ -0,0 +1,19 @@
+// Generated by extras/tools/make_animation.py from spinner.txt, do not edit.
+// 8 frames, 3 x 3 cells, 120 ms per frame, 14 cells changed in total, 82 bytes
+
+#ifndef ANIMATION_SPINNER_H
+#define ANIMATION_SPINNER_H
+
+#include "Arduino.h"
+
+const uint8_t spinner[] PROGMEM =
+{
+  0x08, 0x03, 0x03, 0x78, 0x00, 0x1A, 0x00, 0x21, 0x00, 0x28, 0x00, 0x2F, 0x00, 0x36, 0x00, 0x3D,
+  0x00, 0x44, 0x00, 0x4B, 0x00, 0x02, 0x00, 0x2A, 0x11, 0x4F, 0x02, 0x00, 0x00, 0x2A, 0x10, 0x2A,
+  0x00, 0x02, 0x00, 0x2A, 0x00, 0x01, 0x00, 0x2A, 0x02, 0x01, 0x2A, 0x00, 0x02, 0x00, 0x2A, 0x02,
+  0x02, 0x2A, 0x00, 0x12, 0x00, 0x2A, 0x02, 0x12, 0x2A, 0x00, 0x22, 0x00, 0x2A, 0x02, 0x21, 0x00,
+  0x2A, 0x22, 0x2A, 0x00, 0x02, 0x20, 0x00, 0x2A, 0x21, 0x2A, 0x00, 0x02, 0x10, 0x00, 0x2A, 0x20,
+  0x2A, 0x00,
+};
+
+#endif // ANIMATION_SPINNER_H
@@ -38,6 +38,7 @@ MS6205 display(shiftRegisterLatchPin, shiftRegisterClockPin, shiftRegisterDataPi
 
 void setup() {
   // put your setup code here, to run once:
+  display.begin();
 }
 
 void loop() {
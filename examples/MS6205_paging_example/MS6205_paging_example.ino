@@ -43,6 +43,7 @@ void setup() {
 
   // --- Initialize paging ---
   display.beginPaging(displaySelectPage0Pin, displaySelectPage1Pin);  
+  display.begin(BEGIN_NO_CLEAR);                                // Every page is cleared below anyway
 
   // --- Fill page 0 ---
   display.showPage(0);
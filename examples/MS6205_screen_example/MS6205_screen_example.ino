@@ -0,0 +1,33 @@
+#include <MS6205.h>             // https://github.com/holzachr/MS6205-arduino-library
+#include "screens.h"            // Generated from logo.txt and menu.txt by extras/tools/make_screen.py
+    
+int const shiftRegisterLatchPin  = 15; // GPIO15 = Pin D8 on NodeMCU board. Pin 12 on 74HC595.
+int const shiftRegisterClockPin  = 14; // GPIO14 = Pin D5 on NodeMCU board. Pin 11 on 74HC595.
+int const shiftRegisterDataPin   = 13; // GPIO13 = Pin D7 on NodeMCU board. Pin 14 on 74HC595.
+int const displaySetPositionPin  = 12; // GPIO12 = Pin D6 on NodeMCU board. Pin 16A on MS6205.
+int const displaySetCharacterPin = 2;  // GPIO2  = Pin D4 on NodeMCU board. Pin 16B on MS6205.
+int const displayClearPin        = 5;  // GPIO5  = Pin D1 on NodeMCU board. Pin 18A on MS6205.
+int const displaySelectPage0Pin  = 4;  // GPIO4  = Pin D2 on NodeMCU board. Pin  2A on MS6205.
+int const displaySelectPage1Pin  = 0;  // GPIO0  = Pin D3 on NodeMCU board. Pin  2B on MS6205.
+  
+// Display declaration  
+MS6205 display(shiftRegisterLatchPin, shiftRegisterClockPin, shiftRegisterDataPin, displaySetPositionPin, displaySetCharacterPin, displayClearPin);
+  
+void setup() 
+{
+  display.beginPaging(displaySelectPage0Pin, displaySelectPage1Pin);
+  display.begin(BEGIN_NO_CLEAR);                                // drawScreen() writes every cell, or clears if cheaper
+  
+  // Fill both pages straight from flash, no String in RAM
+  display.drawScreen(1, menu);
+  display.drawScreen(0, logo);
+}
+  
+void loop()
+{
+  // Toggle between logo and menu. The pages already hold the screens, so nothing is written again.
+  delay(3000);
+  display.drawScreen(1, menu);
+  delay(3000);
+  display.drawScreen(0, logo);
+}
@@ -0,0 +1,23 @@
+// Generated by extras/tools/make_screen.py, do not edit.
+
+#include "Arduino.h"
+
+// logo.txt: packed, 71 bytes instead of 160
+const uint8_t logo[] PROGMEM =
+{
+  0x01, 0x1D, 0xFC, 0x5A, 0x0F, 0xFF, 0xD0, 0x20, 0xFF, 0xFD, 0x02, 0x0F, 0xFF, 0xD0, 0x00, 0xFE,
+  0x81, 0x07, 0xFF, 0xE8, 0x10, 0x7F, 0x41, 0xFF, 0xFA, 0x0F, 0xE8, 0x3F, 0x81, 0x41, 0xFF, 0xFA,
+  0x04, 0x1F, 0xC0, 0xA0, 0xFE, 0x83, 0xF8, 0x14, 0x1F, 0xFF, 0xA0, 0x41, 0xFC, 0x0A, 0x0F, 0xE8,
+  0x00, 0x7F, 0x40, 0x83, 0xFF, 0xF1, 0x68, 0x3F, 0xFF, 0x02, 0x82, 0x6D, 0x36, 0xCC, 0x98, 0x35,
+  0x02, 0x83, 0xFF, 0xF1, 0x68, 0x07, 0x7F,
+};
+
+// menu.txt: packed, 67 bytes instead of 160
+const uint8_t menu[] PROGMEM =
+{
+  0x01, 0x00, 0x82, 0x6C, 0x19, 0x33, 0x90, 0x20, 0x9B, 0x16, 0x75, 0x50, 0x08, 0x06, 0xAD, 0x40,
+  0xC5, 0x04, 0x39, 0x93, 0xE1, 0xCB, 0x0C, 0x81, 0x92, 0x0A, 0xF1, 0x60, 0xD4, 0x91, 0x16, 0x90,
+  0x44, 0x0C, 0xD0, 0x4E, 0x8B, 0x52, 0xBC, 0xFA, 0x52, 0xC2, 0x20, 0x68, 0x82, 0x9C, 0x5A, 0x95,
+  0x24, 0xCE, 0x8F, 0x4C, 0x92, 0x01, 0xAB, 0x69, 0xC5, 0x99, 0x16, 0x1D, 0x47, 0x48, 0x18, 0xAD,
+  0x68, 0x49, 0x00,
+};
@@ -28,7 +28,7 @@ scrollText testString(0, 7, 3, 8, 300, "Teststring", &display);
   
 void setup() 
 {
-  display.clear();
+  display.begin();
 }
   
 void loop()
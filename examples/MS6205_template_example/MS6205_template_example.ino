@@ -0,0 +1,64 @@
+/* Example of the compile-time configured MS6205T on a NodeMCUv3 ESP8266 with a 74HC595
+ * shift register, driving an Elektronika MS6205 multi-line character display.
+ * Same wiring and output as MS6205_basic_example, with pins fixed at compile time.
+ * 
+ *  
+ * Copyright 2018 Christian Holzapfel
+ * 
+ * Released under the MIT License.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include <MS6205_template.h>
+
+uint8_t const shiftRegisterLatchPin  = 15; // GPIO15 = Pin D8 on NodeMCU boards. Pin 12 on 74HC595.
+uint8_t const shiftRegisterClockPin  = 14; // GPIO14 = Pin D5 on NodeMCU boards. Pin 11 on 74HC595.
+uint8_t const shiftRegisterDataPin   = 13; // GPIO13 = Pin D7 on NodeMCU boards. Pin 14 on 74HC595.
+uint8_t const displaySetPositionPin  = 12; // GPIO12 = Pin D6 on NodeMCU boards. Pin 16A on MS6205.
+uint8_t const displaySetCharacterPin = 2;  // GPIO2  = Pin D4 on NodeMCU boards. Pin 16B on MS6205.
+uint8_t const displayClearPin        = 5;  // GPIO5  = Pin D1 on NodeMCU boards. Pin 18A on MS6205.
+
+MS6205T<shiftRegisterLatchPin, shiftRegisterClockPin, shiftRegisterDataPin,
+        displaySetPositionPin, displaySetCharacterPin, displayClearPin> display;
+
+void setup() {
+  // put your setup code here, to run once:
+  display.begin();
+}
+
+void loop() {
+  // put your main code here, to run repeatedly:
+
+  display.clear();
+
+  display.setCursor(2, 3);
+  display.write("Elektronika");
+
+  display.setCursor(4, 4);
+  display.write("MS6205");
+
+  display.setCursor(7, 5);
+  display.write("+");
+
+  display.setCursor(4, 6);
+  display.write("ESP8266");
+
+  delay(1000);
+}
@@ -0,0 +1,88 @@
+/* Example of a warm restart on a NodeMCUv3 ES8266 with a 74HC595 shift register
+ * driving an Elektronika MS6205: after a reset, only changed cells are written.
+ * 
+ *  
+ * Copyright 2018 Christian Holzapfel
+ * 
+ * Released under the MIT License.
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+
+#include <MS6205.h>
+
+int const shiftRegisterLatchPin  = 15; // GPIO15 = Pin D8 on NodeMCU boards. Pin 12 on 74HC595.
+int const shiftRegisterClockPin  = 14; // GPIO14 = Pin D5 on NodeMCU boards. Pin 11 on 74HC595.
+int const shiftRegisterDataPin   = 13; // GPIO13 = Pin D7 on NodeMCU boards. Pin 14 on 74HC595.
+int const displaySetPositionPin  = 12; // GPIO12 = Pin D6 on NodeMCU boards. Pin 16A on MS6205.
+int const displaySetCharacterPin = 2;  // GPIO2  = Pin D4 on NodeMCU boards. Pin 16B on MS6205.
+int const displayClearPin        = 5;  // GPIO5  = Pin D1 on NodeMCU boards. Pin 18A on MS6205.
+
+#define RTC_STATE_OFFSET   0   // [4-byte blocks] Position of the saved state in ESP8266 RTC user memory
+
+MS6205 display(shiftRegisterLatchPin, shiftRegisterClockPin, shiftRegisterDataPin, displaySetPositionPin, displaySetCharacterPin, displayClearPin);
+
+MS6205_RETAINED displayState savedState;                        // Survives a reset on AVR and ESP32
+
+char screen[NUMBER_OF_CHARACTERS + 1] =
+  "  ELEKTRONIKA   "
+  "     MS6205     "
+  "                "
+  "    UPTIME:     "
+  "                "
+  "                "
+  "                "
+  "                "
+  "                "
+  "                ";
+
+void showUptime()
+{
+  unsigned long seconds = millis() / 1000;
+  for (int i = 0; i < 6; i++, seconds /= 10)
+  {
+    screen[4 * NUMBER_OF_COLUMNS + 10 - i] = '0' + (seconds % 10);
+  }
+
+  display.renderPage(0, screen);                                // Only the cells that changed
+
+  // --- Remember what the display shows, for the next reset ---
+  display.saveState(&savedState);
+#if defined(ESP8266)
+  ESP.rtcUserMemoryWrite(RTC_STATE_OFFSET, (uint32_t *)&savedState, sizeof(savedState));
+#endif
+}
+
+void setup() 
+{
+#if defined(ESP8266)
+  ESP.rtcUserMemoryRead(RTC_STATE_OFFSET, (uint32_t *)&savedState, sizeof(savedState));
+#endif
+
+  // After power-up the saved state is garbage, and the display is cleared as usual.
+  // After a reset, the display still shows the last screen, and only the uptime is rewritten.
+  display.beginWarm(&savedState);
+  showUptime();
+}
+
+void loop() 
+{
+  showUptime();
+  delay(1000);
+}
@@ -0,0 +1,247 @@
+/*
+  Arduino.cpp - Minimal Arduino core replacement for building the MS6205 library on a Linux host.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include "Arduino.h"
+
+#include <stdio.h>
+#include <atomic>
+#include <mutex>
+
+#define HOST_NUMBER_OF_PINS        256
+
+static uint8_t pinLevel[HOST_NUMBER_OF_PINS];   // Last level written to each pin
+static hostPinHook pinHook = NULL;              // Observer of pin changes
+static unsigned long pinCostNs = 0;             // [ns] Simulated duration of one digitalWrite()
+static std::atomic<unsigned long long> nowNs(0); // [ns] Simulated time, read by other threads
+static unsigned long pinWrites = 0;             // Number of digitalWrite() calls
+static std::recursive_mutex interruptLock;      // Held while "interrupts" are disabled
+static thread_local int interruptLockDepth = 0; // noInterrupts() calls of this thread not yet released
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+  (void)pin;
+  (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+  pinLevel[pin] = (value != LOW) ? HIGH : LOW;
+  pinWrites++;
+  nowNs += pinCostNs;
+
+  if (pinHook != NULL)
+  {
+    pinHook(pin, pinLevel[pin]);
+  }
+}
+
+int digitalRead(uint8_t pin)
+{
+  return pinLevel[pin];
+}
+
+void shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t value)
+{
+  // Same bit sequence as the AVR and ESP8266 cores
+  for (uint8_t i = 0; i < 8; i++)
+  {
+    if (bitOrder == LSBFIRST)
+    {
+      digitalWrite(dataPin, (value >> i) & 0x01);
+    }
+    else
+    {
+      digitalWrite(dataPin, (value >> (7 - i)) & 0x01);
+    }
+    digitalWrite(clockPin, HIGH);
+    digitalWrite(clockPin, LOW);
+  }
+}
+
+unsigned long millis(void)
+{
+  return (unsigned long)(nowNs / 1000000ULL);
+}
+
+unsigned long micros(void)
+{
+  return (unsigned long)(nowNs / 1000ULL);
+}
+
+void delay(unsigned long ms)
+{
+  nowNs += (unsigned long long)ms * 1000000ULL;
+}
+
+void delayMicroseconds(unsigned int us)
+{
+  nowNs += (unsigned long long)us * 1000ULL;
+}
+
+long random(long howBig)
+{
+  return (howBig > 0) ? (long)(rand() % howBig) : 0;
+}
+
+long random(long howSmall, long howBig)
+{
+  return (howSmall < howBig) ? howSmall + random(howBig - howSmall) : howSmall;
+}
+
+void randomSeed(unsigned long seed)
+{
+  srand(seed);
+}
+
+// Threads stand in for interrupts on the host: while one thread has "interrupts" disabled,
+// every other thread calling noInterrupts() waits. As on a CPU, interrupts() enables them again
+// no matter how often noInterrupts() was called before.
+void noInterrupts(void)
+{
+  interruptLock.lock();
+  interruptLockDepth++;
+}
+
+void interrupts(void)
+{
+  while (interruptLockDepth > 0)
+  {
+    interruptLockDepth--;
+    interruptLock.unlock();
+  }
+}
+
+// PRIMASK of an ARM core, on top of the above: disabling twice is the same as once, and restoring
+// the value read before enables interrupts only if they were enabled then.
+uint32_t __get_PRIMASK(void)
+{
+  return (interruptLockDepth > 0) ? 1 : 0;
+}
+
+void __set_PRIMASK(uint32_t primask)
+{
+  if (primask == 0)
+  {
+    interrupts();
+  }
+  else
+  {
+    __disable_irq();
+  }
+}
+
+void __disable_irq(void)
+{
+  if (interruptLockDepth == 0)
+  {
+    noInterrupts();
+  }
+}
+
+void hostSetPinHook(hostPinHook hook)
+{
+  pinHook = hook;
+}
+
+void hostSetPinCostNs(unsigned long costNs)
+{
+  pinCostNs = costNs;
+}
+
+unsigned long long hostNanos(void)
+{
+  return nowNs;
+}
+
+void hostAdvanceNs(unsigned long long ns)
+{
+  nowNs += ns;
+}
+
+unsigned long hostPinWrites(void)
+{
+  return pinWrites;
+}
+
+String::String(double value, unsigned char decimals)
+{
+  char buffer[48];
+  snprintf(buffer, sizeof(buffer), "%.*f", (int)decimals, value);
+  _s = buffer;
+}
+
+String String::substring(unsigned int from, unsigned int to) const
+{
+  if (from > to)
+  {
+    unsigned int temp = from;
+    from = to;
+    to = temp;
+  }
+  if (from >= _s.length())
+  {
+    return String();
+  }
+  if (to > _s.length())
+  {
+    to = _s.length();
+  }
+  return String(_s.substr(from, to - from));
+}
+
+void String::fromLong(long value, unsigned char base)
+{
+  if ((value < 0) && (base == 10))
+  {
+    fromUnsigned((unsigned long)(-value), base);
+    _s.insert(_s.begin(), '-');
+  }
+  else
+  {
+    fromUnsigned((unsigned long)value, base);
+  }
+}
+
+void String::fromUnsigned(unsigned long value, unsigned char base)
+{
+  char buffer[8 * sizeof(unsigned long) + 1];
+  char *p = &buffer[sizeof(buffer) - 1];
+
+  if (base < 2)
+  {
+    base = 10;
+  }
+
+  *p = '\0';
+  do
+  {
+    unsigned long digit = value % base;
+    *--p = (char)(digit < 10 ? '0' + digit : 'A' + digit - 10);
+    value /= base;
+  } while (value > 0);
+
+  _s = p;
+}
@@ -0,0 +1,179 @@
+/*
+  Arduino.h - Minimal Arduino core replacement for building the MS6205 library on a Linux host.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+
+  ABOUT THE HOST BUILD
+  ======================
+   Only the small part of the Arduino core used by this library is provided here.
+   Time is simulated: millis() and micros() advance by the delays the library requests
+   and by a configurable cost per pin operation (see hostPinCostNs), so benchmarks
+   produce the same numbers on every machine.
+
+   Pin operations can be observed through hostSetPinHook(), which is how the display
+   simulator in MS6205_sim.h watches the bus.
+*/
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <string>
+
+#define HIGH                        1
+#define LOW                         0
+
+#define INPUT                       0
+#define OUTPUT                      1
+#define INPUT_PULLUP                2
+
+#define LSBFIRST                    0
+#define MSBFIRST                    1
+
+#define DEC                        10
+#define HEX                        16
+#define OCT                         8
+#define BIN                         2
+
+#define PROGMEM
+#define PGM_P                       const char *
+#define PSTR(s)                     (s)
+#define pgm_read_byte(address)      (*(const uint8_t *)(address))
+#define pgm_read_word(address)      (*(const uint16_t *)(address))
+#define pgm_read_dword(address)     (*(const uint32_t *)(address))
+#define memcpy_P                    memcpy
+#define strlen_P                    strlen
+
+#define constrain(amt, low, high)   ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+inline int toUpperCase(int c) { return toupper(c); }
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+void shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t value);
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+
+void noInterrupts(void);
+void interrupts(void);
+
+uint32_t __get_PRIMASK(void);                   // CMSIS interrupt mask of an ARM core: 1 while interrupts are disabled
+void __set_PRIMASK(uint32_t primask);
+void __disable_irq(void);
+
+//--------------------------------------------------------------
+/// \brief Host simulation controls
+//--------------------------------------------------------------
+typedef void (*hostPinHook)(uint8_t pin, uint8_t value);
+
+void hostSetPinHook(hostPinHook hook);          // Called after every digitalWrite(), also those made by shiftOut()
+void hostSetPinCostNs(unsigned long costNs);    // [ns] Simulated duration of one digitalWrite(), 0 to disable
+unsigned long long hostNanos(void);             // [ns] Simulated time since start
+void hostAdvanceNs(unsigned long long ns);      // Let simulated time pass without any pin activity
+unsigned long hostPinWrites(void);              // Number of digitalWrite() calls so far
+
+//--------------------------------------------------------------
+/// \brief Subset of the Arduino String class
+//--------------------------------------------------------------
+class String
+{
+  public:
+    String(void) {}
+    String(const char *text) : _s(text != NULL ? text : "") {}
+    String(const std::string &text) : _s(text) {}
+    String(char c) : _s(1, c) {}
+    String(int value, unsigned char base = 10) { fromLong(value, base); }
+    String(unsigned int value, unsigned char base = 10) { fromUnsigned(value, base); }
+    String(long value, unsigned char base = 10) { fromLong(value, base); }
+    String(unsigned long value, unsigned char base = 10) { fromUnsigned(value, base); }
+    String(double value, unsigned char decimals = 2);
+
+    unsigned int length(void) const { return _s.length(); }
+    char charAt(unsigned int index) const { return index < _s.length() ? _s[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    const char *c_str(void) const { return _s.c_str(); }
+    String substring(unsigned int from) const { return substring(from, _s.length()); }
+    String substring(unsigned int from, unsigned int to) const;
+    bool operator==(const String &other) const { return _s == other._s; }
+    bool operator!=(const String &other) const { return _s != other._s; }
+    String &operator+=(const String &other) { _s += other._s; return *this; }
+    String &operator+=(const char *text) { _s += text; return *this; }
+    String &operator+=(char c) { _s += c; return *this; }
+    friend String operator+(const String &a, const String &b) { return String(a._s + b._s); }
+
+  private:
+    std::string _s;
+
+    void fromLong(long value, unsigned char base);
+    void fromUnsigned(unsigned long value, unsigned char base);
+};
+
+//--------------------------------------------------------------
+/// \brief Subset of the Arduino Print class
+//--------------------------------------------------------------
+class Print
+{
+  public:
+    virtual ~Print(void) {}
+    virtual size_t write(uint8_t value) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size)
+    {
+      size_t written = 0;
+      while ((written < size) && (write(buffer[written]) == 1))
+      {
+        written++;
+      }
+      return written;
+    }
+    size_t print(const char *text) { return write((const uint8_t *)text, strlen(text)); }
+    virtual void flush(void) {}
+};
+
+//--------------------------------------------------------------
+/// \brief Subset of the Arduino Stream class
+//--------------------------------------------------------------
+class Stream : public Print
+{
+  public:
+    virtual int available(void) = 0;
+    virtual int read(void) = 0;
+    virtual int peek(void) = 0;
+};
+
+#endif // Arduino_h
@@ -0,0 +1,283 @@
+/*
+  MS6205_sim.cpp - Simulated 74HC595 and MS6205 display for host builds of the MS6205 library.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*/
+
+#include "MS6205_sim.h"
+
+#include <stdio.h>
+
+MS6205Simulator *MS6205Simulator::_active = NULL;
+
+MS6205Simulator::MS6205Simulator(void)
+{
+  _latchPin = _clockPin = _dataPin = _setAddressPin = _setCharacterPin = _clearPin = SIM_NO_PIN;
+  _page0Pin = _page1Pin = _incrementPin = _cursorPin = SIM_NO_PIN;
+  _port = NULL;
+  memset(_busPins, SIM_NO_PIN, sizeof(_busPins));
+  _strobeHook = NULL;
+  _shift = 0;
+  _shiftSecond = 0;
+  _dualShiftRegister = false;
+  _addressBus = 0;
+  _dataBus = 0;
+  _pageLines = 0x03;                    // Pull-ups select page 0
+  _cursor = false;
+  _autoIncrement = false;
+  _address = 0;
+  memset(_memory, ' ', sizeof(_memory));  // Power-up content is unknown, spaces make printouts readable
+  resetCounters();
+
+  _active = this;
+  hostSetPinHook(pinChanged);
+}
+
+MS6205Simulator::~MS6205Simulator(void)
+{
+  if (_active == this)
+  {
+    _active = NULL;
+    hostSetPinHook(NULL);
+  }
+}
+
+void MS6205Simulator::attach(uint8_t latchPin, uint8_t clockPin, uint8_t dataPin, uint8_t setAddressPin, uint8_t setCharacterPin, uint8_t clearPin)
+{
+  _latchPin = latchPin;
+  _clockPin = clockPin;
+  _dataPin = dataPin;
+  _setAddressPin = setAddressPin;
+  _setCharacterPin = setCharacterPin;
+  _clearPin = clearPin;
+}
+
+void MS6205Simulator::attachPaging(uint8_t selectPage0Pin, uint8_t selectPage1Pin)
+{
+  _page0Pin = selectPage0Pin;
+  _page1Pin = selectPage1Pin;
+}
+
+void MS6205Simulator::attachIncrement(uint8_t incrementColumnPin)
+{
+  _incrementPin = incrementColumnPin;
+}
+
+void MS6205Simulator::attachCursor(uint8_t showCursorPin)
+{
+  _cursorPin = showCursorPin;
+}
+
+void MS6205Simulator::attachParallel(const volatile uint8_t *port)
+{
+  _port = port;
+}
+
+void MS6205Simulator::attachParallel(const uint8_t pins[8])
+{
+  memcpy(_busPins, pins, sizeof(_busPins));
+}
+
+void MS6205Simulator::attachDualShiftRegister(void)
+{
+  _dualShiftRegister = true;
+}
+
+void MS6205Simulator::setAutoIncrement(bool autoIncrement)
+{
+  _autoIncrement = autoIncrement;
+}
+
+void MS6205Simulator::setBus(uint8_t value)
+{
+  _addressBus = value;
+  _dataBus = value;
+}
+
+void MS6205Simulator::setAddressBus(uint8_t value)
+{
+  _addressBus = value;
+}
+
+void MS6205Simulator::setDataBus(uint8_t value)
+{
+  _dataBus = value;
+}
+
+void MS6205Simulator::glitch(int page, int address, char character)
+{
+  _memory[page & (SIM_PAGES - 1)][address % SIM_CELLS] = character;
+}
+
+char MS6205Simulator::character(int page, int column, int row) const
+{
+  return _memory[page][column | (row << 4)];
+}
+
+const char *MS6205Simulator::page(int page) const
+{
+  return _memory[page];
+}
+
+int MS6205Simulator::visiblePage(void) const
+{
+  return (~_pageLines) & 0x03;          // Select lines are inverted
+}
+
+int MS6205Simulator::address(void) const
+{
+  return _address;
+}
+
+bool MS6205Simulator::cursorShown(void) const
+{
+  return _cursor;
+}
+
+const simCounters &MS6205Simulator::counters(void) const
+{
+  return _counters;
+}
+
+void MS6205Simulator::resetCounters(void)
+{
+  memset(&_counters, 0, sizeof(_counters));
+}
+
+void MS6205Simulator::setStrobeHook(simStrobeHook hook)
+{
+  _strobeHook = hook;
+}
+
+void MS6205Simulator::printPage(int page) const
+{
+  printf("+----------------+\n");
+  for (int row = 0; row < SIM_ROWS; row++)
+  {
+    printf("|%.16s|\n", &_memory[page][row << 4]);
+  }
+  printf("+----------------+\n");
+}
+
+void MS6205Simulator::pinChanged(uint8_t pin, uint8_t value)
+{
+  if (_active != NULL)
+  {
+    _active->onPin(pin, value);
+  }
+}
+
+void MS6205Simulator::onPin(uint8_t pin, uint8_t value)
+{
+  if ((pin == _clockPin) && (value == HIGH))
+  {
+    _shiftSecond = (uint8_t)((_shiftSecond << 1) | (_shift >> 7));  // QH' feeds the second 74HC595
+    _shift = (uint8_t)((_shift << 1) | digitalRead(_dataPin));      // 74HC595 shifts on rising edge
+  }
+  else if ((pin == _latchPin) && (value == HIGH))
+  {
+    if (_dualShiftRegister)
+    {
+      setAddressBus(_shiftSecond);                                  // Both registers latch at once
+      setDataBus(_shift);
+    }
+    else
+    {
+      setBus(_shift);                                               // Outputs drive address and data lines in parallel
+    }
+    _counters.bytesLatched++;
+  }
+  else if ((pin == _setAddressPin) && (value == LOW))
+  {
+    sampleParallel();
+    if (_strobeHook != NULL)
+    {
+      _strobeHook(pin, _addressBus);
+    }
+    _address = _addressBus;
+    _counters.addressStrobes++;
+  }
+  else if ((pin == _setCharacterPin) && (value == LOW))
+  {
+    sampleParallel();
+    if (_strobeHook != NULL)
+    {
+      _strobeHook(pin, _dataBus);
+    }
+    if (_address < SIM_CELLS)
+    {
+      _memory[visiblePage()][_address] = (char)((~_dataBus) & 0x7F);  // Data lines are inverted
+    }
+    if (_autoIncrement)
+    {
+      _address = (_address & 0xF0) | ((_address + 1) & 0x0F);
+    }
+    _counters.characterStrobes++;
+  }
+  else if ((pin == _incrementPin) && (value == LOW))
+  {
+    _address = (_address & 0xF0) | ((_address + 1) & 0x0F);
+    _counters.incrementPulses++;
+  }
+  else if ((pin == _clearPin) && (value == LOW))
+  {
+    if (_strobeHook != NULL)
+    {
+      _strobeHook(pin, 0);
+    }
+    memset(_memory[visiblePage()], ' ', SIM_CELLS);
+    _counters.clears++;
+  }
+  else if ((pin == _page0Pin) || (pin == _page1Pin))
+  {
+    uint8_t bit = (pin == _page0Pin) ? 0x01 : 0x02;
+    uint8_t lines = (value == HIGH) ? (_pageLines | bit) : (_pageLines & ~bit);
+    if (lines != _pageLines)
+    {
+      _pageLines = lines;
+      _counters.pageSelects++;
+    }
+  }
+  else if (pin == _cursorPin)
+  {
+    _cursor = (value == HIGH);                                      // Log. '1' shows the cursor block
+  }
+}
+
+void MS6205Simulator::sampleParallel(void)
+{
+  // --- The display takes over whatever the lines show at the strobe ---
+  if (_port != NULL)
+  {
+    setBus(*_port);
+  }
+  else if (_busPins[0] != SIM_NO_PIN)
+  {
+    uint8_t value = 0;
+    for (int i = 0; i < 8; i++)
+    {
+      value |= (uint8_t)(digitalRead(_busPins[i]) << i);
+    }
+    setBus(value);
+  }
+}
@@ -0,0 +1,122 @@
+/*
+  MS6205_sim.h - Simulated 74HC595 and MS6205 display for host builds of the MS6205 library.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License.
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+
+  ABOUT THE SIMULATOR
+  =====================
+   Watches the pins written by the library and reacts like the real hardware would:
+   the 74HC595 shifts on the rising clock edge and latches on the rising latch edge,
+   the MS6205 takes over address or character on the falling edge of /Set address
+   and /Set character, clears the visible page while /Clear is low, and so on.
+
+   Every bus operation is counted, so host programs can compare update strategies.
+   Only one simulator can be active at a time.
+*/
+
+#ifndef MS6205_SIM_H
+#define MS6205_SIM_H
+
+#include "Arduino.h"
+
+#define SIM_COLUMNS                16
+#define SIM_ROWS                   10
+#define SIM_CELLS                 160
+#define SIM_PAGES                   4
+#define SIM_NO_PIN                255
+
+typedef void (*simStrobeHook)(uint8_t pin, uint8_t bus);   // Called on every /Set address, /Set character and /Clear strobe
+
+struct simCounters
+{
+  unsigned long bytesLatched;           // Latch pulses of the 74HC595 outputs, one per 2 bytes with two chained ones
+  unsigned long addressStrobes;         // Pulses on /Set address 16A
+  unsigned long characterStrobes;       // Pulses on /Set character 16B
+  unsigned long incrementPulses;        // Pulses on "increment column address" 6B
+  unsigned long clears;                 // Pulses on /Clear 18A
+  unsigned long pageSelects;            // Changes of the visible page
+};
+
+class MS6205Simulator
+{
+  public:
+    MS6205Simulator(void);
+    ~MS6205Simulator(void);
+
+    // --- Wiring, same pins as passed to the library ---
+    void attach(uint8_t latchPin, uint8_t clockPin, uint8_t dataPin, uint8_t setAddressPin, uint8_t setCharacterPin, uint8_t clearPin);
+    void attachPaging(uint8_t selectPage0Pin, uint8_t selectPage1Pin);
+    void attachIncrement(uint8_t incrementColumnPin);
+    void attachCursor(uint8_t showCursorPin);
+    void attachParallel(const volatile uint8_t *port);        // Bus driven by an 8-bit port, sampled at each strobe
+    void attachParallel(const uint8_t pins[8]);               // Bus driven by 8 pins, lowest bit first
+    void attachDualShiftRegister(void);                       // Second 74HC595 behind the first one drives the address lines
+
+    // --- Behaviour of the simulated display ---
+    void setAutoIncrement(bool autoIncrement);     // Advance address after each character
+
+    // --- Bus inputs for transports other than the 74HC595 ---
+    void setBus(uint8_t value);                    // Drive the shared address/data bus directly
+    void setAddressBus(uint8_t value);             // Drive address lines only
+    void setDataBus(uint8_t value);                // Drive data lines only
+
+    // --- Faults ---
+    void glitch(int page, int address, char character);       // Corrupt a cell, as noise on the bus would
+
+    // --- Inspection ---
+    char character(int page, int column, int row) const;
+    const char *page(int page) const;              // 160 characters, not terminated
+    int visiblePage(void) const;
+    int address(void) const;
+    bool cursorShown(void) const;
+    const simCounters &counters(void) const;
+    void resetCounters(void);
+    void setStrobeHook(simStrobeHook hook);                   // Observe the byte and strobe sequence
+    void printPage(int page) const;
+
+  private:
+    uint8_t _latchPin, _clockPin, _dataPin, _setAddressPin, _setCharacterPin, _clearPin;
+    uint8_t _page0Pin, _page1Pin, _incrementPin, _cursorPin;
+    const volatile uint8_t *_port;      // Port driving the bus, NULL if none
+    uint8_t _busPins[8];                // Pins driving the bus, SIM_NO_PIN if none
+    uint8_t _shift;                     // 74HC595 shift register
+    uint8_t _shiftSecond;               // Shift register of a second 74HC595 chained behind the first one
+    bool _dualShiftRegister;            // Second 74HC595 drives the address lines, the first one the data lines
+    uint8_t _addressBus;                // Levels on address lines
+    uint8_t _dataBus;                   // Levels on data lines
+    uint8_t _pageLines;                 // Levels on 2A (bit 0) and 2B (bit 1)
+    bool _cursor;
+    bool _autoIncrement;
+    int _address;
+    char _memory[SIM_PAGES][SIM_CELLS];
+    simCounters _counters;
+    simStrobeHook _strobeHook;
+
+    static MS6205Simulator *_active;
+    static void pinChanged(uint8_t pin, uint8_t value);
+    void onPin(uint8_t pin, uint8_t value);
+    void sampleParallel(void);
+};
+
+#endif // MS6205_SIM_H
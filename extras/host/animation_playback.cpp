@@ -0,0 +1,117 @@
+/*
+  animation_playback.cpp - Plays the example animation on the simulated display on a Linux host.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License, see LICENSE.
+
+  Build and run from the library root:
+
+    g++ -std=c++11 -O2 -I extras/host -I . extras/host/Arduino.cpp extras/host/MS6205_sim.cpp \
+        MS6205*.cpp extras/host/animation_playback.cpp -o animation_playback && ./animation_playback
+
+  Plays examples/MS6205_animation_example/spinner.h in every mode on top of a background,
+  checks the box after every frame against the source frames, and counts the characters written.
+*/
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_animation.h"
+#include "MS6205_sim.h"
+#include "../../examples/MS6205_animation_example/spinner.h"
+
+#include <stdio.h>
+
+#define SPINNER_FRAMES              8
+#define BOX_COLUMN                  6
+#define BOX_ROW                     3
+#define STEPS                      40
+
+static const int ring[SPINNER_FRAMES][2] = {{0, 0}, {1, 0}, {2, 0}, {2, 1}, {2, 2}, {1, 2}, {0, 2}, {0, 1}};
+
+static char background[NUMBER_OF_CHARACTERS + 1];
+
+// Same frames as spinner.txt, with '.' showing the background
+static char expectedCell(int frame, int column, int row)
+{
+  if ((column == ring[frame][0]) && (row == ring[frame][1]))
+  {
+    return '*';
+  }
+  if ((column == 1) && (row == 1))
+  {
+    return 'O';
+  }
+  return background[(BOX_COLUMN + column) | ((BOX_ROW + row) << 4)];
+}
+
+static bool checkFrame(MS6205Simulator &simulator, int frame)
+{
+  for (int address = 0; address < NUMBER_OF_CHARACTERS; address++)
+  {
+    int column = (address & 0x0F) - BOX_COLUMN;
+    int row = (address >> 4) - BOX_ROW;
+    bool inBox = (column >= 0) && (column < 3) && (row >= 0) && (row < 3);
+    char expected = inBox ? expectedCell(frame, column, row) : background[address];
+    if (simulator.page(0)[address] != expected)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool run(int mode, const char *name)
+{
+  MS6205Simulator simulator;
+  simulator.attach(15, 14, 13, 12, 2, 5);
+  MS6205 display(15, 14, 13, 12, 2, 5);
+  display.begin();
+  display.renderPage(0, background);
+
+  animationPlayer player(&display);
+  player.setBackground(background);
+  player.play(spinner, BOX_COLUMN, BOX_ROW, mode);
+
+  simulator.resetCounters();
+  int frames = 0;
+  for (int step = 0; step < STEPS; step++)
+  {
+    hostAdvanceNs(120 * 1000000ULL);                    // One frame interval
+    bool playing = player.update();
+    frames++;
+    if (!checkFrame(simulator, player.frame()))
+    {
+      printf("%s: wrong content at frame %d\n", name, player.frame());
+      simulator.printPage(0);
+      return false;
+    }
+    if (!playing)
+    {
+      break;
+    }
+  }
+
+  player.stop();
+  if (memcmp(simulator.page(0), background, NUMBER_OF_CHARACTERS) != 0)
+  {
+    printf("%s: background not restored\n", name);
+    return false;
+  }
+
+  printf("%-10s %3d updates, %5.2f characters written per update (full redraw: 9)\n", name, frames,
+         (double)simulator.counters().characterStrobes / frames);
+  return true;
+}
+
+int main(void)
+{
+  for (int address = 0; address < NUMBER_OF_CHARACTERS; address++)
+  {
+    background[address] = 'A' + address % 26;
+  }
+  background[NUMBER_OF_CHARACTERS] = '\0';
+
+  bool passed = run(ANIMATION_ONCE, "once") && run(ANIMATION_LOOP, "loop") && run(ANIMATION_PING_PONG, "ping-pong");
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,176 @@
+/*
+  blink_engine.cpp - Checks blinking regions and cursor blink on the simulated display on a Linux host.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License, see LICENSE.
+
+  Build and run from the library root:
+
+    g++ -std=c++11 -O2 -I extras/host -I . extras/host/Arduino.cpp extras/host/MS6205_sim.cpp \
+        MS6205*.cpp extras/host/blink_engine.cpp -o blink_engine && ./blink_engine
+
+  A field of 2 x 16 cells and a small marker blink on top of a static screen. After every update(),
+  no more cells than the budget may have been written; once a phase is complete, every cell has to
+  show its content or its alternate character. Text written into the blinking field meanwhile has
+  to survive in the page model and show up with the next phase. Finally the cursor blinks, toggled
+  by update() as the host has no timer for it.
+*/
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_blink.h"
+#include "MS6205_sim.h"
+
+#include <stdio.h>
+
+#define CURSOR_PIN                  3
+#define BUDGET                     12
+#define INTERVAL_MS               250
+#define PHASES                      8
+#define UPDATE_EVERY_MS             2
+
+static char screen[NUMBER_OF_CHARACTERS + 1];
+static int failures = 0;
+
+// Checks every cell of the visible page, returns the number of wrong cells
+static int checkPhase(MS6205Simulator &simulator, bool off, const char *field)
+{
+  int wrong = 0;
+  for (int address = 0; address < NUMBER_OF_CHARACTERS; address++)
+  {
+    int column = address & 0x0F;
+    int row = address >> 4;
+    char expected = screen[address];
+    if ((row >= 4) && (row < 6))
+    {
+      expected = off ? ' ' : field[address - (4 << 4)];           // Field blinks to spaces
+    }
+    if ((row == 8) && (column == 15))
+    {
+      expected = off ? '<' : screen[address];                      // Marker alternates with '<'
+    }
+    if (simulator.page(0)[address] != expected)
+    {
+      wrong++;
+    }
+  }
+  return wrong;
+}
+
+int main(void)
+{
+  MS6205Simulator simulator;
+  simulator.attach(15, 14, 13, 12, 2, 5);
+  simulator.attachCursor(CURSOR_PIN);
+  MS6205 display(15, 14, 13, 12, 2, 5);
+  display.begin();
+  display.beginCursor(CURSOR_PIN);
+
+  for (int i = 0; i < NUMBER_OF_CHARACTERS; i++)
+  {
+    screen[i] = (char)('A' + (i * 5) % 26);
+  }
+  screen[NUMBER_OF_CHARACTERS] = '\0';
+  display.renderPage(0, screen);
+
+  char field[2 * NUMBER_OF_COLUMNS + 1];
+  memcpy(field, &screen[4 << 4], 2 * NUMBER_OF_COLUMNS);
+  field[2 * NUMBER_OF_COLUMNS] = '\0';
+
+  blinkEngine blinker(&display);
+  blinker.setInterval(INTERVAL_MS);
+  blinker.setBudget(BUDGET);
+  blinker.blink(0, 4, NUMBER_OF_COLUMNS, 2);
+  blinker.blink(15, 8, 1, 1, '<');
+
+  // --- Phases: budget per update(), content after each phase ---
+  printf("%-6s %-6s %8s %10s %12s %12s\n", "phase", "shows", "updates", "max cells", "cells", "wrong cells");
+  simulator.resetCounters();
+  unsigned long start = millis();
+  for (int phase = 1; phase <= PHASES; phase++)
+  {
+    bool off = (phase & 1) != 0;
+    int updates = 0;
+    int maxCells = 0;
+    unsigned long phaseCells = 0;
+
+    if (phase == 4)
+    {
+      // Normal write into the field while it shows spaces: model takes it, screen follows next phase
+      display.setCursor(2, 4);
+      display.write("NEW");
+      memcpy(&field[2], "NEW", 3);
+    }
+
+    while (millis() - start < (unsigned long)phase * INTERVAL_MS)
+    {
+      delay(UPDATE_EVERY_MS);
+    }
+    do
+    {
+      unsigned long before = simulator.counters().characterStrobes;
+      blinker.update();
+      int cells = simulator.counters().characterStrobes - before;
+      maxCells = (cells > maxCells) ? cells : maxCells;
+      phaseCells += cells;
+      updates++;
+      if (cells > BUDGET)
+      {
+        failures++;
+      }
+      delay(UPDATE_EVERY_MS);
+    } while (blinker.pendingCells() > 0);
+
+    int wrong = checkPhase(simulator, off, field);
+    printf("%-6d %-6s %8d %10d %12lu %12d\n", phase, off ? "off" : "on", updates, maxCells, phaseCells, wrong);
+    failures += (wrong > 0) ? 1 : 0;
+  }
+
+  // --- Page model keeps the normal content ---
+  bool modelIntact = true;
+  for (int address = 0; address < NUMBER_OF_CHARACTERS; address++)
+  {
+    char expected = ((address >> 4) == 4) && ((address & 0x0F) >= 2) && ((address & 0x0F) < 5) ? "NEW"[(address & 0x0F) - 2] : screen[address];
+    modelIntact &= (display.pageCharacter(0, address) == expected);
+  }
+  printf("page model %s\n", modelIntact ? "intact" : "CHANGED");
+  failures += modelIntact ? 0 : 1;
+
+  // --- Steady again: content back ---
+  blinker.steadyAll();
+  while (blinker.update())
+  {
+    delay(UPDATE_EVERY_MS);
+  }
+  int wrong = checkPhase(simulator, false, field);
+  printf("steady: %d wrong cells\n", wrong);
+  failures += (wrong > 0) ? 1 : 0;
+
+  // --- Cursor ---
+  blinker.blinkCursor(INTERVAL_MS);
+  int toggles = 0;
+  bool shown = simulator.cursorShown();
+  unsigned long cursorStart = millis();
+  unsigned long strobesBefore = simulator.counters().characterStrobes + simulator.counters().addressStrobes;
+  while (millis() - cursorStart < 4 * INTERVAL_MS + UPDATE_EVERY_MS)
+  {
+    blinker.update();
+    if (simulator.cursorShown() != shown)
+    {
+      shown = !shown;
+      toggles++;
+    }
+    delay(UPDATE_EVERY_MS);
+  }
+  unsigned long cursorStrobes = simulator.counters().characterStrobes + simulator.counters().addressStrobes - strobesBefore;
+  blinker.blinkCursor(0);
+  printf("cursor: %d toggles in %d ms, %lu strobes, %s after stop\n", toggles, 4 * INTERVAL_MS, cursorStrobes,
+         simulator.cursorShown() ? "shown" : "HIDDEN");
+  failures += ((toggles == 4) && (cursorStrobes == 0) && simulator.cursorShown()) ? 0 : 1;
+
+  display.hideCursor();
+  failures += simulator.cursorShown() ? 1 : 0;
+
+  return (failures == 0) ? 0 : 1;
+}
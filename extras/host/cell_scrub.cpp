@@ -0,0 +1,186 @@
+/*
+  cell_scrub.cpp - Checks that cellScrubber repairs glitched cells on the simulated display on a Linux host.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License, see LICENSE.
+
+  Build and run from the library root:
+
+    g++ -std=c++11 -O2 -I extras/host -I . extras/host/Arduino.cpp extras/host/MS6205_sim.cpp \
+        MS6205*.cpp extras/host/cell_scrub.cpp -o cell_scrub && ./cell_scrub
+
+  Two pages are rendered, then cells of the visible page are corrupted behind the library's back.
+  The scrubber has to repair all of them within 160 / budget ticks, writing no more than the budget
+  per tick, and has to stay off the bus while characters are queued. Then the other page is shown
+  and glitched too. The bus time per tick is compared with a full redraw.
+  Finally, blinkEngine and the scrubber run together: the blinking rows have to show one phase
+  completely whenever the blink engine is done, as the scrubber must not write the content back
+  over the alternate characters, while a glitch outside the rows is still repaired.
+*/
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_blink.h"
+#include "MS6205_scrub.h"
+#include "MS6205_sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PIN_COST_NS              1000   // [ns] Simulated duration of one digitalWrite()
+#define BUDGET                      4
+#define INTERVAL_MS                20
+#define GLITCHES                   12
+#define BLINK_ROW                   2   // First of two blinking rows
+#define BLINK_MS                  300   // [ms] Blink interval, several sweeps of the scrubber per phase
+#define BLINK_PHASES                6
+
+static int failures = 0;
+
+static int wrongCells(MS6205Simulator &simulator, int page, const char *content)
+{
+  int wrong = 0;
+  for (int address = 0; address < NUMBER_OF_CHARACTERS; address++)
+  {
+    wrong += (simulator.page(page)[address] != content[address]) ? 1 : 0;
+  }
+  return wrong;
+}
+
+// Corrupts cells of the visible page, then scrubs until it is repaired
+static void glitchAndScrub(MS6205Simulator &simulator, cellScrubber &scrubber, int page, const char *content)
+{
+  for (int i = 0; i < GLITCHES; i++)
+  {
+    simulator.glitch(page, rand() % NUMBER_OF_CHARACTERS, '#');
+  }
+  int glitched = wrongCells(simulator, page, content);
+
+  int ticks = 0;
+  int updates = 0;
+  int maxCells = 0;
+  unsigned long long busNs = 0;
+  unsigned long long start = hostNanos();
+  while ((wrongCells(simulator, page, content) > 0) && (updates++ < 100 * NUMBER_OF_CHARACTERS))
+  {
+    unsigned long strobes = simulator.counters().characterStrobes;
+    unsigned long long before = hostNanos();
+    if (scrubber.update() > 0)
+    {
+      busNs += hostNanos() - before;
+      ticks++;
+    }
+    int cells = simulator.counters().characterStrobes - strobes;
+    maxCells = (cells > maxCells) ? cells : maxCells;
+    delay(1);
+  }
+  double seconds = (hostNanos() - start) / 1e9;
+
+  int bound = (NUMBER_OF_CHARACTERS + BUDGET - 1) / BUDGET;
+  printf("page %d: %2d cells glitched, repaired after %3d ticks (bound %d), %.2f s, max %d cells and %.0f us bus time per tick\n",
+         page, glitched, ticks, bound, seconds, maxCells, ticks ? busNs / 1000.0 / ticks : 0.0);
+  if ((wrongCells(simulator, page, content) > 0) || (ticks > bound) || (maxCells > BUDGET))
+  {
+    failures++;
+  }
+}
+
+int main(void)
+{
+  MS6205Simulator simulator;
+  simulator.attach(15, 14, 13, 12, 2, 5);
+  simulator.attachPaging(4, 0);
+  MS6205 display(15, 14, 13, 12, 2, 5);
+  display.begin();
+  display.beginPaging(4, 0);
+
+  char content[2][NUMBER_OF_CHARACTERS + 1];
+  for (int i = 0; i < NUMBER_OF_CHARACTERS; i++)
+  {
+    content[0][i] = (char)('A' + (i * 3) % 26);
+    content[1][i] = (char)('0' + (i * 7) % 10);
+  }
+  content[0][NUMBER_OF_CHARACTERS] = content[1][NUMBER_OF_CHARACTERS] = '\0';
+  display.renderPage(0, content[0]);
+  display.renderPage(1, content[1]);
+
+  // --- Full redraw for comparison ---
+  hostSetPinCostNs(PIN_COST_NS);
+  unsigned long long start = hostNanos();
+  display.clear();
+  display.invalidatePages();
+  display.renderPage(1, content[1]);
+  printf("full redraw: %.0f us\n", (hostNanos() - start) / 1000.0);
+  display.renderPage(0, content[0]);                            // invalidatePages() forgot page 0 too
+  display.showPage(1);
+
+  cellScrubber scrubber(&display);
+  scrubber.setBudget(BUDGET);
+  scrubber.setInterval(INTERVAL_MS);
+
+  glitchAndScrub(simulator, scrubber, 1, content[1]);
+
+  // --- Queued characters pause scrubbing ---
+  display.queueText(0, 0, "QUEUED");
+  unsigned long strobes = simulator.counters().characterStrobes;
+  for (int i = 0; i < 10; i++)
+  {
+    scrubber.update();
+    delay(INTERVAL_MS);
+  }
+  bool paused = (simulator.counters().characterStrobes == strobes) && (scrubber.counters().paused > 0);
+  printf("while queued: %lu cells written, %lu ticks paused\n", simulator.counters().characterStrobes - strobes,
+         scrubber.counters().paused);
+  failures += paused ? 0 : 1;
+  display.discardQueued();
+
+  display.showPage(0);
+  glitchAndScrub(simulator, scrubber, 0, content[0]);
+
+  const scrubCounters &counters = scrubber.counters();
+  printf("counters: %lu cells, %lu skipped, %lu sweeps, %lu paused\n", counters.cells, counters.skipped,
+         counters.sweeps, counters.paused);
+
+  // --- Blinking rows while scrubbing: every completed phase shows completely ---
+  blinkEngine blinker(&display);
+  blinker.setInterval(BLINK_MS);
+  blinker.blink(0, BLINK_ROW, NUMBER_OF_COLUMNS, 2);
+  scrubber.resetCounters();
+  simulator.glitch(0, cellAddress(0, BLINK_ROW + 3), '#');
+  int mixed = 0;
+  int phases[2] = {0, 0};                                       // Checks showing content, alternate
+  unsigned long blinkStart = millis();
+  while (millis() - blinkStart < BLINK_PHASES * BLINK_MS)
+  {
+    blinker.update();
+    scrubber.update();
+    if (blinker.pendingCells() == 0)
+    {
+      int alternate = 0;
+      for (int address = cellAddress(0, BLINK_ROW); address < cellAddress(0, BLINK_ROW + 2); address++)
+      {
+        alternate += (simulator.page(0)[address] == ' ') ? 1 : 0;
+        mixed += ((simulator.page(0)[address] != ' ') && (simulator.page(0)[address] != content[0][address])) ? 1 : 0;
+      }
+      if ((alternate > 0) && (alternate < 2 * NUMBER_OF_COLUMNS))
+      {
+        mixed++;                                                // Scrubber wrote content into the alternate phase
+      }
+      phases[(alternate > 0) ? 1 : 0]++;
+    }
+    delay(1);
+  }
+  blinker.steadyAll();
+  while (blinker.update())
+  {
+  }
+  bool together = (mixed == 0) && (phases[0] > 0) && (phases[1] > 0) && (scrubber.counters().skipped > 0) &&
+                  (wrongCells(simulator, 0, content[0]) == 0);
+  printf("blinking while scrubbing: %d checks on, %d off, %d mixed, %lu cells skipped, %d wrong cells: %s\n", phases[0],
+         phases[1], mixed, scrubber.counters().skipped, wrongCells(simulator, 0, content[0]), together ? "ok" : "FAILED");
+  failures += together ? 0 : 1;
+  hostSetPinCostNs(0);
+
+  return (failures == 0) ? 0 : 1;
+}
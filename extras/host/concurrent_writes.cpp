@@ -0,0 +1,160 @@
+/*
+  concurrent_writes.cpp - Stress test of writeAt() against main code on a Linux host.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License, see LICENSE.
+
+  Build and run from the library root:
+
+    g++ -std=c++11 -O2 -pthread -I extras/host -I . extras/host/Arduino.cpp extras/host/MS6205_sim.cpp \
+        MS6205*.cpp extras/host/concurrent_writes.cpp -o concurrent_writes && ./concurrent_writes
+
+  Threads stand in for interrupts: the host's noInterrupts() blocks every other thread.
+  The main thread keeps writing rows 0-4 with setCursor() + writeCharacter(), write() and
+  queueText() + flush(), while producer threads write their own cells in rows 5-9 with writeAt().
+  Each cell has a single writer, so in the end every cell must show its writer's last character,
+  and the library's page model must agree with the simulated display.
+  Finally, writeAt() is called with interrupts disabled, as from an interrupt, and must leave
+  them disabled.
+
+  Pass "unguarded" as argument to let the producers use setCursor() + writeCharacter() without
+  beginConcurrent() instead; the test then shows how many cells got corrupted.
+*/
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_sim.h"
+
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+#define ROUNDS                   2000
+#define PRODUCERS                   3
+#define MAIN_ROWS                   5   // Rows 0-4 belong to the main thread, 5-9 to the producers
+
+static MS6205 *pDisplay;
+static char expected[NUMBER_OF_CHARACTERS];
+static bool guarded = true;
+
+static char roundCharacter(int round, int address)
+{
+  return 'A' + (round + address) % 26;
+}
+
+static void producer(int index)
+{
+  for (int round = 0; round < ROUNDS; round++)
+  {
+    for (int address = MAIN_ROWS * NUMBER_OF_COLUMNS; address < NUMBER_OF_CHARACTERS; address++)
+    {
+      if (address % PRODUCERS != index)
+      {
+        continue;                                       // Cell of another producer
+      }
+
+      char character = roundCharacter(round, address);
+      if (guarded)
+      {
+        pDisplay->writeAt(address & 0x0F, address >> 4, character);
+      }
+      else
+      {
+        pDisplay->setCursor(address & 0x0F, address >> 4);
+        pDisplay->writeCharacter(character);
+      }
+      expected[address] = character;
+    }
+  }
+}
+
+static void mainLoop(void)
+{
+  char text[NUMBER_OF_COLUMNS + 1];
+
+  for (int round = 0; round < ROUNDS; round++)
+  {
+    // --- Rows 0-1: cursor and character as two calls ---
+    for (int address = 0; address < 2 * NUMBER_OF_COLUMNS; address++)
+    {
+      char character = roundCharacter(round, address);
+      pDisplay->setCursor(address & 0x0F, address >> 4);
+      pDisplay->writeCharacter(character);
+      expected[address] = character;
+    }
+
+    // --- Row 2: write(), advancing the address by itself ---
+    for (int column = 0; column < NUMBER_OF_COLUMNS; column++)
+    {
+      text[column] = roundCharacter(round, 2 * NUMBER_OF_COLUMNS + column);
+    }
+    text[NUMBER_OF_COLUMNS] = '\0';
+    pDisplay->setCursor(0, 2);
+    pDisplay->write(String(text));
+    memcpy(&expected[2 * NUMBER_OF_COLUMNS], text, NUMBER_OF_COLUMNS);
+
+    // --- Rows 3-4: queued writes, every other cell ---
+    for (int address = 3 * NUMBER_OF_COLUMNS + (round & 1); address < MAIN_ROWS * NUMBER_OF_COLUMNS; address += 2)
+    {
+      char character = roundCharacter(round, address);
+      pDisplay->queueCharacter(address & 0x0F, address >> 4, character);
+      expected[address] = character;
+    }
+    pDisplay->flush();
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  guarded = !((argc > 1) && (strcmp(argv[1], "unguarded") == 0));
+
+  MS6205Simulator simulator;
+  simulator.attach(15, 14, 13, 12, 2, 5);
+  MS6205 display(15, 14, 13, 12, 2, 5);
+  display.begin();
+  pDisplay = &display;
+  if (guarded)
+  {
+    display.beginConcurrent();
+  }
+  memset(expected, ' ', NUMBER_OF_CHARACTERS);
+
+  std::vector<std::thread> producers;
+  for (int i = 0; i < PRODUCERS; i++)
+  {
+    producers.push_back(std::thread(producer, i));
+  }
+  mainLoop();
+  for (int i = 0; i < PRODUCERS; i++)
+  {
+    producers[i].join();
+  }
+
+  // --- As from an interrupt: interrupts stay disabled after writeAt() ---
+  noInterrupts();
+  display.writeAt(0, MAIN_ROWS, '#');
+  expected[cellAddress(0, MAIN_ROWS)] = '#';
+  bool stillDisabled = (__get_PRIMASK() != 0);
+  interrupts();
+
+  int wrong = 0;
+  for (int address = 0; address < NUMBER_OF_CHARACTERS; address++)
+  {
+    if (simulator.page(0)[address] != expected[address])
+    {
+      wrong++;
+    }
+  }
+  bool modelAgrees = display.pageHolds(0, MS6205::contentHash(simulator.page(0)));
+
+  printf("%s: %d main rounds, %d producers x %d rounds\n", guarded ? "writeAt()" : "unguarded", ROUNDS, PRODUCERS, ROUNDS);
+  printf("Wrong cells: %d of %d, page model %s the display\n", wrong, NUMBER_OF_CHARACTERS, modelAgrees ? "matches" : "differs from");
+  printf("Interrupts after writeAt() from an interrupt: %s\n", stillDisabled ? "still disabled" : "enabled, FAILED");
+  if ((wrong > 0) || !modelAgrees || !stillDisabled)
+  {
+    simulator.printPage(0);
+    return 1;
+  }
+  return 0;
+}
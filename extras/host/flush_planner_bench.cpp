@@ -0,0 +1,151 @@
+/*
+  flush_planner_bench.cpp - Counts bus operations of queued flushes against direct writes on a Linux host.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License, see LICENSE.
+
+  Build and run from the library root:
+
+    g++ -std=c++11 -O2 -I extras/host -I . extras/host/Arduino.cpp extras/host/MS6205_sim.cpp \
+        MS6205*.cpp extras/host/flush_planner_bench.cpp -o flush_planner_bench && ./flush_planner_bench
+
+  For random sparse update patterns, the same cells are written once directly with
+  writeCharacter(column, row, character) in random order, and once through queueCharacter()
+  and flush(). The simulated display checks that both end up with the same content.
+*/
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_sim.h"
+
+#include <stdio.h>
+
+#define TRIALS                    200
+#define PIN_COST_NS               500   // [ns] Simulated duration of one digitalWrite()
+
+#define LATCH_PIN                  15
+#define CLOCK_PIN                  14
+#define DATA_PIN                   13
+#define SET_ADDRESS_PIN            12
+#define SET_CHARACTER_PIN           2
+#define CLEAR_PIN                   5
+#define INCREMENT_PIN              16
+
+#define MODE_DIRECT                 0   // writeCharacter() per cell
+#define MODE_FLUSH                  1   // queueCharacter() and flush()
+#define MODE_FLUSH_INCREMENT        2   // Same, with line 6B connected
+#define MODE_FLUSH_AUTO_INCREMENT   3   // Same, display advancing its address by itself
+
+static char const * const modeNames[] = {"direct writes", "flush()", "flush() + 6B", "flush() + auto-incr."};
+
+struct result
+{
+  double addressStrobes;
+  double incrementPulses;
+  double characterStrobes;
+  double microseconds;
+};
+
+static result run(int mode, int changedCells)
+{
+  MS6205Simulator simulator;
+  simulator.attach(LATCH_PIN, CLOCK_PIN, DATA_PIN, SET_ADDRESS_PIN, SET_CHARACTER_PIN, CLEAR_PIN);
+  simulator.attachIncrement(INCREMENT_PIN);
+  simulator.setAutoIncrement(mode == MODE_FLUSH_AUTO_INCREMENT);
+
+  MS6205 display(LATCH_PIN, CLOCK_PIN, DATA_PIN, SET_ADDRESS_PIN, SET_CHARACTER_PIN, CLEAR_PIN);
+
+  display.begin();
+  busCost cost = bitBangBusCost;
+  cost.autoIncrement = (mode == MODE_FLUSH_AUTO_INCREMENT);
+  display.setBusCost(cost);
+  if (mode == MODE_FLUSH_INCREMENT)
+  {
+    display.beginIncrement(INCREMENT_PIN);
+  }
+
+  char expected[NUMBER_OF_CHARACTERS + 1];
+  memset(expected, '.', NUMBER_OF_CHARACTERS);
+  expected[NUMBER_OF_CHARACTERS] = '\0';
+  display.renderPage(0, expected);
+
+  result total = {0, 0, 0, 0};
+  srand(changedCells);                                  // Same patterns for every mode
+  for (int trial = 0; trial < TRIALS; trial++)
+  {
+    // --- Pick distinct random cells, in random order ---
+    int cells[NUMBER_OF_CHARACTERS];
+    for (int i = 0; i < NUMBER_OF_CHARACTERS; i++)
+    {
+      cells[i] = i;
+    }
+    for (int i = 0; i < changedCells; i++)
+    {
+      int j = i + rand() % (NUMBER_OF_CHARACTERS - i);
+      int temp = cells[i];
+      cells[i] = cells[j];
+      cells[j] = temp;
+    }
+
+    simulator.resetCounters();
+    unsigned long long start = hostNanos();
+    for (int i = 0; i < changedCells; i++)
+    {
+      int address = cells[i];
+      char character = (expected[address] == 'Z') ? 'A' : expected[address] + 1;
+      if (character == '/')
+      {
+        character = 'A';
+      }
+      expected[address] = character;
+      if (mode == MODE_DIRECT)
+      {
+        display.writeCharacter(address & 0x0F, address >> 4, character);
+      }
+      else
+      {
+        display.queueCharacter(address & 0x0F, address >> 4, character);
+      }
+    }
+    display.flush();
+
+    if (memcmp(simulator.page(0), expected, NUMBER_OF_CHARACTERS) != 0)
+    {
+      printf("Display content differs for %s, %d cells\n", modeNames[mode], changedCells);
+      simulator.printPage(0);
+      exit(1);
+    }
+
+    total.addressStrobes += simulator.counters().addressStrobes;
+    total.incrementPulses += simulator.counters().incrementPulses;
+    total.characterStrobes += simulator.counters().characterStrobes;
+    total.microseconds += (hostNanos() - start) / 1000.0;
+  }
+
+  total.addressStrobes /= TRIALS;
+  total.incrementPulses /= TRIALS;
+  total.characterStrobes /= TRIALS;
+  total.microseconds /= TRIALS;
+  return total;
+}
+
+int main(void)
+{
+  int const densities[] = {4, 16, 48, 120};
+
+  hostSetPinCostNs(PIN_COST_NS);
+  printf("Average bus operations per update, %d random updates each, %lu ns per pin write\n\n", TRIALS, (unsigned long)PIN_COST_NS);
+  printf("cells  method                 addr  incr  char     us\n");
+  for (unsigned int d = 0; d < sizeof(densities) / sizeof(densities[0]); d++)
+  {
+    for (int mode = MODE_DIRECT; mode <= MODE_FLUSH_AUTO_INCREMENT; mode++)
+    {
+      result r = run(mode, densities[d]);
+      printf("%5d  %-20s %6.1f %5.1f %5.1f %6.0f\n", densities[d], modeNames[mode],
+             r.addressStrobes, r.incrementPulses, r.characterStrobes, r.microseconds);
+    }
+    printf("\n");
+  }
+  return 0;
+}
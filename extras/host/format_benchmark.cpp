@@ -0,0 +1,95 @@
+/*
+  format_benchmark.cpp - Compares MS6205 number fields against String and snprintf() on a Linux host.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License, see LICENSE.
+
+  Build and run from the library root:
+
+    g++ -std=c++11 -O2 -I extras/host -I . extras/host/Arduino.cpp MS6205_format.cpp \
+        extras/host/format_benchmark.cpp -o format_benchmark && ./format_benchmark
+
+  Every method produces the same right-aligned 6 character field, so only the formatting
+  work differs. The String variant mirrors what sketches did with write(String(value)).
+  Note that the host String is built on std::string, whose small string optimization avoids
+  the heap allocation the Arduino String makes, so the host favours String.
+
+  Add -DNUMBER_DIVISION_FREE=1 to measure the power-of-ten subtraction used on AVR and ESP8266.
+  It is slower on a host CPU with a fast multiplier; it only pays off on CPUs without a divider.
+*/
+
+#include "Arduino.h"
+#include "MS6205_format.h"
+
+#include <stdio.h>
+#include <chrono>
+
+#define FIELD_WIDTH                 6
+#define ITERATIONS            2000000L
+
+static volatile char sink;                      // Keeps the optimizer from dropping the work
+
+static void fieldWithFormatter(char *field, long value)
+{
+  bool negative = value < 0;
+  formatField(field, FIELD_WIDTH, negative, negative ? -value : value, 10, 0, ALIGN_RIGHT, ' ');
+}
+
+static void fieldWithString(char *field, long value)
+{
+  String text(value);
+  unsigned int length = text.length();
+  memset(field, ' ', FIELD_WIDTH);
+  for (unsigned int i = 0; i < length; i++)
+  {
+    field[FIELD_WIDTH - length + i] = text.charAt(i);
+  }
+  field[FIELD_WIDTH] = '\0';
+}
+
+static void fieldWithSprintf(char *field, long value)
+{
+  snprintf(field, FIELD_WIDTH + 1, "%*ld", FIELD_WIDTH, value);
+}
+
+static double measure(const char *name, void (*method)(char *, long))
+{
+  char field[FIELD_WIDTH + 1];
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (long i = 0; i < ITERATIONS; i++)
+  {
+    method(field, (i * 7919L) % 200000L - 100000L / 10);
+    sink = field[FIELD_WIDTH - 1];
+  }
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  double nsPerCall = elapsed.count() / ITERATIONS;
+  printf("  %-22s %8.1f ns/field\n", name, nsPerCall);
+  return nsPerCall;
+}
+
+int main(void)
+{
+  // --- Check that all methods agree ---
+  long const samples[] = {0, 7, -7, 42, -999, 12345, 99999, -99999};
+  for (unsigned int i = 0; i < sizeof(samples) / sizeof(samples[0]); i++)
+  {
+    char a[FIELD_WIDTH + 1], b[FIELD_WIDTH + 1], c[FIELD_WIDTH + 1];
+    fieldWithFormatter(a, samples[i]);
+    fieldWithString(b, samples[i]);
+    fieldWithSprintf(c, samples[i]);
+    if ((strcmp(a, b) != 0) || (strcmp(a, c) != 0))
+    {
+      printf("Mismatch for %ld: \"%s\" \"%s\" \"%s\"\n", samples[i], a, b, c);
+      return 1;
+    }
+  }
+
+  printf("%ld fields of %d characters:\n", ITERATIONS, FIELD_WIDTH);
+  double formatter = measure("formatField()", fieldWithFormatter);
+  double string = measure("String(value)", fieldWithString);
+  double sprintf = measure("snprintf()", fieldWithSprintf);
+  printf("Speedup of formatField(): %.1fx against String, %.1fx against snprintf()\n",
+         string / formatter, sprintf / formatter);
+  return 0;
+}
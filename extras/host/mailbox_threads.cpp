@@ -0,0 +1,164 @@
+/*
+  mailbox_threads.cpp - Runs displayTask with std::thread on a Linux host.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License, see LICENSE.
+
+  Build and run from the library root:
+
+    g++ -std=c++11 -O2 -pthread -I extras/host -I . extras/host/Arduino.cpp extras/host/MS6205_sim.cpp \
+        MS6205*.cpp extras/host/mailbox_threads.cpp -o mailbox_threads && ./mailbox_threads
+
+  Stands in for the ESP32 port: a producer thread posts numbered frames at a high rate,
+  while a consumer thread plays the FreeRTOS display task and renders them on the simulated
+  display. After every rendered frame, the simulated display must show one complete frame,
+  never a mix of two, and frame numbers must only go up.
+  Simulated time only passes while the consumer renders. The producer posts the next frame after
+  POST_INTERVAL_US of it, or as soon as the consumer has shown the frame posted last, so it never
+  runs ahead of a consumer that has not started yet. The consumer's strobe hook holds the render
+  until the producer has posted the frame that is due, so the handoff does not depend on how the
+  threads are scheduled. A frame takes ~20 times POST_INTERVAL_US to render, so most frames have
+  to be replaced by newer ones, while at least MIN_RENDERED frames have to be handed over and
+  rendered. The last frame posted has to be shown in the end.
+*/
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_task.h"
+#include "MS6205_sim.h"
+
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#define FRAMES                   5000
+#define POST_INTERVAL_US          500   // [us] Simulated time between two frames while one is rendered
+#define PIN_COST_NS              1000   // [ns] Simulated duration of one digitalWrite(), a frame takes ~10 ms
+#define MIN_RENDERED               50   // Frames that have to be handed over at least
+#define SEQUENCE_DIGITS             8
+
+static std::atomic<bool> done(false);                   // All frames posted
+static std::atomic<unsigned long long> dueNs(0);        // [ns] Simulated time the producer posts the next frame
+
+// Consumer thread, on every strobe: never run past a frame that is due but not posted yet
+static void onStrobe(uint8_t pin, uint8_t bus)
+{
+  (void)pin;
+  (void)bus;
+
+  while (!done && (hostNanos() >= dueNs))
+  {
+    std::this_thread::yield();
+  }
+}
+
+static void fillFrame(char *content, long sequence)
+{
+  char field[SEQUENCE_DIGITS + 1];
+  formatField(field, SEQUENCE_DIGITS, false, sequence, 10, 0, ALIGN_RIGHT, '0');
+  memcpy(content, field, SEQUENCE_DIGITS);
+  memset(&content[SEQUENCE_DIGITS], 'A' + sequence % 26, NUMBER_OF_CHARACTERS - SEQUENCE_DIGITS);
+}
+
+static long checkFrame(const char *content)
+{
+  long sequence = strtol(std::string(content, SEQUENCE_DIGITS).c_str(), NULL, 10);
+  for (int i = SEQUENCE_DIGITS; i < NUMBER_OF_CHARACTERS; i++)
+  {
+    if (content[i] != 'A' + sequence % 26)
+    {
+      return -1;                                        // Torn frame
+    }
+  }
+  return sequence;
+}
+
+int main(void)
+{
+  MS6205Simulator simulator;
+  simulator.attach(15, 14, 13, 12, 2, 5);
+  MS6205 display(15, 14, 13, 12, 2, 5);
+  display.begin();
+  simulator.setStrobeHook(onStrobe);
+  displayTask task(&display);
+  hostSetPinCostNs(PIN_COST_NS);
+
+  std::atomic<bool> failed(false);
+  std::atomic<long> last(0);                            // Frame shown last
+  double longestPostUs = 0;
+
+  // --- Producer: application posting frames ---
+  std::thread producer([&]()
+  {
+    for (long sequence = 1; sequence <= FRAMES; sequence++)
+    {
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      fillFrame(task.back()->content, sequence);
+      task.back()->page = 0;
+      task.publish();
+      dueNs = hostNanos() + POST_INTERVAL_US * 1000ULL;
+      std::chrono::duration<double, std::micro> took = std::chrono::steady_clock::now() - start;
+      if (took.count() > longestPostUs)
+      {
+        longestPostUs = took.count();
+      }
+
+      // --- Next frame after POST_INTERVAL_US on the simulated bus, or once this one is shown ---
+      while ((hostNanos() < dueNs) && (last < sequence) && !failed)
+      {
+        std::this_thread::yield();
+      }
+    }
+    done = true;
+  });
+
+  // --- Consumer: display task ---
+  long rendered = 0;
+  unsigned long long renderNs = 0;
+  std::thread consumer([&]()
+  {
+    for (;;)
+    {
+      bool finished = done;                             // Read before update(), so the last frame is not missed
+      unsigned long long start = hostNanos();
+      if (task.update())
+      {
+        renderNs += hostNanos() - start;
+        long sequence = checkFrame(simulator.page(0));
+        if ((sequence < 0) || (sequence <= last))
+        {
+          printf("Bad frame after %ld (got %ld)\n", (long)last, sequence);
+          simulator.printPage(0);
+          failed = true;
+          return;
+        }
+        rendered++;
+        last = sequence;
+      }
+      else if (finished)
+      {
+        return;
+      }
+    }
+  });
+
+  producer.join();
+  consumer.join();
+
+  hostSetPinCostNs(0);
+
+  printf("%d frames posted, %ld rendered, %ld replaced by newer ones before rendering\n", FRAMES, rendered, FRAMES - rendered);
+  printf("Render: %.0f us per frame on the simulated bus, a frame posted every %d us\n",
+         rendered ? renderNs / 1000.0 / rendered : 0.0, POST_INTERVAL_US);
+  printf("Longest post: %.1f us, last frame shown: %ld\n", longestPostUs, (long)last);
+
+  if (failed || (last != FRAMES) || (rendered < MIN_RENDERED) || (rendered >= FRAMES))
+  {
+    printf("FAILED: %s\n", failed ? "torn or old frame shown" : (last != FRAMES) ? "last frame not shown" :
+           (rendered < MIN_RENDERED) ? "too few frames handed over" : "no frame replaced");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,194 @@
+/*
+  parallel_transport.cpp - Checks the parallel and dual shift register transports against the 74HC595 on a Linux host.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License, see LICENSE.
+
+  Build and run from the library root:
+
+    g++ -std=c++11 -O2 -I extras/host -I . extras/host/Arduino.cpp extras/host/MS6205_sim.cpp \
+        MS6205*.cpp extras/host/parallel_transport.cpp -o parallel_transport && ./parallel_transport
+
+  The same sequence of writes runs through every transport. The simulated display records the
+  byte on the bus at every /Set address and /Set character strobe; all transports have to produce
+  exactly the sequence of the 74HC595, and the same page content. Then a full page is rendered,
+  and written by write(), through each transport to compare the simulated bus time. write() must
+  not take more pin writes with two 74HC595 than with one.
+*/
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_sim.h"
+
+#include <stdio.h>
+
+#define PIN_COST_NS              1000   // [ns] Simulated duration of one digitalWrite()
+#define MAX_STROBES              1024
+
+#define LATCH_PIN                  15
+#define CLOCK_PIN                  14
+#define DATA_PIN                   13
+#define SET_ADDRESS_PIN            12
+#define SET_CHARACTER_PIN           2
+#define CLEAR_PIN                   5
+
+static uint8_t const busPins[8] = {20, 21, 22, 23, 24, 25, 26, 27};
+static volatile uint8_t port = 0;                // Stands in for PORTD
+static volatile uint8_t direction = 0;           // Stands in for DDRD
+
+static char const * const transportNames[] = {"74HC595", "8-bit port", "8 pins", "2 x 74HC595"};
+
+struct strobe
+{
+  uint8_t pin;
+  uint8_t bus;
+};
+
+static strobe strobes[MAX_STROBES];
+static int strobeCount = 0;
+
+static void onStrobe(uint8_t pin, uint8_t bus)
+{
+  if (strobeCount < MAX_STROBES)
+  {
+    strobes[strobeCount].pin = pin;
+    strobes[strobeCount].bus = bus;
+  }
+  strobeCount++;
+}
+
+static void setTransport(MS6205Simulator &simulator, MS6205 &display, int transport)
+{
+  if (transport == TRANSPORT_PARALLEL_PORT)
+  {
+    simulator.attachParallel(&port);
+    display.beginParallel(&port, &direction);
+  }
+  else if (transport == TRANSPORT_PARALLEL_PINS)
+  {
+    simulator.attachParallel(busPins);
+    display.beginParallel(busPins);
+  }
+  else if (transport == TRANSPORT_DUAL_SHIFT_REGISTER)
+  {
+    simulator.attachDualShiftRegister();
+    display.beginDualShiftRegister();
+  }
+}
+
+int main(void)
+{
+  strobe reference[MAX_STROBES];
+  int referenceCount = 0;
+  char referencePage[SIM_CELLS];
+  int failures = 0;
+
+  // --- Byte and strobe sequence ---
+  for (int transport = TRANSPORT_SHIFT_REGISTER; transport <= TRANSPORT_DUAL_SHIFT_REGISTER; transport++)
+  {
+    MS6205Simulator simulator;
+    simulator.attach(LATCH_PIN, CLOCK_PIN, DATA_PIN, SET_ADDRESS_PIN, SET_CHARACTER_PIN, CLEAR_PIN);
+    MS6205 display(LATCH_PIN, CLOCK_PIN, DATA_PIN, SET_ADDRESS_PIN, SET_CHARACTER_PIN, CLEAR_PIN);
+    display.begin();
+    setTransport(simulator, display, transport);
+
+    strobeCount = 0;
+    simulator.setStrobeHook(onStrobe);
+
+    display.setCursor(0, 0);
+    display.write("PARALLEL BUS");
+    display.writeCharacter(15, 9, 'Z');
+    display.writeBlock(7, 4);
+    display.writeAt(3, 6, '#');
+    display.writeBigNumber(10, 3, 42);
+    display.queueText(0, 8, "QUEUED");
+    display.flush();
+
+    simulator.setStrobeHook(NULL);
+
+    if (transport == TRANSPORT_SHIFT_REGISTER)
+    {
+      referenceCount = strobeCount;
+      memcpy(reference, strobes, sizeof(reference));
+      memcpy(referencePage, simulator.page(0), SIM_CELLS);
+      printf("%-12s %4d strobes (reference)\n", transportNames[transport], strobeCount);
+      continue;
+    }
+
+    bool sameSequence = (strobeCount == referenceCount);
+    for (int i = 0; sameSequence && (i < strobeCount) && (i < MAX_STROBES); i++)
+    {
+      sameSequence = (strobes[i].pin == reference[i].pin) && (strobes[i].bus == reference[i].bus);
+    }
+    bool samePage = (memcmp(referencePage, simulator.page(0), SIM_CELLS) == 0);
+
+    printf("%-12s %4d strobes, sequence %s, page %s\n", transportNames[transport], strobeCount,
+           sameSequence ? "identical" : "DIFFERENT", samePage ? "identical" : "DIFFERENT");
+    if (!sameSequence || !samePage)
+    {
+      failures++;
+    }
+  }
+
+  // --- Bus time of a full page ---
+  char content[NUMBER_OF_CHARACTERS + 1];
+  for (int i = 0; i < NUMBER_OF_CHARACTERS; i++)
+  {
+    content[i] = (char)('A' + (i * 7) % 26);
+  }
+  content[NUMBER_OF_CHARACTERS] = '\0';
+
+  printf("\nFull page of %d cells, %lu ns per digitalWrite():\n", NUMBER_OF_CHARACTERS, (unsigned long)PIN_COST_NS);
+  printf("%-12s %-14s %12s %12s %10s %10s\n", "transport", "through", "pin writes", "latches", "time [us]", "[us/cell]");
+  unsigned long shiftRegisterWrites = 0;
+  for (int run = 0; run < 2 * (TRANSPORT_DUAL_SHIFT_REGISTER + 1); run++)
+  {
+    int transport = run >> 1;
+    bool throughWrite = (run & 1) != 0;
+    MS6205Simulator simulator;
+    simulator.attach(LATCH_PIN, CLOCK_PIN, DATA_PIN, SET_ADDRESS_PIN, SET_CHARACTER_PIN, CLEAR_PIN);
+    hostSetPinCostNs(0);
+    MS6205 display(LATCH_PIN, CLOCK_PIN, DATA_PIN, SET_ADDRESS_PIN, SET_CHARACTER_PIN, CLEAR_PIN);
+    display.begin();
+    setTransport(simulator, display, transport);
+    hostSetPinCostNs(PIN_COST_NS);
+
+    unsigned long writesBefore = hostPinWrites();
+    unsigned long latchesBefore = simulator.counters().bytesLatched;
+    unsigned long long start = hostNanos();
+    if (throughWrite)
+    {
+      display.setCursor(0, 0);
+      display.write(content);
+    }
+    else
+    {
+      display.renderPage(0, content);
+    }
+    double microseconds = (hostNanos() - start) / 1000.0;
+    unsigned long pinWrites = hostPinWrites() - writesBefore;
+
+    printf("%-12s %-14s %12lu %12lu %10.0f %10.1f\n", transportNames[transport], throughWrite ? "write()" : "renderPage()",
+           pinWrites, simulator.counters().bytesLatched - latchesBefore, microseconds, microseconds / NUMBER_OF_CHARACTERS);
+    if (memcmp(content, simulator.page(0), SIM_CELLS) != 0)
+    {
+      printf("  page content DIFFERENT\n");
+      failures++;
+    }
+
+    // --- write() must not get slower with the second 74HC595 ---
+    if (throughWrite && (transport == TRANSPORT_SHIFT_REGISTER))
+    {
+      shiftRegisterWrites = pinWrites;
+    }
+    if (throughWrite && (transport == TRANSPORT_DUAL_SHIFT_REGISTER) && (pinWrites > shiftRegisterWrites))
+    {
+      printf("  write() slower than through one 74HC595\n");
+      failures++;
+    }
+  }
+  hostSetPinCostNs(0);
+
+  return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,233 @@
+/*
+  priority_lanes.cpp - Measures how long urgent characters wait during bulk updates on the simulated display on a Linux host.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License, see LICENSE.
+
+  Build and run from the library root, with the clear cost of an AVR, so renderPage() clears:
+
+    g++ -std=c++11 -O2 -I extras/host -I . -DCLEAR_COST_IN_WRITES=100 extras/host/Arduino.cpp \
+        extras/host/MS6205_sim.cpp MS6205*.cpp extras/host/priority_lanes.cpp -o priority_lanes && ./priority_lanes
+
+  An "interrupt", raised from the simulator's strobe hook every few cells, queues an alarm character
+  while renderPage(), write() or flush() repaint the whole screen. Worst and average latency are
+  taken from the simulator, from the alarm to the strobe showing it, and must stay below LATENCY_LIMIT_US.
+  The bulk update must not write any cell twice, and the screen has to end up with the new content
+  and the newest alarm. For comparison, the alarm is written by loop() after the repaint.
+  An alarm raised when renderPage() clears a page waits for the 20 ms hold and has to miss the limit,
+  unless the urgent lane was used before or beginUrgent() was called, which leave out the clear.
+  Characters queued inside the urgent region have to bypass flush()'s queue.
+*/
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_sim.h"
+
+#include <stdio.h>
+
+#if CLEAR_COST_IN_WRITES >= NUMBER_OF_CHARACTERS
+  #error "Build with -DCLEAR_COST_IN_WRITES=100, renderPage() never clears otherwise"
+#endif
+
+#define PIN_COST_NS              1000   // [ns] Simulated duration of one digitalWrite()
+#define ALARM_EVERY                23   // [cells] Character strobes between two alarms
+#define ALARM_COLUMN               15
+#define ALARM_ROW                   0
+#define CLEAR_PIN                   5
+#define LATENCY_LIMIT_US         1000   // [us] Requirement
+
+#define PATH_LANE                   0   // Alarm queued by queueUrgent(), the bulk update writes it
+#define PATH_LOOP                   1   // Alarm written by loop() once the bulk update returned
+
+static MS6205Simulator simulator;
+static MS6205 *pDisplay = NULL;
+
+static int path = PATH_LANE;
+static bool armed = false;                                      // Raise alarms from the strobe hook
+static bool pending = false;                                    // Alarm raised, not shown yet
+static char alarmCharacter = '*';
+static unsigned long long raisedNs = 0;
+static unsigned long long worstNs = 0;
+static unsigned long long totalNs = 0;
+static unsigned long shownAlarms = 0;
+static unsigned long alarms = 0;
+static unsigned long strobes = 0;
+
+static void raiseAlarm(void)
+{
+  alarmCharacter = (alarmCharacter == '*') ? '!' : '*';
+  raisedNs = hostNanos();
+  pending = true;
+  alarms++;
+  if (path == PATH_LANE)
+  {
+    pDisplay->queueUrgent(ALARM_COLUMN, ALARM_ROW, alarmCharacter);
+  }
+}
+
+static void onStrobe(uint8_t pin, uint8_t bus)
+{
+  (void)bus;
+
+  if ((pin == CLEAR_PIN) && armed && !pending)
+  {
+    raiseAlarm();                                               // "Interrupt" right as the page is cleared
+    return;
+  }
+  if (pin != 2)
+  {
+    return;                                                     // /Set address
+  }
+
+  // --- Alarm shown? Seen one strobe late at worst, so it is measured a little long ---
+  if (pending && (simulator.page(simulator.visiblePage())[cellAddress(ALARM_COLUMN, ALARM_ROW)] == alarmCharacter))
+  {
+    unsigned long long latency = hostNanos() - raisedNs;
+    worstNs = (latency > worstNs) ? latency : worstNs;
+    totalNs += latency;
+    shownAlarms++;
+    pending = false;
+  }
+
+  // --- "Interrupt": raise the next alarm ---
+  if (armed && !pending && ((++strobes % ALARM_EVERY) == 0))
+  {
+    raiseAlarm();
+  }
+}
+
+static void fill(char *frame, char first)
+{
+  for (int i = 0; i < NUMBER_OF_CHARACTERS; i++)
+  {
+    frame[i] = (char)(first + i % 26);
+  }
+  frame[NUMBER_OF_CHARACTERS] = '\0';
+}
+
+static int failures = 0;
+
+// Runs one bulk update with alarms, then checks content, cells written and latency
+static void measure(const char *name, int bulk, const char *frame, int differing, bool fastExpected)
+{
+  MS6205 &display = *pDisplay;
+  simulator.resetCounters();
+  display.resetUrgentCounts();
+  worstNs = 0;
+  totalNs = 0;
+  shownAlarms = 0;
+  alarms = 0;
+  strobes = 0;
+  pending = false;
+  armed = true;
+
+  unsigned long long start = hostNanos();
+  switch (bulk)
+  {
+    case 0:
+      display.renderPage(0, frame);
+      break;
+
+    case 1:
+      display.setCursor(0, 0);
+      display.write(frame);
+      break;
+
+    default:
+      display.queueText(0, 0, frame);
+      display.flush();
+      break;
+  }
+  armed = false;
+  double took = (hostNanos() - start) / 1e6;
+
+  // --- loop() after the bulk update ---
+  bool late = pending && (path == PATH_LOOP);
+  if (late)
+  {
+    display.writeCharacter(ALARM_COLUMN, ALARM_ROW, alarmCharacter);
+  }
+  display.flushUrgent();
+  onStrobe(2, 0);                                               // Catch an alarm shown by the very last strobe
+
+  // --- New content everywhere but the alarm cell, every differing cell written once ---
+  int alarm = cellAddress(ALARM_COLUMN, ALARM_ROW);
+  bool shown = (simulator.page(0)[alarm] == alarmCharacter);
+  for (int address = 0; address < NUMBER_OF_CHARACTERS; address++)
+  {
+    shown &= (address == alarm) || (simulator.page(0)[address] == frame[address]);
+  }
+  unsigned long written = simulator.counters().characterStrobes;
+  unsigned long urgent = display.urgentCounts().written;
+  bool once = (bulk == 2) || (written <= (unsigned long)differing + urgent + (late ? 1 : 0));   // flush() may rewrite cells to move
+
+  double worst = worstNs / 1000.0;
+  bool fast = (worst < LATENCY_LIMIT_US);
+  bool expected = (fast == fastExpected);
+  printf("%-32s %7.2f ms %5lu cells %4lu alarms %9.1f us %9.1f us   %s\n", name, took, written, alarms, worst,
+         shownAlarms ? totalNs / 1000.0 / shownAlarms : 0.0,
+         (shown && once && expected) ? (fast ? "ok" : "ok, over limit as expected") : "FAILED");
+  failures += (shown && once && expected) ? 0 : 1;
+}
+
+int main(void)
+{
+  simulator.attach(15, 14, 13, 12, 2, 5);
+  simulator.setStrobeHook(onStrobe);
+  MS6205 display(15, 14, 13, 12, 2, 5);
+  pDisplay = &display;
+  display.begin();
+  hostSetPinCostNs(PIN_COST_NS);
+
+  char frames[3][NUMBER_OF_CHARACTERS + 1];
+  fill(frames[0], 'A');
+  fill(frames[1], 'a');                                         // Cyrillic, every cell differs
+  fill(frames[2], '0');                                         // No lower case letters, write() turns them upper case
+  char blank[NUMBER_OF_CHARACTERS + 1];
+  memset(blank, ' ', NUMBER_OF_CHARACTERS);
+  blank[NUMBER_OF_CHARACTERS] = '\0';
+
+  printf("Alarm every %d cells, %lu ns per digitalWrite(), limit %d us:\n", ALARM_EVERY, (unsigned long)PIN_COST_NS,
+         LATENCY_LIMIT_US);
+  printf("%-32s %10s %11s %11s %12s %12s\n", "bulk update", "took", "written", "alarms", "worst", "average");
+
+  // --- Without the urgent lane, for comparison ---
+  path = PATH_LOOP;
+  display.renderPage(0, frames[0]);
+  measure("renderPage(), alarm in loop()", 0, frames[1], NUMBER_OF_CHARACTERS, false);
+
+  // --- First alarm while renderPage() clears: waits for the hold ---
+  path = PATH_LANE;
+  measure("renderPage() clearing", 0, blank, NUMBER_OF_CHARACTERS, false);
+
+  // --- Urgent lane in use, renderPage() writes cells instead of clearing ---
+  measure("renderPage()", 0, frames[0], NUMBER_OF_CHARACTERS, true);
+  measure("write()", 1, frames[2], NUMBER_OF_CHARACTERS, true);
+  measure("queueText() + flush()", 2, frames[0], NUMBER_OF_CHARACTERS, true);
+  measure("renderPage() to a blank page", 0, blank, NUMBER_OF_CHARACTERS, true);
+
+  // --- beginUrgent(): no clear even before the first alarm ---
+  MS6205 fresh(15, 14, 13, 12, 2, 5);
+  pDisplay = &fresh;
+  fresh.begin();
+  fresh.renderPage(0, frames[0]);
+  fresh.beginUrgent();
+  measure("renderPage(), beginUrgent()", 0, blank, NUMBER_OF_CHARACTERS, true);
+  pDisplay = &display;
+  display.renderPage(0, blank);
+
+  // --- Region: queued characters inside go to the urgent lane ---
+  display.resetUrgentCounts();
+  display.setUrgentRegion(ALARM_COLUMN, ALARM_ROW, 1, 1);
+  display.queueText(0, 0, "BULK-TEXT");
+  display.queueCharacter(ALARM_COLUMN, ALARM_ROW, '#');
+  bool region = (display.queuedCharacters() == 9) && (display.urgentCounts().written == 0);
+  display.flush();
+  region &= (simulator.page(0)[cellAddress(ALARM_COLUMN, ALARM_ROW)] == '#') && (display.urgentCounts().written == 1);
+  printf("urgent region: %s\n", region ? "ok" : "FAILED");
+  failures += region ? 0 : 1;
+
+  hostSetPinCostNs(0);
+  return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+#
+# remote_bench.py - Throughput and latency of the remote protocol against remote_device on a Linux host.
+#
+# Copyright 2018 Christian Holzapfel
+#
+# Released under the MIT License, see LICENSE.
+#
+# Build remote_device first (see remote_device.cpp), then run from the library root:
+#
+#   python3 extras/host/remote_bench.py [./remote_device [--pin-ns NS] [--tcp PORT] [--window BYTES]]
+#
+# Talks to the simulated display through a pseudo terminal (or TCP), with the reference client
+# extras/tools/ms6205_remote.py. Pseudo terminals and loopback TCP have no baud rate, so the
+# results show what the device side and the display bus can take; the rates a serial line
+# allows are computed from the bytes per frame. At the end, the display content is compared
+# with the last frame sent.
+
+import os
+import random
+import subprocess
+import sys
+import time
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "tools"))
+from ms6205_remote import RemoteDisplay, encode_frame, cell_runs  # noqa: E402
+
+FRAMES = 300
+BAUD_RATES = (115200, 921600)
+
+
+def random_content(rng):
+    return bytes(rng.choice(b"ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 ") for _ in range(160))
+
+
+def changed(rng, content, cells):
+    content = bytearray(content)
+    for address in rng.sample(range(160), cells):
+        content[address] = ord("A") + (content[address] - ord("A") + 1) % 26
+    return bytes(content)
+
+
+def percentile(values, share):
+    values = sorted(values)
+    return values[min(len(values) - 1, int(share * len(values)))]
+
+
+def run(display, name, contents, windowed):
+    window = display.window
+    if not windowed:
+        display.window = 1                      # Stop and wait: one frame in flight
+    display.latencies = []
+    sent_bytes = 0
+    previous = None
+    start = time.monotonic()
+    for content in contents:
+        payloads = cell_runs(previous, content)
+        if sum(len(payload) for payload in payloads) >= 160:
+            sent_bytes += len(encode_frame(1, 0, content))
+        else:
+            sent_bytes += sum(len(encode_frame(2, 0, payload)) for payload in payloads)
+        display.show(content)
+        previous = content
+    display.sync()
+    elapsed = time.monotonic() - start
+    display.window = window
+
+    per_frame = sent_bytes / len(contents)
+    serial = "  ".join("%6.0f fps @ %d" % (baud / 10.0 / per_frame, baud) for baud in BAUD_RATES)
+    print("%-26s %7.0f fps  %6.1f bytes/frame  latency p50 %5.2f ms, p99 %5.2f ms   %s"
+          % (name, len(contents) / elapsed, per_frame, 1000 * percentile(display.latencies, 0.5),
+             1000 * percentile(display.latencies, 0.99), serial))
+
+
+def main():
+    command = sys.argv[1:] or ["./remote_device"]
+    device = subprocess.Popen(command, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    port = device.stdout.readline().decode().strip()
+    rng = random.Random(6205)
+
+    last = None
+    with RemoteDisplay(port) as display:
+        print("Protocol version %d, receive window %d bytes, %s\n" % (display.version, display.window, port))
+        display.clear()
+
+        for cells in (4, 16, 160):
+            content = random_content(rng)
+            contents = [content]
+            for _ in range(FRAMES - 1):
+                contents.append(changed(rng, contents[-1], cells) if cells < 160 else random_content(rng))
+            display.full_frame(contents[0])
+            display.sync()
+            run(display, "%3d cells, stop and wait" % cells, contents[1:], False)
+            run(display, "%3d cells, windowed" % cells, list(reversed(contents[:-1])), True)
+            last = contents[0]
+        if display.resent:
+            print("\n%d frames resent" % display.resent)
+
+    device.terminate()
+    _, report = device.communicate()
+    lines = report.decode().splitlines()
+    shown = "".join(line[1:17] for line in lines[1:11])
+    print("\n" + "\n".join(lines[0:11]))
+    if shown != last.decode():
+        print("Display content differs from the last frame sent")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,251 @@
+/*
+  remote_device.cpp - Runs remoteDisplay on the simulated display, reachable through a pty or TCP, on a Linux host.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License, see LICENSE.
+
+  Build from the library root:
+
+    g++ -std=c++11 -O2 -I extras/host -I . extras/host/Arduino.cpp extras/host/MS6205_sim.cpp \
+        MS6205*.cpp extras/host/remote_device.cpp -o remote_device
+
+  Run:
+
+    ./remote_device [--tcp PORT] [--pin-ns NS] [--window BYTES]
+
+  Without --tcp, a pseudo terminal is opened and its path is printed as the first line, so any
+  serial client can connect to it. Simulated time follows real time, and bus operations take their
+  simulated time in real time too: the control line hold times, and with --pin-ns every digitalWrite(),
+  so the bus is as slow as on the real CPU (e.g. --pin-ns 2000 for an ESP8266).
+  Prints the frame counters and what the display shows when it receives SIGINT or SIGTERM.
+*/
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_remote.h"
+#include "MS6205_sim.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#define RECEIVE_BUFFER_SIZE      4096
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void onSignal(int signal)
+{
+  (void)signal;
+  stopRequested = 1;
+}
+
+// Stream on a file descriptor, like HardwareSerial or WiFiClient on the device
+class fdStream : public Stream
+{
+  public:
+    fdStream(int fd) : _fd(fd), _head(0), _tail(0) {}
+
+    int available(void)
+    {
+      fill();
+      return _tail - _head;
+    }
+
+    int read(void)
+    {
+      return (available() > 0) ? _buffer[_head++] : -1;
+    }
+
+    int peek(void)
+    {
+      return (available() > 0) ? _buffer[_head] : -1;
+    }
+
+    size_t write(uint8_t value)
+    {
+      return write(&value, 1);
+    }
+
+    size_t write(const uint8_t *buffer, size_t size)
+    {
+      size_t written = 0;
+      while (written < size)
+      {
+        ssize_t result = ::write(_fd, buffer + written, size - written);
+        if (result < 0)
+        {
+          if (errno == EAGAIN)
+          {
+            struct pollfd out = {_fd, POLLOUT, 0};
+            poll(&out, 1, 100);
+            continue;
+          }
+          break;
+        }
+        written += result;
+      }
+      return written;
+    }
+
+  private:
+    int _fd;
+    uint8_t _buffer[RECEIVE_BUFFER_SIZE];
+    int _head;
+    int _tail;
+
+    void fill(void)
+    {
+      if (_head < _tail)
+      {
+        return;
+      }
+      ssize_t result = ::read(_fd, _buffer, sizeof(_buffer));
+      _head = 0;
+      _tail = (result > 0) ? result : 0;
+    }
+};
+
+static int openPty(void)
+{
+  int fd = posix_openpt(O_RDWR | O_NOCTTY);
+  if ((fd < 0) || (grantpt(fd) != 0) || (unlockpt(fd) != 0))
+  {
+    perror("posix_openpt");
+    return -1;
+  }
+
+  // Raw bytes, no echo, no line editing on the client side
+  int slave = open(ptsname(fd), O_RDWR | O_NOCTTY);
+  struct termios settings;
+  tcgetattr(slave, &settings);
+  cfmakeraw(&settings);
+  tcsetattr(slave, TCSANOW, &settings);
+  close(slave);
+
+  printf("%s\n", ptsname(fd));
+  fflush(stdout);
+  return fd;
+}
+
+static int acceptTcp(int port)
+{
+  int server = socket(AF_INET, SOCK_STREAM, 0);
+  int on = 1;
+  setsockopt(server, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+  struct sockaddr_in address;
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = htons(port);
+  if ((bind(server, (struct sockaddr *)&address, sizeof(address)) != 0) || (listen(server, 1) != 0))
+  {
+    perror("bind");
+    return -1;
+  }
+
+  printf("tcp:127.0.0.1:%d\n", port);
+  fflush(stdout);
+  int fd = accept(server, NULL, NULL);
+  close(server);
+  if (fd >= 0)
+  {
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+  }
+  return fd;
+}
+
+int main(int argc, char *argv[])
+{
+  int port = 0;
+  unsigned long pinNs = 0;
+  int window = 256;
+  for (int i = 1; i + 1 < argc; i += 2)
+  {
+    if (strcmp(argv[i], "--tcp") == 0)
+    {
+      port = atoi(argv[i + 1]);
+    }
+    else if (strcmp(argv[i], "--pin-ns") == 0)
+    {
+      pinNs = strtoul(argv[i + 1], NULL, 10);
+    }
+    else if (strcmp(argv[i], "--window") == 0)
+    {
+      window = atoi(argv[i + 1]);
+    }
+  }
+
+  signal(SIGINT, onSignal);
+  signal(SIGTERM, onSignal);
+
+  int fd = (port > 0) ? acceptTcp(port) : openPty();
+  if (fd < 0)
+  {
+    return 1;
+  }
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+  MS6205Simulator simulator;
+  simulator.attach(15, 14, 13, 12, 2, 5);
+  simulator.attachPaging(4, 0);
+  MS6205 display(15, 14, 13, 12, 2, 5);
+  display.begin();
+  display.beginPaging(4, 0);
+  hostSetPinCostNs(pinNs);
+
+  fdStream stream(fd);
+  remoteDisplay remote(&display, &stream, window);
+
+  // --- loop() ---
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  unsigned long long simulatedStart = hostNanos();
+  while (!stopRequested)
+  {
+    struct pollfd in = {fd, POLLIN, 0};
+    if ((stream.available() == 0) && (poll(&in, 1, 10) > 0) && (in.revents & (POLLHUP | POLLERR)) && !(in.revents & POLLIN))
+    {
+      if (port > 0)
+      {
+        break;                                          // TCP client gone
+      }
+      usleep(10000);                                    // pty without client yet
+    }
+    remote.update();
+
+    // --- Keep simulated time in step with real time: wait for the bus, or let idle time pass ---
+    unsigned long long simulated = hostNanos() - simulatedStart;
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    unsigned long long real = (now.tv_sec - start.tv_sec) * 1000000000ULL + now.tv_nsec - start.tv_nsec;
+    if (simulated > real)
+    {
+      struct timespec pause = {(time_t)((simulated - real) / 1000000000ULL), (long)((simulated - real) % 1000000000ULL)};
+      nanosleep(&pause, NULL);
+    }
+    else
+    {
+      hostAdvanceNs(real - simulated);
+    }
+  }
+
+  fprintf(stderr, "%lu frames applied, %lu rejected, page %d shows:\n", remote.frames(), remote.errors(), simulator.visiblePage());
+  fflush(stderr);
+  for (int row = 0; row < NUMBER_OF_ROWS; row++)
+  {
+    fprintf(stderr, "|%.16s|\n", &simulator.page(simulator.visiblePage())[row << 4]);
+  }
+  close(fd);
+  return 0;
+}
@@ -0,0 +1,96 @@
+/*
+  screen_decode.cpp - Draws the example screen assets on the simulated display on a Linux host.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License, see LICENSE.
+
+  Build and run from the library root:
+
+    g++ -std=c++11 -O2 -I extras/host -I . extras/host/Arduino.cpp extras/host/MS6205_sim.cpp \
+        MS6205*.cpp extras/host/screen_decode.cpp -o screen_decode && ./screen_decode
+
+  Decodes examples/MS6205_screen_example/screens.h with drawScreen(), compares the simulated
+  display with the source text files and counts the characters written.
+*/
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_screen.h"
+#include "MS6205_sim.h"
+#include "../../examples/MS6205_screen_example/screens.h"
+
+#include <stdio.h>
+
+#define EXAMPLE_PATH    "examples/MS6205_screen_example/"
+
+// Reads the screen below the "---" line of a source file, like make_screen.py does
+static bool readSource(const char *name, char block, char *content)
+{
+  char path[128];
+  char line[256];
+  snprintf(path, sizeof(path), EXAMPLE_PATH "%s", name);
+  FILE *file = fopen(path, "r");
+  if (file == NULL)
+  {
+    printf("Can't open %s, run from the library root\n", path);
+    return false;
+  }
+
+  memset(content, ' ', NUMBER_OF_CHARACTERS);
+  bool screen = false;
+  int row = 0;
+  while ((fgets(line, sizeof(line), file) != NULL) && (row < NUMBER_OF_ROWS))
+  {
+    if (!screen)
+    {
+      screen = (strncmp(line, "---", 3) == 0);
+      continue;
+    }
+    for (int column = 0; (column < NUMBER_OF_COLUMNS) && (line[column] != '\n') && (line[column] != '\0'); column++)
+    {
+      char character = (line[column] == block) ? 127 : toUpperCase(line[column]);
+      content[column | (row << 4)] = character;
+    }
+    row++;
+  }
+  fclose(file);
+  return true;
+}
+
+static bool check(MS6205Simulator &simulator, MS6205 &display, const uint8_t *screen, const char *name, char block)
+{
+  char expected[NUMBER_OF_CHARACTERS];
+  if (!readSource(name, block, expected))
+  {
+    return false;
+  }
+
+  simulator.resetCounters();
+  display.drawScreen(0, screen);
+  unsigned long written = simulator.counters().characterStrobes;
+  if (memcmp(simulator.page(0), expected, NUMBER_OF_CHARACTERS) != 0)
+  {
+    printf("%s: decoded screen differs\n", name);
+    simulator.printPage(0);
+    return false;
+  }
+
+  simulator.resetCounters();
+  display.drawScreen(0, screen);                        // Page holds it already
+  printf("%-9s %3lu characters written, %lu when drawn again\n", name, written, simulator.counters().characterStrobes);
+  return true;
+}
+
+int main(void)
+{
+  MS6205Simulator simulator;
+  simulator.attach(15, 14, 13, 12, 2, 5);
+  MS6205 display(15, 14, 13, 12, 2, 5);
+  display.begin();
+
+  bool passed = check(simulator, display, logo, "logo.txt", '#')
+             && check(simulator, display, menu, "menu.txt", 0)
+             && check(simulator, display, logo, "logo.txt", '#');
+  return passed ? 0 : 1;
+}
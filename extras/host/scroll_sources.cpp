@@ -0,0 +1,167 @@
+/*
+  scroll_sources.cpp - Checks scrolling from streamed text sources on the simulated display on a Linux host.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License, see LICENSE.
+
+  Build and run from the library root:
+
+    g++ -std=c++11 -O2 -I extras/host -I . extras/host/Arduino.cpp extras/host/MS6205_sim.cpp \
+        MS6205*.cpp extras/host/scroll_sources.cpp -o scroll_sources && ./scroll_sources
+
+  The character entering the area at the right is recorded on every update(): for a String and a
+  flash text it has to be the text, followed by spaces until the text has left the area, then the
+  text again. A circular buffer and a Stream are fed while scrolling, and have to show what was fed,
+  in order. The bus time per update() is compared between a short text and a 100000 character text.
+*/
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_scroll.h"
+#include "MS6205_sim.h"
+
+#include <stdio.h>
+#include <string>
+
+#define PIN_COST_NS              1000   // [ns] Simulated duration of one digitalWrite()
+#define AREA_LENGTH                16   // [characters] Row 2 of the display
+#define LONG_TEXT_LENGTH       100000   // [characters] More than the RAM of most Arduinos
+
+static int failures = 0;
+
+// Stream fed by the program, like Serial
+class feedStream : public Stream
+{
+  public:
+    std::string data;
+    size_t position = 0;
+
+    int available(void) { return data.size() - position; }
+    int read(void) { return (position < data.size()) ? (unsigned char)data[position++] : -1; }
+    int peek(void) { return (position < data.size()) ? (unsigned char)data[position] : -1; }
+    size_t write(uint8_t) { return 0; }
+};
+
+// Updates once and returns the character that entered at the right
+static char tick(scrollText &scroll, MS6205Simulator &simulator, unsigned long long *maxNs = NULL)
+{
+  delay(1);
+  unsigned long long start = hostNanos();
+  scroll.update();
+  if ((maxNs != NULL) && (hostNanos() - start > *maxNs))
+  {
+    *maxNs = hostNanos() - start;
+  }
+  return simulator.page(0)[(2 << 4) + AREA_LENGTH - 1];
+}
+
+static void result(const char *name, bool ok)
+{
+  printf("%-40s %s\n", name, ok ? "ok" : "FAILED");
+  failures += ok ? 0 : 1;
+}
+
+int main(void)
+{
+  MS6205Simulator simulator;
+  simulator.attach(15, 14, 13, 12, 2, 5);
+  MS6205 display(15, 14, 13, 12, 2, 5);
+  display.begin();
+
+  // --- String and flash text: text, spaces until it has left, text again ---
+  const char *text = "Elektronika MS6205 news ticker";
+  std::string expected = std::string("ELEKTRONIKA MS6205 NEWS TICKER") + std::string(AREA_LENGTH, ' ');
+  expected += expected;
+
+  std::string fromString;
+  scrollText stringScroll(0, 2, 15, 2, 0, String(text), &display);
+  for (size_t i = 0; i < expected.size(); i++)
+  {
+    fromString += tick(stringScroll, simulator);
+  }
+  result("String: text, gap, text again", fromString == expected);
+
+  std::string fromFlash;
+  flashSource flash(PSTR("Elektronika MS6205 news ticker"));
+  scrollText flashScroll(0, 2, 15, 2, 0, &flash, &display);
+  for (size_t i = 0; i < expected.size(); i++)
+  {
+    fromFlash += tick(flashScroll, simulator);
+  }
+  result("flashSource: same as String", fromFlash == expected);
+
+  // --- Bus time per update() does not depend on the text length ---
+  hostSetPinCostNs(PIN_COST_NS);
+  static char longText[LONG_TEXT_LENGTH + 1];
+  for (int i = 0; i < LONG_TEXT_LENGTH; i++)
+  {
+    longText[i] = (char)('A' + i % 26);
+  }
+  unsigned long long shortNs = 0;
+  unsigned long long longNs = 0;
+  flashSource shortSource(PSTR("ABCDEFGHIJKLMNOPQRSTUVWXYZABCDEFGHIJKLMNOPQRSTUVWXYZ"));
+  flashSource longSource(longText);
+  flashScroll.setSource(&shortSource);
+  for (int i = 0; i < 200; i++)
+  {
+    tick(flashScroll, simulator, &shortNs);
+  }
+  flashScroll.setSource(&longSource);
+  for (int i = 0; i < 200; i++)
+  {
+    tick(flashScroll, simulator, &longNs);
+  }
+  hostSetPinCostNs(0);
+  printf("max per update(): %.0f us for 52 characters, %.0f us for %d characters, %d bytes held for the area\n",
+         shortNs / 1000.0, longNs / 1000.0, LONG_TEXT_LENGTH, AREA_LENGTH);
+  result("flashSource: constant cost per update()", longNs <= shortNs);
+
+  // --- Circular buffer, printed to while scrolling ---
+  char buffer[32];
+  ringSource ring(buffer, sizeof(buffer));
+  flashScroll.setSource(&ring);
+  std::string fed;
+  std::string shown;
+  const char *lines[] = {"12:00 START ", "12:01 TEMP 21.5C ", "12:02 DOOR OPEN ", "12:03 DOOR CLOSED "};
+  for (int line = 0; line < 4; line++)
+  {
+    ring.print(lines[line]);
+    fed += lines[line];
+    for (int i = 0; i < 10; i++)                                // Slower than it is fed, the buffer fills up
+    {
+      shown += tick(flashScroll, simulator);
+    }
+  }
+  while (ring.available() > 0)
+  {
+    shown += tick(flashScroll, simulator);
+  }
+  for (int i = 0; i < AREA_LENGTH; i++)
+  {
+    shown += tick(flashScroll, simulator);
+  }
+  bool dropped = (ring.print("THIS IS LONGER THAN THE 32 CHARACTER BUFFER") == sizeof(buffer));
+  std::string trimmed = shown.substr(0, shown.find_last_not_of(' ') + 1);
+  result("ringSource: shows what was printed", trimmed + " " == fed);
+  result("ringSource: drops what does not fit", dropped);
+
+  // --- Stream, data arrives in bursts ---
+  feedStream stream;
+  streamSource streamed(&stream);
+  flashScroll.setSource(&streamed);
+  shown.clear();
+  stream.data = "FIRST BURST";
+  for (int i = 0; i < 20; i++)
+  {
+    shown += tick(flashScroll, simulator);
+  }
+  stream.data += "SECOND";
+  for (int i = 0; i < 10; i++)
+  {
+    shown += tick(flashScroll, simulator);
+  }
+  result("streamSource: bursts in order, gap between", shown == "FIRST BURST         SECOND    ");
+
+  return (failures == 0) ? 0 : 1;
+}
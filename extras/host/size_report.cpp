@@ -0,0 +1,55 @@
+/*
+  size_report.cpp - Prints the RAM taken by the library's objects in one configuration on a Linux host.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License, see LICENSE.
+
+  Build and run from the library root, for all configurations at once:
+
+    sh extras/host/size_report.sh
+
+  or for one configuration, given by the MS6205_PAGING, MS6205_PARALLEL and MS6205_SCROLL_STRING macros:
+
+    g++ -std=c++11 -O2 -I extras/host -I . -DMS6205_PAGING=0 extras/host/Arduino.cpp \
+        MS6205*.cpp extras/host/size_report.cpp -o size_report && ./size_report "paging off"
+
+  Sizes are those of the host (64 bit pointers, 32 bit int). 32-bit targets need about the same for
+  MS6205, whose size is dominated by the page model, and less for the pointer-heavy helper classes.
+  A scroll region takes its scrollText plus the area's characters, allocated once, plus the heap's
+  overhead per block (estimated as 2 pointers).
+*/
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_animation.h"
+#include "MS6205_blink.h"
+#include "MS6205_layout.h"
+#include "MS6205_scroll.h"
+#include "MS6205_scrub.h"
+#include "MS6205_template.h"
+#include "MS6205_transition.h"
+#include "MS6205_virtual.h"
+#include "MS6205_window.h"
+
+#include <stdio.h>
+
+#define SCROLL_AREA                16   // [characters] One row
+#define SCROLL_RAM               1024   // [bytes] RAM to fill with scroll regions
+
+int main(int argc, char *argv[])
+{
+  const char *name = (argc > 1) ? argv[1] : "default";
+  if ((argc > 2) && (strcmp(argv[2], "header") == 0))
+  {
+    printf("%-24s %7s %7s %7s %9s %7s %7s %7s %7s %7s %7s\n", "configuration", "MS6205", "MS6205T",
+           "scroll", "per 1 KB", "transit", "window", "layout", "virtual", "blink", "scrub");
+  }
+
+  int region = sizeof(scrollText) + SCROLL_AREA + 2 * sizeof(void *);
+  printf("%-24s %7u %7u %7u %9d %7u %7u %7u %7u %7u %7u\n", name,
+         (unsigned)sizeof(MS6205), (unsigned)sizeof(MS6205T<15, 14, 13, 12, 2, 5>), (unsigned)region, SCROLL_RAM / region,
+         (unsigned)sizeof(screenTransition), (unsigned)sizeof(windowStack), (unsigned)sizeof(textLayout),
+         (unsigned)sizeof(screenManager), (unsigned)sizeof(blinkEngine), (unsigned)sizeof(cellScrubber));
+  return 0;
+}
@@ -0,0 +1,42 @@
+#!/bin/sh
+#
+#  size_report.sh - Prints the RAM taken by the library's objects in every configuration on a Linux host.
+#
+#  Copyright 2018 Christian Holzapfel
+#
+#  Released under the MIT License, see LICENSE.
+#
+#  Run from the library root:
+#
+#    sh extras/host/size_report.sh
+#
+#  Columns are bytes per object; "scroll" is one 16-character scroll region including its area,
+#  "per 1 KB" the number of such regions that fit into 1 KB. See size_report.cpp.
+#  Stops at the first configuration that does not build warning-clean.
+
+set -e
+
+# Every configuration has to build without warnings. Doc comments continue lines with a trailing
+# backslash, and writeCharacter() keeps its historical no-op range check, so those two are left out.
+WARNINGS="-Wall -Wextra -Wno-comment -Wno-unused-value -Werror"
+OUTPUT=${TMPDIR:-/tmp}/ms6205_size_report
+HEADER=header
+
+report()
+{
+  NAME=$1
+  shift
+  g++ -std=c++11 -O2 $WARNINGS -I extras/host -I . "$@" extras/host/Arduino.cpp MS6205*.cpp extras/host/size_report.cpp -o "$OUTPUT"
+  "$OUTPUT" "$NAME" $HEADER
+  HEADER=
+}
+
+report "default"
+report "MS6205_PAGING=0"            -DMS6205_PAGING=0
+report "MS6205_PARALLEL=0"          -DMS6205_PARALLEL=0
+report "MS6205_SCROLL_STRING=0"     -DMS6205_SCROLL_STRING=0
+report "MS6205_QUEUE=0"             -DMS6205_QUEUE=0
+report "MS6205_URGENT=0"            -DMS6205_URGENT=0
+report "all five 0"                 -DMS6205_PAGING=0 -DMS6205_PARALLEL=0 -DMS6205_SCROLL_STRING=0 -DMS6205_QUEUE=0 \
+                                    -DMS6205_URGENT=0
+rm -f "$OUTPUT"
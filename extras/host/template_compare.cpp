@@ -0,0 +1,143 @@
+/*
+  template_compare.cpp - Compares MS6205T with the runtime class MS6205 on a Linux host.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License, see LICENSE.
+
+  Build and run from the library root:
+
+    g++ -std=c++11 -O2 -I extras/host -I . extras/host/Arduino.cpp extras/host/MS6205_sim.cpp \
+        MS6205*.cpp extras/host/template_compare.cpp -o template_compare && ./template_compare
+
+  Both classes run the same writes against the simulated display, which records the byte on the
+  bus at every strobe: sequence and page content have to be identical. Then RAM per object is
+  compared, and the CPU cycles of a positioned character write on an ATmega328P are estimated from
+  the counted pin operations. Host builds write pins through digitalWrite() in both classes, so
+  host CPU time says nothing about the target; the cycle figures per pin operation below are
+  typical values for the AVR core, not measurements.
+*/
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_template.h"
+#include "MS6205_sim.h"
+
+#include <stdio.h>
+
+#define MAX_STROBES              1024
+
+#define AVR_CLOCK_MHZ              16   // [MHz] ATmega328P on an Uno
+#define AVR_DIGITAL_WRITE_CYCLES   56   // [cycles] digitalWrite(), pin to port lookup through flash tables
+#define AVR_FAST_PIN_CYCLES         2   // [cycles] sbi or cbi on a constant port and bit
+
+#define LATCH_PIN                  15
+#define CLOCK_PIN                  14
+#define DATA_PIN                   13
+#define SET_ADDRESS_PIN            12
+#define SET_CHARACTER_PIN           2
+#define CLEAR_PIN                   5
+#define PAGE_0_PIN                  4
+#define PAGE_1_PIN                  0
+#define CURSOR_PIN                 16
+
+typedef MS6205T<LATCH_PIN, CLOCK_PIN, DATA_PIN, SET_ADDRESS_PIN, SET_CHARACTER_PIN, CLEAR_PIN> plainDisplay;
+typedef MS6205T<LATCH_PIN, CLOCK_PIN, DATA_PIN, SET_ADDRESS_PIN, SET_CHARACTER_PIN, CLEAR_PIN,
+                MS6205T_PAGING | MS6205T_CURSOR, PAGE_0_PIN, PAGE_1_PIN, CURSOR_PIN> fullDisplay;
+
+struct strobe
+{
+  uint8_t pin;
+  uint8_t bus;
+};
+
+static strobe strobes[2][MAX_STROBES];
+static int strobeCount[2] = {0, 0};
+static int recording = 0;
+
+static void onStrobe(uint8_t pin, uint8_t bus)
+{
+  if (strobeCount[recording] < MAX_STROBES)
+  {
+    strobes[recording][strobeCount[recording]].pin = pin;
+    strobes[recording][strobeCount[recording]].bus = bus;
+  }
+  strobeCount[recording]++;
+}
+
+template <class display>
+static void script(display &target)
+{
+  target.begin();
+  target.showPage(2);
+  target.setCursor(0, 0);
+  target.write("COMPILE TIME");
+  target.writeCharacter(15, 9, 'Z');
+  target.writeCharacter(20, -3, 'C');                          // Out of range, limited like MS6205
+  target.writeBlock(7, 4);
+  target.addCursor(150);
+  target.write("WRAP");
+}
+
+int main(void)
+{
+  char pages[2][SIM_CELLS];
+  int failures = 0;
+
+  // --- Same bus sequence and content ---
+  for (recording = 0; recording < 2; recording++)
+  {
+    MS6205Simulator simulator;
+    simulator.attach(LATCH_PIN, CLOCK_PIN, DATA_PIN, SET_ADDRESS_PIN, SET_CHARACTER_PIN, CLEAR_PIN);
+    simulator.attachPaging(PAGE_0_PIN, PAGE_1_PIN);
+    simulator.setStrobeHook(onStrobe);
+
+    if (recording == 0)
+    {
+      MS6205 display(LATCH_PIN, CLOCK_PIN, DATA_PIN, SET_ADDRESS_PIN, SET_CHARACTER_PIN, CLEAR_PIN);
+      display.beginPaging(PAGE_0_PIN, PAGE_1_PIN);
+      script(display);
+    }
+    else
+    {
+      fullDisplay display;
+      script(display);
+    }
+    memcpy(pages[recording], simulator.page(2), SIM_CELLS);
+  }
+
+  bool sameSequence = (strobeCount[0] == strobeCount[1]) &&
+                      (memcmp(strobes[0], strobes[1], sizeof(strobe) * strobeCount[0]) == 0);
+  bool samePage = (memcmp(pages[0], pages[1], SIM_CELLS) == 0);
+  printf("Bus sequence: %d / %d strobes, %s; page content %s\n", strobeCount[0], strobeCount[1],
+         sameSequence ? "identical" : "DIFFERENT", samePage ? "identical" : "DIFFERENT");
+  if (!sameSequence || !samePage)
+  {
+    failures++;
+  }
+
+  // --- RAM per object ---
+  printf("\nRAM per object:\n");
+  printf("  MS6205                          %5u bytes\n", (unsigned)sizeof(MS6205));
+  printf("  MS6205T, no features            %5u bytes\n", (unsigned)sizeof(plainDisplay));
+  printf("  MS6205T, paging and cursor      %5u bytes\n", (unsigned)sizeof(fullDisplay));
+
+  // --- Estimated cycles of one positioned write on an ATmega328P ---
+  MS6205Simulator simulator;
+  simulator.attach(LATCH_PIN, CLOCK_PIN, DATA_PIN, SET_ADDRESS_PIN, SET_CHARACTER_PIN, CLEAR_PIN);
+  MS6205 runtime(LATCH_PIN, CLOCK_PIN, DATA_PIN, SET_ADDRESS_PIN, SET_CHARACTER_PIN, CLEAR_PIN);
+  runtime.begin();
+  unsigned long writesBefore = hostPinWrites();
+  unsigned long long start = hostNanos();
+  runtime.writeCharacter(3, 4, 'A');
+  unsigned long pinWrites = hostPinWrites() - writesBefore;
+  unsigned long holdCycles = (unsigned long)((hostNanos() - start) / 1000ULL) * AVR_CLOCK_MHZ;
+
+  printf("\nOne writeCharacter(column, row, character), ATmega328P at %d MHz (estimate):\n", AVR_CLOCK_MHZ);
+  printf("  Pin operations, both            %7lu\n", pinWrites);
+  printf("  Control line hold times         %7lu cycles\n", holdCycles);
+  printf("  MS6205,  digitalWrite()         %7lu cycles\n", pinWrites * AVR_DIGITAL_WRITE_CYCLES + holdCycles);
+  printf("  MS6205T, sbi/cbi                %7lu cycles\n", pinWrites * AVR_FAST_PIN_CYCLES + holdCycles);
+
+  return (failures == 0) ? 0 : 1;
+}
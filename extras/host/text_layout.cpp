@@ -0,0 +1,180 @@
+/*
+  text_layout.cpp - Checks word wrap, alignment and the layout cache of textLayout on a Linux host.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License, see LICENSE.
+
+  Build and run from the library root:
+
+    g++ -std=c++11 -O2 -I extras/host -I . extras/host/Arduino.cpp extras/host/MS6205_sim.cpp \
+        MS6205*.cpp extras/host/text_layout.cpp -o text_layout && ./text_layout
+
+  Checks the line breaks and rendered boxes of every mode and alignment against hand-made
+  expectations. Then a long text is edited at random many times: after every edit the cached layout
+  has to equal a fresh layout, and only the lines from the one before the edit on may be laid out
+  again. Rendering an unchanged text again must not write a single cell.
+*/
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_layout.h"
+#include "MS6205_sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+#define EDITS                    1000
+
+static int failures = 0;
+
+static void result(const char *name, bool ok)
+{
+  printf("%-44s %s\n", name, ok ? "ok" : "FAILED");
+  failures += ok ? 0 : 1;
+}
+
+// Lines of a layout, separated by '|'
+static std::string lines(textLayout &layout)
+{
+  std::string all;
+  for (int i = 0; i < layout.lines(); i++)
+  {
+    int length = 0;
+    const char *line = layout.line(i, &length);
+    all += (i > 0) ? "|" : "";
+    all += std::string(line, length);
+  }
+  return all;
+}
+
+// Rows of a box on the display, separated by '|'
+static std::string box(MS6205Simulator &simulator, int column, int row, int width, int height)
+{
+  std::string all;
+  for (int y = row; y < row + height; y++)
+  {
+    all += (y > row) ? "|" : "";
+    all += std::string(&simulator.page(0)[column | (y << 4)], width);
+  }
+  return all;
+}
+
+int main(void)
+{
+  MS6205Simulator simulator;
+  simulator.attach(15, 14, 13, 12, 2, 5);
+  MS6205 display(15, 14, 13, 12, 2, 5);
+  display.begin();
+
+  textLayout layout(&display);
+  const char *fox = "The quick brown fox jumps over the lazy dog";
+
+  // --- Word wrap and pages ---
+  layout.setBox(2, 1, 10, 3);
+  layout.setText(fox);
+  result("word wrap", lines(layout) == "The quick|brown fox|jumps over|the lazy|dog");
+  result("pages", layout.pages() == 2);
+  layout.render(1);
+  result("render(1), left aligned", box(simulator, 2, 1, 10, 3) == "THE LAZY  |DOG       |          ");
+
+  layout.setBox(2, 1, 10, 3, ALIGN_RIGHT);
+  layout.render(0);
+  result("render(0), right aligned", box(simulator, 2, 1, 10, 3) == " THE QUICK| BROWN FOX|JUMPS OVER");
+
+  layout.setBox(2, 1, 10, 3, ALIGN_CENTER);
+  layout.render(0);
+  result("render(0), centered", box(simulator, 2, 1, 10, 3) == "THE QUICK |BROWN FOX |JUMPS OVER");
+
+  layout.setBox(0, 5, 6, 2);
+  layout.setText("Elektronika MS6205\n\n  indented");
+  result("long word broken, empty line, indent kept", lines(layout) == "Elektr|onika|MS6205||  inde|nted");
+
+  // --- Ellipsis ---
+  layout.setBox(2, 1, 10, 2, ALIGN_LEFT, LAYOUT_ELLIPSIS);
+  layout.setText(fox);
+  layout.render();
+  result("LAYOUT_ELLIPSIS", box(simulator, 2, 1, 10, 2) == "THE QUICK |BROWN...  ");
+
+  layout.setBox(2, 1, 10, 3, ALIGN_RIGHT, LAYOUT_LINES);
+  layout.setText("Temperature 21.5\nok\nHumidity  45%");
+  layout.render();
+  result("LAYOUT_LINES, right aligned", box(simulator, 2, 1, 10, 3) == "TEMPERA...|        OK|HUMIDIT...");
+
+  // --- Cache: hits, partial layout, equal to a fresh layout ---
+  char text[600];
+  for (int i = 0; i < (int)sizeof(text) - 1; i++)
+  {
+    text[i] = ((i % 7) == 6) ? ' ' : (char)('a' + i % 26);      // Words of 6 letters
+  }
+  text[sizeof(text) - 1] = '\0';
+  text[50] = '\n';
+
+  textLayout cached(&display);
+  textLayout fresh(NULL);
+  cached.setBox(0, 0, 16, 10);
+  fresh.setBox(0, 0, 16, 10);
+  cached.setText(text);
+  simulator.resetCounters();
+  cached.render(0);
+  unsigned long firstRender = simulator.counters().characterStrobes;
+  simulator.resetCounters();
+  cached.resetCounters();
+  int laidOut = cached.setText(text);
+  cached.render(0);
+  printf("unchanged text: %d lines laid out, %lu cells written (first render %lu)\n", laidOut,
+         simulator.counters().characterStrobes, firstRender);
+  result("unchanged text is a cache hit", (laidOut == 0) && (cached.counters().hits == 1) &&
+                                          (simulator.counters().characterStrobes == 0));
+
+  srand(6205);
+  bool equal = true;
+  bool partial = true;
+  unsigned long cachedLines = 0;
+  unsigned long freshLines = 0;
+  for (int edit = 0; edit < EDITS; edit++)
+  {
+    // Replace, insert or delete a character
+    int length = strlen(text);
+    int at = rand() % length;
+    int kind = rand() % 3;
+    const char characters[] = "abc  \n";
+    if ((kind == 1) && (length < (int)sizeof(text) - 1))
+    {
+      memmove(&text[at + 1], &text[at], length - at + 1);
+    }
+    else if ((kind == 2) && (length > 100))
+    {
+      memmove(&text[at], &text[at + 1], length - at);
+      at = (at < length - 1) ? at : length - 2;
+    }
+    if (kind != 2)
+    {
+      text[at] = characters[rand() % (sizeof(characters) - 1)];
+    }
+
+    // Line of the edit in the old layout
+    int editLine = 0;
+    for (int i = 0; i < cached.lines(); i++)
+    {
+      editLine = ((cached.line(i, NULL) - text) <= at) ? i : editLine;
+    }
+    int before = cached.lines();
+
+    laidOut = cached.setText(text);
+    fresh.setText(NULL);
+    fresh.setText(text);
+    cachedLines += laidOut;
+    freshLines += fresh.lines();
+
+    equal &= (lines(cached) == lines(fresh)) && (cached.lines() == fresh.lines());
+    int bound = ((cached.lines() > before) ? cached.lines() : before) - ((editLine > 0) ? editLine - 1 : 0);
+    partial &= (laidOut <= bound);
+  }
+  printf("%d edits: %lu lines laid out against %lu for fresh layouts\n", EDITS, cachedLines, freshLines);
+  result("edited text equals a fresh layout", equal);
+  result("laid out from the line before the edit on", partial);
+
+  return (failures == 0) ? 0 : 1;
+}
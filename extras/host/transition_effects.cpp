@@ -0,0 +1,101 @@
+/*
+  transition_effects.cpp - Checks the screen transition effects on the simulated display on a Linux host.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License, see LICENSE.
+
+  Build and run from the library root:
+
+    g++ -std=c++11 -O2 -I extras/host -I . extras/host/Arduino.cpp extras/host/MS6205_sim.cpp \
+        MS6205*.cpp extras/host/transition_effects.cpp -o transition_effects && ./transition_effects
+
+  Every effect changes one screen into another while update() is called every few milliseconds.
+  The cells written per update() have to stay close to the even share of the transition's cells for
+  the time since the last update(), the transition has to take its duration, and the new screen has
+  to be shown completely at the end.
+  The old and new screen share some cells, which must not be written at all by wipe and dissolve.
+*/
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_sim.h"
+#include "MS6205_transition.h"
+
+#include <stdio.h>
+
+#define DURATION_MS               400
+#define UPDATE_EVERY_MS            10
+
+static char const * const effectNames[] = {"wipe", "dissolve", "slide"};
+
+int main(void)
+{
+  MS6205Simulator simulator;
+  simulator.attach(15, 14, 13, 12, 2, 5);
+  MS6205 display(15, 14, 13, 12, 2, 5);
+  display.begin();
+
+  char oldScreen[NUMBER_OF_CHARACTERS + 1];
+  char newScreen[NUMBER_OF_CHARACTERS + 1];
+  int differing = 0;
+  for (int i = 0; i < NUMBER_OF_CHARACTERS; i++)
+  {
+    oldScreen[i] = (char)('A' + (i * 3) % 26);
+    newScreen[i] = ((i % 5) == 0) ? oldScreen[i] : (char)('0' + (i * 7) % 10);   // Every 5th cell stays
+    differing += (oldScreen[i] != newScreen[i]) ? 1 : 0;
+  }
+  oldScreen[NUMBER_OF_CHARACTERS] = newScreen[NUMBER_OF_CHARACTERS] = '\0';
+
+  int failures = 0;
+  screenTransition transition(&display);
+
+  printf("%d of %d cells differ, %d ms, update() every %d ms\n", differing, NUMBER_OF_CHARACTERS, DURATION_MS, UPDATE_EVERY_MS);
+  printf("%-10s %8s %8s %10s %10s %10s %10s\n", "effect", "cells", "written", "updates", "max/update", "even share", "result");
+  for (int effect = TRANSITION_WIPE; effect <= TRANSITION_SLIDE; effect++)
+  {
+    display.renderPage(0, oldScreen);
+    simulator.resetCounters();
+
+    unsigned long start = millis();
+    transition.start(newScreen, effect, DURATION_MS);
+    int updates = 0;
+    int maxCells = 0;
+    bool even = true;
+    unsigned long previous = start;
+    while (transition.running())
+    {
+      delay(UPDATE_EVERY_MS);
+      unsigned long before = simulator.counters().characterStrobes;
+      unsigned long now = millis();
+      transition.update();
+      int cells = simulator.counters().characterStrobes - before;
+      maxCells = (cells > maxCells) ? cells : maxCells;
+      updates++;
+
+      // Share of the time since the last update, which includes the bus time of the last one
+      even &= (cells <= (double)transition.cells() * (now - previous) / DURATION_MS + 2);
+      previous = now;
+    }
+    unsigned long took = millis() - start;
+
+    double share = (double)transition.cells() * UPDATE_EVERY_MS / DURATION_MS;
+    bool shown = (memcmp(simulator.page(0), newScreen, NUMBER_OF_CHARACTERS) == 0);
+    bool minimal = (effect == TRANSITION_SLIDE) || ((int)simulator.counters().characterStrobes == differing);
+    bool onTime = (took >= DURATION_MS) && (took <= DURATION_MS + UPDATE_EVERY_MS);
+    printf("%-10s %8d %8lu %10d %10d %10.1f %10s\n", effectNames[effect], transition.cells(),
+           simulator.counters().characterStrobes, updates, maxCells, share,
+           (shown && even && minimal && onTime) ? "ok" : "FAILED");
+    failures += (shown && even && minimal && onTime) ? 0 : 1;
+  }
+
+  // --- finish() shows the new screen at once ---
+  display.renderPage(0, oldScreen);
+  transition.start(newScreen, TRANSITION_DISSOLVE, DURATION_MS);
+  transition.finish();
+  bool finished = !transition.running() && (memcmp(simulator.page(0), newScreen, NUMBER_OF_CHARACTERS) == 0);
+  printf("finish(): %s\n", finished ? "ok" : "FAILED");
+  failures += finished ? 0 : 1;
+
+  return (failures == 0) ? 0 : 1;
+}
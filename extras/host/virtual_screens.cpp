@@ -0,0 +1,167 @@
+/*
+  virtual_screens.cpp - Compares screenManager with repainting a single page on the simulated display on a Linux host.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License, see LICENSE.
+
+  Build and run from the library root:
+
+    g++ -std=c++11 -O2 -I extras/host -I . extras/host/Arduino.cpp extras/host/MS6205_sim.cpp \
+        MS6205*.cpp extras/host/virtual_screens.cpp -o virtual_screens && ./virtual_screens
+
+  Twelve screens share a frame and differ in their title and values. A user switches between them,
+  mostly among a few recent ones, while a pinned home screen is shown every now and then and the
+  values change. Every switch has to show the screen's content, a resident screen must be shown
+  without writing a cell, and the pinned screen must never lose its page. Cells written and bus time
+  are compared with rendering every screen into page 0.
+*/
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_sim.h"
+#include "MS6205_virtual.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PIN_COST_NS              1000   // [ns] Simulated duration of one digitalWrite()
+#define SCREENS                    12
+#define SWITCHES                 2000
+
+static char screens[SCREENS][NUMBER_OF_CHARACTERS + 1];
+
+// Frame, title and values of a screen
+static void drawScreen(int screen, int value)
+{
+  char *content = screens[screen];
+  for (int i = 0; i < NUMBER_OF_CHARACTERS; i++)
+  {
+    int column = i & 0x0F;
+    int row = i >> 4;
+    content[i] = ((row == 1) || (row == 9)) ? '-' : (column == 0) ? '|' : ' ';
+  }
+  memcpy(&content[0], "SCREEN", 6);
+  content[7] = (char)('A' + screen);
+  for (int row = 2; row < 2 + screen % 6; row++)                // Screen specific labels
+  {
+    memcpy(&content[(row << 4) + 2], "VALUE", 5);
+  }
+  content[(4 << 4) + 10] = (char)('0' + value % 10);
+  content[(4 << 4) + 11] = (char)('0' + (value / 10) % 10);
+  content[NUMBER_OF_CHARACTERS] = '\0';
+}
+
+// Next screen: mostly a recent one, the home screen now and then, sometimes any
+static int nextScreen(int *recent)
+{
+  int dice = rand() % 10;
+  int screen = (dice < 6) ? recent[rand() % 3] : (dice < 8) ? 0 : 1 + rand() % (SCREENS - 1);
+  if ((screen != 0) && (screen != recent[0]))
+  {
+    recent[2] = recent[1];
+    recent[1] = recent[0];
+    recent[0] = screen;
+  }
+  return screen;
+}
+
+int main(void)
+{
+  MS6205Simulator simulator;
+  simulator.attach(15, 14, 13, 12, 2, 5);
+  simulator.attachPaging(4, 0);
+  MS6205 display(15, 14, 13, 12, 2, 5);
+  display.beginPaging(4, 0);
+  display.begin();
+  hostSetPinCostNs(PIN_COST_NS);
+
+  int failures = 0;
+  unsigned long strobes[2] = {0, 0};
+  unsigned long long nanos[2] = {0, 0};
+
+  for (int run = 0; run < 2; run++)                             // 0: screenManager, 1: single page
+  {
+    srand(6205);
+    for (int screen = 0; screen < SCREENS; screen++)
+    {
+      drawScreen(screen, 0);
+    }
+    display.invalidatePages();
+
+    screenManager manager(&display);
+    for (int screen = 0; screen < SCREENS; screen++)
+    {
+      manager.addScreen(screens[screen]);
+    }
+    if (run == 0)
+    {
+      manager.pin(0);
+    }
+
+    int recent[3] = {1, 2, 3};
+    bool dirty[SCREENS] = {false};                              // Changed while not visible
+    bool shown = true;
+    bool freeHits = true;
+    bool pinned = true;
+    simulator.resetCounters();
+    unsigned long long start = hostNanos();
+    for (int i = 0; i < SWITCHES; i++)
+    {
+      int screen = nextScreen(recent);
+      if ((i % 10) == 9)                                        // A value changes on some screen
+      {
+        int changing = rand() % SCREENS;
+        drawScreen(changing, i);
+        if (run == 0)
+        {
+          dirty[changing] = (changing != manager.visible());
+          manager.changed(changing);
+        }
+      }
+
+      unsigned long before = simulator.counters().characterStrobes;
+      bool resident = (manager.pageOf(screen) != VIRTUAL_NONE);
+      if (run == 0)
+      {
+        manager.show(screen);
+      }
+      else
+      {
+        display.renderPage(0, screens[screen]);
+      }
+      shown &= (memcmp(simulator.page(simulator.visiblePage()), screens[screen], NUMBER_OF_CHARACTERS) == 0);
+      if ((run == 0) && resident && !dirty[screen])
+      {
+        freeHits &= (simulator.counters().characterStrobes == before);
+      }
+      dirty[screen] = false;
+      pinned &= (run == 1) || (manager.pageOf(0) == 0);
+    }
+    strobes[run] = simulator.counters().characterStrobes;
+    nanos[run] = hostNanos() - start;
+
+    if (run == 0)
+    {
+      const virtualCounters &counters = manager.counters();
+      printf("screenManager: %lu hits, %lu misses, %lu evictions\n", counters.hits, counters.misses, counters.evictions);
+      printf("%-28s %s\n", "every switch shows its screen", shown ? "ok" : "FAILED");
+      printf("%-28s %s\n", "resident screens are free", freeHits ? "ok" : "FAILED");
+      printf("%-28s %s\n", "pinned screen keeps page 0", pinned ? "ok" : "FAILED");
+      failures += (shown && freeHits && pinned) ? 0 : 1;
+    }
+    else
+    {
+      printf("%-28s %s\n", "single page shows screens", shown ? "ok" : "FAILED");
+      failures += shown ? 0 : 1;
+    }
+  }
+  hostSetPinCostNs(0);
+
+  printf("%d switches between %d screens:\n", SWITCHES, SCREENS);
+  printf("  screenManager, 4 pages   %8lu cells %8.1f ms\n", strobes[0], nanos[0] / 1e6);
+  printf("  renderPage() on page 0   %8lu cells %8.1f ms\n", strobes[1], nanos[1] / 1e6);
+  failures += (strobes[0] < strobes[1]) ? 0 : 1;
+
+  return (failures == 0) ? 0 : 1;
+}
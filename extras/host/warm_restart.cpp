@@ -0,0 +1,115 @@
+/*
+  warm_restart.cpp - Compares begin() modes and the warm restart on the simulated display on a Linux host.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License, see LICENSE.
+
+  Build and run from the library root:
+
+    g++ -std=c++11 -O2 -I extras/host -I . extras/host/Arduino.cpp extras/host/MS6205_sim.cpp \
+        MS6205*.cpp extras/host/warm_restart.cpp -o warm_restart && ./warm_restart
+
+  Measures the simulated time from begin() to the first complete frame: with a blocking clear,
+  with a deferred clear overlapping other setup work, and after a restart with a saved state, where
+  the display keeps its content and only changed cells are written. A corrupted state has to fall
+  back to a cleared display. The constructor must not touch any pin, and writeAt() must not wait
+  for a deferred clear.
+*/
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_sim.h"
+
+#include <stdio.h>
+
+#define PIN_COST_NS              1000   // [ns] Simulated duration of one digitalWrite()
+#define OTHER_SETUP_MS             15   // [ms] Other work in setup(), e.g. starting WiFi
+
+static char frame[NUMBER_OF_CHARACTERS + 1];
+static int failures = 0;
+
+static void report(const char *name, unsigned long long start, MS6205Simulator &simulator, bool expected)
+{
+  bool shown = (memcmp(simulator.page(0), frame, NUMBER_OF_CHARACTERS) == 0);
+  printf("%-28s %8.2f ms %8lu cells %4lu clears   %s\n", name, (hostNanos() - start) / 1e6,
+         simulator.counters().characterStrobes, simulator.counters().clears, (shown && expected) ? "ok" : "FAILED");
+  failures += (shown && expected) ? 0 : 1;
+}
+
+int main(void)
+{
+  MS6205Simulator simulator;
+  simulator.attach(15, 14, 13, 12, 2, 5);
+  hostSetPinCostNs(PIN_COST_NS);
+
+  for (int i = 0; i < NUMBER_OF_CHARACTERS; i++)
+  {
+    frame[i] = ((i % 3) == 0) ? ' ' : (char)('A' + i % 26);
+  }
+  frame[NUMBER_OF_CHARACTERS] = '\0';
+
+  printf("Time from begin() to the first frame, %lu ns per digitalWrite():\n", (unsigned long)PIN_COST_NS);
+
+  // --- Constructor ---
+  unsigned long pinWrites = hostPinWrites();
+  MS6205 display(15, 14, 13, 12, 2, 5);
+  printf("%-28s %8lu pin writes   %s\n", "constructor", hostPinWrites() - pinWrites,
+         (hostPinWrites() == pinWrites) ? "ok" : "FAILED");
+  failures += (hostPinWrites() == pinWrites) ? 0 : 1;
+
+  // --- Cold start, blocking clear ---
+  simulator.resetCounters();
+  unsigned long long start = hostNanos();
+  display.begin();
+  delay(OTHER_SETUP_MS);
+  display.renderPage(0, frame);
+  report("BEGIN_CLEAR + setup work", start, simulator, true);
+
+  // --- Cold start, clear overlaps setup work ---
+  simulator.glitch(0, 0, '#');                                  // Whatever the display showed at power-up
+  MS6205 deferred(15, 14, 13, 12, 2, 5);
+  simulator.resetCounters();
+  start = hostNanos();
+  deferred.begin(BEGIN_CLEAR_DEFERRED);
+
+  // --- writeAt(), e.g. from an interrupt, must not wait for the clear ---
+  unsigned long long before = hostNanos();
+  bool dropped = !deferred.writeAt(0, 0, '*');
+  bool waited = (hostNanos() - before) >= 1000000ULL;
+  printf("%-28s %8.2f ms   %s\n", "writeAt() while clearing", (hostNanos() - before) / 1e6,
+         (dropped && !waited) ? "ok" : "FAILED");
+  failures += (dropped && !waited) ? 0 : 1;
+
+  delay(OTHER_SETUP_MS);
+  bool stillClearing = deferred.clearing();
+  deferred.renderPage(0, frame);
+  report("BEGIN_CLEAR_DEFERRED + setup", start, simulator, stillClearing && !deferred.clearing());
+
+  // --- Warm restart: save, restart with a new object, only the changed cells are written ---
+  displayState state;
+  deferred.saveState(&state);
+  memcpy(&frame[4 << 4], "WARM RESTART", 12);
+
+  MS6205 restarted(15, 14, 13, 12, 2, 5);
+  simulator.resetCounters();
+  start = hostNanos();
+  bool warm = restarted.beginWarm(&state);
+  delay(OTHER_SETUP_MS);
+  restarted.renderPage(0, frame);
+  report("beginWarm() + setup", start, simulator, warm && (simulator.counters().clears == 0));
+
+  // --- Corrupted state: cleared as usual ---
+  restarted.saveState(&state);
+  state.content[17] ^= 0x01;                                    // One bit flipped while the power was off
+  MS6205 corrupted(15, 14, 13, 12, 2, 5);
+  simulator.resetCounters();
+  start = hostNanos();
+  warm = corrupted.beginWarm(&state);
+  delay(OTHER_SETUP_MS);
+  corrupted.renderPage(0, frame);
+  report("beginWarm(), corrupted state", start, simulator, !warm && (simulator.counters().clears == 1));
+
+  hostSetPinCostNs(0);
+  return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,154 @@
+/*
+  window_stack.cpp - Checks that windowStack writes only the cells a popup changes on the simulated display on a Linux host.
+
+  Copyright 2018 Christian Holzapfel
+
+  Released under the MIT License, see LICENSE.
+
+  Build and run from the library root:
+
+    g++ -std=c++11 -O2 -I extras/host -I . extras/host/Arduino.cpp extras/host/MS6205_sim.cpp \
+        MS6205*.cpp extras/host/window_stack.cpp -o window_stack && ./window_stack
+
+  A dashboard fills the screen, popups are opened, moved, raised and closed over it. After every
+  step the display has to show the composition, and the cells written have to be exactly the cells
+  whose composited character changed. Dismissing a 6 x 3 popup is compared with a full repaint.
+*/
+
+#include "Arduino.h"
+#include "MS6205.h"
+#include "MS6205_sim.h"
+#include "MS6205_window.h"
+
+#include <stdio.h>
+
+#define PIN_COST_NS              1000   // [ns] Simulated duration of one digitalWrite()
+
+static char dashboard[NUMBER_OF_CHARACTERS + 1];
+static char expected[NUMBER_OF_CHARACTERS];
+static int failures = 0;
+
+// Reference composition: background, then windows bottom to top
+static void paint(int column, int row, int width, int height, const char *content)
+{
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      if ((column + x >= 0) && (column + x < NUMBER_OF_COLUMNS) && (row + y >= 0) && (row + y < NUMBER_OF_ROWS))
+      {
+        expected[(column + x) | ((row + y) << 4)] = content[y * width + x];
+      }
+    }
+  }
+}
+
+// Compares the display with the reference and the written cells with the changed ones
+static void check(const char *step, MS6205Simulator &simulator, const char *before)
+{
+  int changed = 0;
+  for (int address = 0; address < NUMBER_OF_CHARACTERS; address++)
+  {
+    changed += (before[address] != expected[address]) ? 1 : 0;
+  }
+  bool shown = (memcmp(simulator.page(0), expected, NUMBER_OF_CHARACTERS) == 0);
+  bool minimal = ((int)simulator.counters().characterStrobes == changed);
+  printf("%-32s %4d changed %4lu written   %s\n", step, changed, simulator.counters().characterStrobes,
+         (shown && minimal) ? "ok" : "FAILED");
+  failures += (shown && minimal) ? 0 : 1;
+  simulator.resetCounters();
+}
+
+int main(void)
+{
+  MS6205Simulator simulator;
+  simulator.attach(15, 14, 13, 12, 2, 5);
+  MS6205 display(15, 14, 13, 12, 2, 5);
+  display.begin();
+
+  for (int i = 0; i < NUMBER_OF_CHARACTERS; i++)
+  {
+    dashboard[i] = (char)('A' + (i * 7) % 26);
+  }
+  dashboard[NUMBER_OF_CHARACTERS] = '\0';
+
+  const char *popup = "+----+|SAVE||!!!!|";                      // 6 x 3, differs from every dashboard cell
+  const char *dialog = "********  OK  ********";                // 8 x 3, spaces after it
+  char before[NUMBER_OF_CHARACTERS];
+  windowStack windows(&display);
+
+  simulator.resetCounters();
+  memcpy(before, simulator.page(0), NUMBER_OF_CHARACTERS);
+  windows.setBackground(dashboard);
+  memcpy(expected, dashboard, NUMBER_OF_CHARACTERS);
+  check("setBackground()", simulator, before);
+
+  // --- Open and close a 6 x 3 popup ---
+  memcpy(before, expected, NUMBER_OF_CHARACTERS);
+  int first = windows.open(3, 2, 6, 3, popup);
+  paint(3, 2, 6, 3, popup);
+  check("open() 6 x 3", simulator, before);
+
+  hostSetPinCostNs(PIN_COST_NS);
+  memcpy(before, expected, NUMBER_OF_CHARACTERS);
+  unsigned long long start = hostNanos();
+  windows.close(first);
+  double closeUs = (hostNanos() - start) / 1000.0;
+  memcpy(expected, dashboard, NUMBER_OF_CHARACTERS);
+  check("close() 6 x 3", simulator, before);
+
+  display.invalidatePages();
+  start = hostNanos();
+  display.renderPage(0, dashboard);
+  double repaintUs = (hostNanos() - start) / 1000.0;
+  printf("dismissing the popup: %.0f us, full repaint: %.0f us (%lu cells)\n", closeUs, repaintUs,
+         simulator.counters().characterStrobes);
+  hostSetPinCostNs(0);
+  simulator.resetCounters();
+
+  // --- Two overlapping windows ---
+  memcpy(before, expected, NUMBER_OF_CHARACTERS);
+  first = windows.open(3, 2, 6, 3, popup);
+  paint(3, 2, 6, 3, popup);
+  check("open() lower one", simulator, before);
+
+  memcpy(before, expected, NUMBER_OF_CHARACTERS);
+  int second = windows.open(6, 3, 8, 3, dialog);
+  paint(6, 3, 8, 3, "********  OK  ********  ");
+  check("open() overlapping one", simulator, before);
+
+  memcpy(before, expected, NUMBER_OF_CHARACTERS);
+  windows.raise(first);
+  paint(3, 2, 6, 3, popup);
+  check("raise() lower one", simulator, before);
+
+  memcpy(before, expected, NUMBER_OF_CHARACTERS);
+  windows.move(first, 4, 2);
+  memcpy(expected, dashboard, NUMBER_OF_CHARACTERS);
+  paint(6, 3, 8, 3, "********  OK  ********  ");
+  paint(4, 2, 6, 3, popup);
+  check("move() one column", simulator, before);
+
+  memcpy(before, expected, NUMBER_OF_CHARACTERS);
+  windows.move(second, 12, 8);                                  // Partly off screen
+  memcpy(expected, dashboard, NUMBER_OF_CHARACTERS);
+  paint(12, 8, 8, 3, "********  OK  ********  ");
+  paint(4, 2, 6, 3, popup);
+  check("move() partly off screen", simulator, before);
+
+  // --- Dashboard changes, under the popup and beside it ---
+  memcpy(before, expected, NUMBER_OF_CHARACTERS);
+  dashboard[4 | (3 << 4)] = '0';                                // Covered
+  dashboard[0] = '1';                                           // Visible
+  windows.redraw();
+  expected[0] = '1';
+  check("redraw() changed background", simulator, before);
+
+  memcpy(before, expected, NUMBER_OF_CHARACTERS);
+  windows.close(first);
+  windows.close(second);
+  memcpy(expected, dashboard, NUMBER_OF_CHARACTERS);
+  check("close() both", simulator, before);
+
+  return (failures == 0) ? 0 : 1;
+}
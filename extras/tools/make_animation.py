@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+#
+# make_animation.py - Converts text frames into PROGMEM animation data for MS6205_animation.h.
+#
+# Copyright 2018 Christian Holzapfel
+#
+# Released under the MIT License, see LICENSE.
+#
+# Usage:
+#
+#   python3 extras/tools/make_animation.py spinner.txt > spinner.h
+#
+# Input format: settings first, then frames, each one starting with a line beginning with "---".
+#
+#   # Comment
+#   name        spinner     C name of the array, defaults to the file name
+#   interval    120         [ms] Time between two frames, defaults to 100
+#   transparent .           Character marking transparent cells, defaults to none
+#   ---
+#   frame lines, at most 16 characters each, at most 10 lines
+#   ---
+#   next frame ...
+#
+# The box is as wide as the longest line and as high as the highest frame of all frames.
+# Cells missing in shorter lines or frames are transparent if a transparent character is set,
+# or spaces otherwise. Lowercase latin letters are converted to uppercase, like write() does.
+
+import os
+import sys
+
+COLUMNS = 16
+ROWS = 10
+TRANSPARENT = 0
+
+
+def fail(message):
+    sys.stderr.write("make_animation.py: %s\n" % message)
+    sys.exit(1)
+
+
+def parse(path):
+    settings = {"name": os.path.splitext(os.path.basename(path))[0], "interval": "100", "transparent": None}
+    frames = []
+    with open(path) as source:
+        for number, line in enumerate(source, 1):
+            line = line.rstrip("\r\n")
+            if line.startswith("---"):
+                frames.append([])
+            elif frames:
+                frames[-1].append(line)
+            elif line.strip() and not line.startswith("#"):
+                key, _, value = line.partition(" ")
+                if key not in settings:
+                    fail("%s:%d: unknown setting '%s'" % (path, number, key))
+                settings[key] = value.strip()
+    if not frames:
+        fail("%s: no frames" % path)
+    return settings, frames
+
+
+def character_code(character, transparent, where):
+    if character == transparent:
+        return TRANSPARENT
+    if "a" <= character <= "z":
+        character = character.upper()
+    code = ord(character)
+    if code < 32 or code > 127:
+        fail("%s: character '%s' can't be shown" % (where, character))
+    return code
+
+
+def build(settings, frames):
+    transparent = settings["transparent"]
+    filler = TRANSPARENT if transparent else ord(" ")
+
+    # Drop trailing empty lines of every frame, they only separate frames in the source
+    for frame in frames:
+        while frame and not frame[-1].strip():
+            frame.pop()
+
+    width = max([len(line) for frame in frames for line in frame] + [1])
+    height = max([len(frame) for frame in frames] + [1])
+    if width > COLUMNS or height > ROWS:
+        fail("box of %d x %d cells exceeds the display" % (width, height))
+    if len(frames) > 255:
+        fail("%d frames, at most 255 are supported" % len(frames))
+    interval = int(settings["interval"])
+    if not 0 <= interval <= 0xFFFF:
+        fail("interval %d out of range" % interval)
+
+    cells = []
+    for index, frame in enumerate(frames):
+        grid = {}
+        for row in range(height):
+            line = frame[row] if row < len(frame) else ""
+            for column in range(width):
+                cell = (row << 4) | column
+                if column < len(line):
+                    grid[cell] = character_code(line[column], transparent, "frame %d" % index)
+                else:
+                    grid[cell] = filler
+        cells.append(grid)
+
+    order = sorted(cells[0])                    # Address order, so flush() walks them in one pass
+    first = [(cell, cells[0][cell]) for cell in order if cells[0][cell] != TRANSPARENT]
+    deltas = []
+    for index in range(len(frames)):
+        old = cells[index - 1]                  # Delta 0 leads from the last frame to the first
+        new = cells[index]
+        deltas.append([(cell, old[cell], new[cell]) for cell in order if old[cell] != new[cell]])
+
+    data = [len(frames), width, height, interval & 0xFF, interval >> 8]
+    offsets_at = len(data)
+    data += [0, 0] * len(frames)
+    data.append(len(first))
+    for cell, code in first:
+        data += [cell, code]
+    for index, delta in enumerate(deltas):
+        offset = len(data)
+        if offset > 0xFFFF:
+            fail("animation exceeds 64 KiB")
+        data[offsets_at + 2 * index] = offset & 0xFF
+        data[offsets_at + 2 * index + 1] = offset >> 8
+        data.append(len(delta))
+        for cell, old_code, new_code in delta:
+            data += [cell, old_code, new_code]
+
+    changed = sum(len(delta) for delta in deltas[1:])
+    return data, width, height, interval, changed
+
+
+def main():
+    if len(sys.argv) != 2:
+        fail("usage: make_animation.py <frames.txt>")
+
+    settings, frames = parse(sys.argv[1])
+    data, width, height, interval, changed = build(settings, frames)
+
+    print("// Generated by extras/tools/make_animation.py from %s, do not edit." % os.path.basename(sys.argv[1]))
+    print("// %d frames, %d x %d cells, %d ms per frame, %d cells changed in total, %d bytes"
+          % (len(frames), width, height, interval, changed, len(data)))
+    print("")
+    guard = "ANIMATION_%s_H" % settings["name"].upper()
+    print("#ifndef %s" % guard)
+    print("#define %s" % guard)
+    print("")
+    print("#include \"Arduino.h\"")
+    print("")
+    print("const uint8_t %s[] PROGMEM =" % settings["name"])
+    print("{")
+    for start in range(0, len(data), 16):
+        print("  " + ", ".join("0x%02X" % value for value in data[start:start + 16]) + ",")
+    print("};")
+    print("")
+    print("#endif // %s" % guard)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+#
+# make_screen.py - Converts a text screen into a compressed PROGMEM screen asset for MS6205_screen.h.
+#
+# Copyright 2018 Christian Holzapfel
+#
+# Released under the MIT License, see LICENSE.
+#
+# Usage:
+#
+#   python3 extras/tools/make_screen.py menu.txt > menu.h
+#   python3 extras/tools/make_screen.py logo.txt menu.txt > screens.h
+#
+# Input format: settings first, then a line beginning with "---", then the screen.
+#
+#   # Comment
+#   name        menu        C name of the array, defaults to the file name
+#   block       #           Character drawn as the fully black box (code 127), defaults to none
+#   format      auto        plain, packed or auto (the smaller one), defaults to auto
+#   ---
+#   up to 10 lines of up to 16 characters
+#
+# Missing cells are spaces. Lowercase latin letters are converted to uppercase, like write() does.
+
+import os
+import sys
+
+COLUMNS = 16
+ROWS = 10
+CELLS = COLUMNS * ROWS
+
+SCREEN_PLAIN = 0x00
+SCREEN_PACKED = 0x01
+RUN_SYMBOLS = 32
+MIN_RUN = 3
+MAX_RUN = RUN_SYMBOLS - 1 + MIN_RUN
+BLOCK = 127
+
+
+def fail(message):
+    sys.stderr.write("make_screen.py: %s\n" % message)
+    sys.exit(1)
+
+
+def parse(path):
+    settings = {"name": os.path.splitext(os.path.basename(path))[0], "block": None, "format": "auto"}
+    lines = None
+    with open(path) as source:
+        for number, line in enumerate(source, 1):
+            line = line.rstrip("\r\n")
+            if lines is not None:
+                lines.append(line)
+            elif line.startswith("---"):
+                lines = []
+            elif line.strip() and not line.startswith("#"):
+                key, _, value = line.partition(" ")
+                if key not in settings:
+                    fail("%s:%d: unknown setting '%s'" % (path, number, key))
+                settings[key] = value.strip()
+    if lines is None:
+        fail("%s: no screen after a '---' line" % path)
+    while lines and not lines[-1].strip():
+        lines.pop()
+    if len(lines) > ROWS or any(len(line) > COLUMNS for line in lines):
+        fail("%s: screen exceeds %d x %d characters" % (path, COLUMNS, ROWS))
+    if settings["format"] not in ("auto", "plain", "packed"):
+        fail("%s: unknown format '%s'" % (path, settings["format"]))
+    return settings, lines
+
+
+def cells(settings, lines):
+    codes = []
+    for row in range(ROWS):
+        line = (lines[row] if row < len(lines) else "").ljust(COLUMNS)
+        for character in line:
+            if character == settings["block"]:
+                codes.append(BLOCK)
+                continue
+            if "a" <= character <= "z":
+                character = character.upper()
+            code = ord(character)
+            if code < 32 or code > 127:
+                fail("character '%s' can't be shown" % character)
+            codes.append(code)
+    return codes
+
+
+def symbols(codes):
+    stream = []
+    index = 0
+    while index < len(codes):
+        run = 1
+        while index + run < len(codes) and codes[index + run] == codes[index] and run < MAX_RUN:
+            run += 1
+        if run >= MIN_RUN:
+            stream += [run - MIN_RUN, codes[index]]
+        else:
+            stream += [codes[index]] * run
+        index += run
+    return stream
+
+
+def pack(stream):
+    data = []
+    bits = 0
+    count = 0
+    for symbol in stream:
+        bits = (bits << 7) | symbol
+        count += 7
+        while count >= 8:
+            count -= 8
+            data.append((bits >> count) & 0xFF)
+    if count > 0:
+        data.append((bits << (8 - count)) & 0xFF)
+    return data
+
+
+def encode(settings, lines):
+    stream = symbols(cells(settings, lines))
+    plain = [SCREEN_PLAIN] + stream
+    packed = [SCREEN_PACKED] + pack(stream)
+    if settings["format"] == "plain":
+        return plain
+    if settings["format"] == "packed":
+        return packed
+    return packed if len(packed) < len(plain) else plain
+
+
+def main():
+    if len(sys.argv) < 2:
+        fail("usage: make_screen.py <screen.txt> [<screen.txt> ...]")
+
+    print("// Generated by extras/tools/make_screen.py, do not edit.")
+    print("")
+    print("#include \"Arduino.h\"")
+    for path in sys.argv[1:]:
+        settings, lines = parse(path)
+        data = encode(settings, lines)
+        print("")
+        print("// %s: %s, %d bytes instead of %d" % (os.path.basename(path),
+              "packed" if data[0] == SCREEN_PACKED else "plain", len(data), CELLS))
+        print("const uint8_t %s[] PROGMEM =" % settings["name"])
+        print("{")
+        for start in range(0, len(data), 16):
+            print("  " + ", ".join("0x%02X" % value for value in data[start:start + 16]) + ",")
+        print("};")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,304 @@
+#!/usr/bin/env python3
+#
+# ms6205_remote.py - Reference host client of the binary remote protocol in MS6205_remote.h.
+#
+# Copyright 2018 Christian Holzapfel
+#
+# Released under the MIT License, see LICENSE.
+#
+# Usage:
+#
+#   python3 extras/tools/ms6205_remote.py PORT [--baud BAUD] text FILE     Show a text file (16 x 10)
+#   python3 extras/tools/ms6205_remote.py PORT [--baud BAUD] page N        Show page N
+#   python3 extras/tools/ms6205_remote.py PORT [--baud BAUD] clear         Clear visible page
+#
+# PORT is a serial device like /dev/ttyUSB0, or tcp:HOST:PORT for a WiFiClient on the display side.
+# Only the Python standard library is used.
+#
+# As a module:
+#
+#   with RemoteDisplay("/dev/ttyUSB0", 115200) as display:
+#       display.show("HELLO".ljust(160))   # Sends only the cells that changed since the last show()
+#       display.sync()                     # Waits until the display applied everything
+
+import os
+import select
+import socket
+import sys
+import termios
+import time
+import tty
+
+SYNC = 0xA5
+FULL_FRAME = 0x01
+CELL_RUNS = 0x02
+PAGE = 0x03
+CLEAR = 0x04
+HELLO = 0x05
+ACK = 0x80
+
+OK = 0
+
+CELLS = 160
+MAX_PAYLOAD = 255
+RUN_OVERHEAD = 2            # Address and count byte of a cell run
+ACK_TIMEOUT = 0.5           # [s] Resend unacknowledged frames after this time
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE, as remoteDisplay::crcUpdate()."""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def encode_frame(frame_type, sequence, payload=b""):
+    body = bytes([frame_type, len(payload), sequence]) + bytes(payload)
+    crc = crc16(body)
+    return bytes([SYNC]) + body + bytes([crc >> 8, crc & 0xFF])
+
+
+def cell_runs(old, new):
+    """Payloads of REMOTE_CELL_RUNS frames changing content old into new.
+
+    Gaps of unchanged cells shorter than a run header are sent along, that is cheaper than a new run.
+    """
+    runs = []
+    address = 0
+    while address < CELLS:
+        if old is not None and old[address] == new[address]:
+            address += 1
+            continue
+        end = address + 1
+        while end < CELLS:
+            if old is None or old[end] != new[end]:
+                end += 1
+                continue
+            gap = end
+            while gap < CELLS and old[gap] == new[gap] and gap - end < RUN_OVERHEAD:
+                gap += 1
+            if gap < CELLS and old[gap] != new[gap] and gap - end < RUN_OVERHEAD:
+                end = gap
+            else:
+                break
+        runs.append((address, new[address:end]))
+        address = end
+
+    payloads = []
+    payload = b""
+    for address, characters in runs:
+        while characters:
+            room = MAX_PAYLOAD - len(payload) - RUN_OVERHEAD
+            if room <= 0:
+                payloads.append(payload)
+                payload = b""
+                continue
+            part = characters[:room]
+            payload += bytes([address, len(part)]) + part
+            address += len(part)
+            characters = characters[len(part):]
+    if payload:
+        payloads.append(payload)
+    return payloads
+
+
+class RemoteError(Exception):
+    pass
+
+
+class RemoteDisplay:
+    """Sends frames with a sliding window of unacknowledged bytes, resending all of them on errors."""
+
+    def __init__(self, port, baud=115200, window=None):
+        if port.startswith("tcp:"):
+            _, host, number = port.split(":")
+            self._socket = socket.create_connection((host, int(number)))
+            self._socket.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+            self._fd = self._socket.fileno()
+        else:
+            self._socket = None
+            self._fd = os.open(port, os.O_RDWR | os.O_NOCTTY)
+            tty.setraw(self._fd)
+            attributes = termios.tcgetattr(self._fd)
+            speed = getattr(termios, "B%d" % baud, None)
+            if speed is not None:
+                attributes[4] = attributes[5] = speed
+            termios.tcsetattr(self._fd, termios.TCSANOW, attributes)
+        self._received = b""
+        self._sequence = 0
+        self._in_flight = []            # (sequence, frame bytes, send time), oldest first
+        self._content = None            # Content of the visible page as last sent
+        self.latencies = []             # [s] Time from sending to acknowledge, per frame
+        self.resent = 0
+        self.version, self.window = self.hello()
+        if window is not None:
+            self.window = min(self.window, window)
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exception):
+        self.close()
+
+    def close(self):
+        if self._socket is not None:
+            self._socket.close()
+        else:
+            os.close(self._fd)
+
+    # --- Frames ---
+
+    def hello(self):
+        """Returns protocol version and receive window of the display."""
+        self._in_flight = []
+        self._received = b""
+        for _ in range(10):
+            sequence = self._next_sequence()
+            os.write(self._fd, encode_frame(HELLO, sequence))
+            deadline = time.monotonic() + ACK_TIMEOUT
+            while time.monotonic() < deadline:
+                ack = self._read_ack(deadline - time.monotonic())
+                if ack is not None and ack[0] == sequence and ack[1] == OK and len(ack[2]) >= 3:
+                    return ack[2][0], ack[2][1] | (ack[2][2] << 8)
+        raise RemoteError("no answer to HELLO")
+
+    def full_frame(self, content):
+        content = self._content_bytes(content)
+        self._send(FULL_FRAME, content)
+        self._content = content
+
+    def show(self, content):
+        """Sends only changed cells, or a full frame if that is shorter."""
+        content = self._content_bytes(content)
+        payloads = cell_runs(self._content, content)
+        size = sum(len(payload) for payload in payloads)
+        if size >= CELLS:
+            self.full_frame(content)
+            return
+        for payload in payloads:
+            self._send(CELL_RUNS, payload)
+        self._content = content
+
+    def page(self, page):
+        self._send(PAGE, bytes([page]))
+        self._content = None            # Content of the other page is unknown here
+
+    def clear(self):
+        self._send(CLEAR)
+        self._content = b" " * CELLS
+
+    def sync(self, timeout=5.0):
+        """Waits until all frames are acknowledged."""
+        deadline = time.monotonic() + timeout
+        while self._in_flight:
+            if time.monotonic() > deadline:
+                raise RemoteError("display stopped acknowledging")
+            self._poll(0.05)
+
+    # --- Internals ---
+
+    def _content_bytes(self, content):
+        if isinstance(content, str):
+            content = content.upper().encode("latin-1")
+        return bytes(content[:CELLS]).ljust(CELLS, b" ")
+
+    def _next_sequence(self):
+        self._sequence = (self._sequence + 1) & 0xFF
+        return self._sequence
+
+    def _send(self, frame_type, payload=b""):
+        frame = encode_frame(frame_type, self._next_sequence(), payload)
+        while self._in_flight and self._bytes_in_flight() + len(frame) > self.window:
+            self._poll(ACK_TIMEOUT)
+        os.write(self._fd, frame)
+        self._in_flight.append((self._sequence, frame, time.monotonic()))
+
+    def _bytes_in_flight(self):
+        return sum(len(frame) for _, frame, _ in self._in_flight)
+
+    def _poll(self, timeout):
+        ack = self._read_ack(timeout)
+        now = time.monotonic()
+        if ack is None:
+            if self._in_flight and now - self._in_flight[0][2] > ACK_TIMEOUT:
+                self._resend()
+            return
+        sequence, status, _ = ack
+        if status != OK:
+            self._resend()
+            return
+        # Acknowledges come in order: if older frames are still unacknowledged, they were lost, and
+        # this one must be applied again after them
+        for index, (pending, _, sent) in enumerate(self._in_flight):
+            if pending == sequence:
+                if index > 0:
+                    self._resend()
+                else:
+                    self.latencies.append(now - sent)
+                    del self._in_flight[0]
+                return
+
+    def _resend(self):
+        """Go back N: resends all unacknowledged frames in their order."""
+        pending = self._in_flight
+        self._in_flight = []
+        for sequence, frame, _ in pending:
+            os.write(self._fd, frame)
+            self._in_flight.append((sequence, frame, time.monotonic()))
+        self.resent += len(pending)
+
+    def _read_ack(self, timeout):
+        """Returns (sequence, status, rest of payload) of the next acknowledge, or None."""
+        deadline = time.monotonic() + max(timeout, 0)
+        while True:
+            start = self._received.find(bytes([SYNC]))
+            if start < 0:
+                self._received = b""
+            else:
+                self._received = self._received[start:]
+                if len(self._received) >= 4:
+                    length = self._received[2]
+                    if len(self._received) >= 6 + length:
+                        frame = self._received[:6 + length]
+                        crc = crc16(frame[1:4 + length])
+                        if frame[1] == ACK and length >= 1 and crc == (frame[4 + length] << 8 | frame[5 + length]):
+                            self._received = self._received[6 + length:]
+                            return frame[3], frame[4], frame[5:4 + length]
+                        self._received = self._received[1:]     # Not a valid frame, search next sync byte
+                        continue
+            remaining = deadline - time.monotonic()
+            if remaining <= 0:
+                return None
+            readable, _, _ = select.select([self._fd], [], [], remaining)
+            if readable:
+                self._received += os.read(self._fd, 4096)
+
+
+def main():
+    arguments = sys.argv[1:]
+    baud = 115200
+    if "--baud" in arguments:
+        index = arguments.index("--baud")
+        baud = int(arguments[index + 1])
+        del arguments[index:index + 2]
+    if len(arguments) < 2 or arguments[1] not in ("text", "page", "clear"):
+        sys.stderr.write("usage: ms6205_remote.py PORT [--baud BAUD] text FILE | page N | clear\n")
+        sys.exit(1)
+
+    with RemoteDisplay(arguments[0], baud) as display:
+        if arguments[1] == "text":
+            with open(arguments[2]) as source:
+                lines = source.read().splitlines()[:10]
+            display.full_frame("".join(line[:16].ljust(16) for line in lines))
+        elif arguments[1] == "page":
+            display.page(int(arguments[2]))
+        else:
+            display.clear()
+        display.sync()
+
+
+if __name__ == "__main__":
+    main()